@@ -0,0 +1,223 @@
+// SPDX-License-Identifier: GPL-2.0
+/*
+ * Lookup of the INT3472 "discrete PMIC" the sensors depend on.
+ *
+ * Every sensor lists an INT3472 device in its _DEP. That device only
+ * serves as a container for the sensor power GPIOs. Resolving it takes a
+ * _DEP evaluation and a walk over the dependencies, so it is done once per
+ * sensor here. The result, including the requested GPIO descriptors, is
+ * cached until this module is unloaded and handed out again when the
+ * sensor driver probes another time (deferred probe, module reload).
+ */
+
+#include <linux/acpi.h>
+#include <linux/err.h>
+#include <linux/gpio/consumer.h>
+#include <linux/module.h>
+#include <linux/mutex.h>
+#include <linux/slab.h>
+
+#include "int3472_dep.h"
+
+#define INT3472_HID	"INT3472"
+
+static LIST_HEAD(int3472_dep_list);
+static DEFINE_MUTEX(int3472_dep_lock);
+
+static struct acpi_device *int3472_dep_find_adev(struct device *dev,
+						 acpi_handle handle)
+{
+	struct acpi_handle_list dep_devices;
+	struct acpi_device *adev;
+	acpi_status status;
+	int i;
+
+	if (!acpi_has_method(handle, "_DEP")) {
+		dev_err(dev, "No _DEP entry found\n");
+		return ERR_PTR(-ENODEV);
+	}
+
+	status = acpi_evaluate_reference(handle, "_DEP", NULL, &dep_devices);
+	if (ACPI_FAILURE(status)) {
+		dev_err(dev, "Failed to evaluate _DEP.\n");
+		return ERR_PTR(-ENODEV);
+	}
+
+	/*
+	 * The HID is already known to the ACPI core, no need to evaluate
+	 * _HID again through acpi_get_object_info().
+	 */
+	for (i = 0; i < dep_devices.count; i++) {
+		if (acpi_bus_get_device(dep_devices.handles[i], &adev))
+			continue;
+
+		if (!strcmp(acpi_device_hid(adev), INT3472_HID))
+			return adev;
+	}
+
+	dev_err(dev, "Dependent ACPI device not found\n");
+
+	return ERR_PTR(-ENODEV);
+}
+
+static int int3472_dep_get_gpios(struct int3472_dep *dep)
+{
+	dep->xshutdn = gpiod_get_index(dep->dev, NULL, 0, GPIOD_ASIS);
+	if (IS_ERR(dep->xshutdn)) {
+		dev_err(dep->dev, "Couldn't get GPIO XSHUTDN\n");
+		return PTR_ERR(dep->xshutdn);
+	}
+
+	dep->pwdnb = gpiod_get_index(dep->dev, NULL, 1, GPIOD_ASIS);
+	if (IS_ERR(dep->pwdnb)) {
+		dev_err(dep->dev, "Couldn't get GPIO PWDNB\n");
+		gpiod_put(dep->xshutdn);
+		return PTR_ERR(dep->pwdnb);
+	}
+
+	dep->led_gpio = gpiod_get_index_optional(dep->dev, NULL, 2, GPIOD_ASIS);
+	if (IS_ERR_OR_NULL(dep->led_gpio)) {
+		dev_info(dep->dev,
+			 "Couldn't get GPIO LED. Maybe not exist, continue anyway.\n");
+		dep->led_gpio = NULL;
+	}
+
+	return 0;
+}
+
+static struct int3472_dep *int3472_dep_resolve(struct device *dev,
+					       acpi_handle handle)
+{
+	struct acpi_device_physical_node *dep_phys;
+	struct acpi_device *dep_adev;
+	struct int3472_dep *dep;
+	int ret;
+
+	dep_adev = int3472_dep_find_adev(dev, handle);
+	if (IS_ERR(dep_adev))
+		return ERR_CAST(dep_adev);
+
+	/*
+	 * HACK: We know that the PMIC is a "discrete" PMIC, an ACPI device
+	 * that just serves as a container to list system GPIOs.
+	 *
+	 * The ACPI device has no fwnode, nor does it have a platform device.
+	 * This prevents fetching GPIOs. It however seems to be backed by the
+	 * PCI root complex (pci0000:00/0000:00:00.0) as its physical device,
+	 * and that device has its fwnode set to \_SB.PCI0.DSC1. Whether this
+	 * is correct or not is unknown, let's just get the physical device and
+	 * move on for now.
+	 *
+	 * (@kitakar5525)This is observed on Microsoft Surface Go series
+	 * and Acer Switch Alpha 12.
+	 */
+	dep_phys = list_first_entry_or_null(&dep_adev->physical_node_list,
+					    struct acpi_device_physical_node,
+					    node);
+	if (!dep_phys) {
+		dev_err(dev, "Error getting physical node of dependent device\n");
+		return ERR_PTR(-ENODEV);
+	}
+
+	dep = kzalloc(sizeof(*dep), GFP_KERNEL);
+	if (!dep)
+		return ERR_PTR(-ENOMEM);
+
+	dep->sensor_handle = handle;
+	dep->dev = dep_phys->dev;
+
+	ret = int3472_dep_get_gpios(dep);
+	if (ret) {
+		kfree(dep);
+		return ERR_PTR(ret);
+	}
+
+	dev_info(dev, "Dependent device found: %s\n", dev_name(dep->dev));
+
+	return dep;
+}
+
+/**
+ * int3472_dep_get - get the INT3472 a sensor depends on
+ * @dev: sensor device
+ *
+ * The dependency is resolved from the ACPI companion of @dev, so several
+ * sensors sharing a HID each get their own INT3472. Returns the cached
+ * entry if the sensor was resolved before. The entry must be released
+ * with int3472_dep_put().
+ */
+struct int3472_dep *int3472_dep_get(struct device *dev)
+{
+	struct int3472_dep *dep;
+	acpi_handle handle;
+
+	handle = ACPI_HANDLE(dev);
+	if (!handle) {
+		dev_err(dev, "Couldn't get sensor ACPI device\n");
+		return ERR_PTR(-ENODEV);
+	}
+
+	mutex_lock(&int3472_dep_lock);
+
+	list_for_each_entry(dep, &int3472_dep_list, list)
+		if (dep->sensor_handle == handle)
+			goto found;
+
+	dep = int3472_dep_resolve(dev, handle);
+	if (IS_ERR(dep))
+		goto out_unlock;
+
+	list_add_tail(&dep->list, &int3472_dep_list);
+
+found:
+	dep->users++;
+out_unlock:
+	mutex_unlock(&int3472_dep_lock);
+
+	return dep;
+}
+EXPORT_SYMBOL_GPL(int3472_dep_get);
+
+/*
+ * The GPIOs stay requested and the entry cached, so the next probe of the
+ * same sensor doesn't need to resolve it again.
+ */
+void int3472_dep_put(struct int3472_dep *dep)
+{
+	if (IS_ERR_OR_NULL(dep))
+		return;
+
+	mutex_lock(&int3472_dep_lock);
+	WARN_ON(!dep->users);
+	dep->users--;
+	mutex_unlock(&int3472_dep_lock);
+}
+EXPORT_SYMBOL_GPL(int3472_dep_put);
+
+void int3472_dep_set_power(struct int3472_dep *dep, bool on)
+{
+	gpiod_set_value_cansleep(dep->xshutdn, on);
+	gpiod_set_value_cansleep(dep->pwdnb, on);
+	if (dep->led_gpio)
+		gpiod_set_value_cansleep(dep->led_gpio, on);
+}
+EXPORT_SYMBOL_GPL(int3472_dep_set_power);
+
+static void __exit int3472_dep_exit(void)
+{
+	struct int3472_dep *dep, *tmp;
+
+	/* Sensor modules hold a reference to us, so there are no users */
+	list_for_each_entry_safe(dep, tmp, &int3472_dep_list, list) {
+		list_del(&dep->list);
+		gpiod_put(dep->xshutdn);
+		gpiod_put(dep->pwdnb);
+		if (dep->led_gpio)
+			gpiod_put(dep->led_gpio);
+		kfree(dep);
+	}
+}
+module_exit(int3472_dep_exit);
+
+MODULE_DESCRIPTION("INT3472 dependency lookup for the IPU3 camera sensors");
+MODULE_LICENSE("GPL");
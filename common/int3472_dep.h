@@ -0,0 +1,36 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+/*
+ * Lookup of the INT3472 "discrete PMIC" the sensors depend on, shared by
+ * all the sensor drivers here. See int3472_dep.c.
+ */
+
+#ifndef __INT3472_DEP_H__
+#define __INT3472_DEP_H__
+
+#include <linux/acpi.h>
+#include <linux/device.h>
+#include <linux/gpio/consumer.h>
+#include <linux/list.h>
+#include <linux/types.h>
+
+struct int3472_dep {
+	struct list_head list;
+	/* sensor this entry was resolved for */
+	acpi_handle sensor_handle;
+	unsigned int users;
+
+	/* physical node of the INT3472, owner of the GPIOs below */
+	struct device *dev;
+
+	/* GPIOs defined in the INT3472 _CRS */
+	struct gpio_desc *xshutdn;
+	struct gpio_desc *pwdnb;
+	/* may not exist depending on devices, NULL then */
+	struct gpio_desc *led_gpio;
+};
+
+struct int3472_dep *int3472_dep_get(struct device *dev);
+void int3472_dep_put(struct int3472_dep *dep);
+void int3472_dep_set_power(struct int3472_dep *dep, bool on);
+
+#endif /* __INT3472_DEP_H__ */
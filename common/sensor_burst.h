@@ -0,0 +1,95 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+/*
+ * Pre-coalesced ("packed") register tables.
+ *
+ * The packed tables are generated from the flat {addr, val} tables of the
+ * drivers by misc/pack_sensor_regs/pack_sensor_regs.py. Redundant writes
+ * are already removed and consecutive registers merged, so each record is
+ * sent as is in a single I2C message:
+ *
+ *	<n> <addr_hi> <addr_lo> <data 0> ... <data n - 3>
+ *
+ * A record with n == SENSOR_BURST_DELAY is followed by one byte holding a
+ * delay in milliseconds instead.
+ */
+
+#ifndef __SENSOR_BURST_H__
+#define __SENSOR_BURST_H__
+
+#include <linux/bits.h>
+#include <linux/delay.h>
+#include <linux/i2c.h>
+#include <linux/types.h>
+
+#include "sensor_regcache.h"
+#include "sensor_stats.h"
+
+/* Software reset register, the same on all the OmniVision sensors here */
+#define SENSOR_SW_RESET_REG	0x0103
+
+#define SENSOR_BURST_DELAY	0
+
+struct sensor_burst_table {
+	const u8 *data;
+	unsigned int size;
+};
+
+#define SENSOR_BURST_TABLE(_packed) \
+	{ .data = (_packed), .size = sizeof(_packed) }
+
+/*
+ * sensor_burst_write - write a packed register table
+ * @client: sensor i2c client
+ * @table: packed table to write
+ * @cache: register cache to keep in sync, may be NULL
+ * @stats: every record is accounted there as a table write
+ */
+static inline int sensor_burst_write(struct i2c_client *client,
+				     const struct sensor_burst_table *table,
+				     struct sensor_regcache *cache,
+				     struct sensor_stats *stats)
+{
+	const u8 *p = table->data;
+	const u8 *end = p + table->size;
+	unsigned int len, ms;
+	ktime_t start;
+	u16 reg;
+	int ret;
+
+	while (p < end) {
+		len = *p++;
+		if (len == SENSOR_BURST_DELAY) {
+			ms = *p++;
+			usleep_range(ms * 1000, ms * 1000 + 100);
+			continue;
+		}
+
+		reg = (p[0] << 8) | p[1];
+		start = ktime_get();
+		ret = i2c_master_send(client, (const char *)p, len);
+		if (ret >= 0)
+			ret = ret == len ? 0 : -EIO;
+		sensor_stats_xfer(stats, SENSOR_STATS_TABLE, reg, len - 2, start,
+				  ret);
+		if (ret) {
+			dev_err(&client->dev, "%s: write error at reg 0x%02x%02x\n",
+				__func__, p[0], p[1]);
+			return ret;
+		}
+
+		if (cache) {
+			/* the generator always emits a reset as its own record */
+			if (reg == SENSOR_SW_RESET_REG && (p[2] & BIT(0)))
+				sensor_regcache_invalidate(cache);
+			else
+				sensor_regcache_write_burst(cache, reg, p + 2,
+							    len - 2);
+		}
+
+		p += len;
+	}
+
+	return 0;
+}
+
+#endif /* __SENSOR_BURST_H__ */
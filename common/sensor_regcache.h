@@ -0,0 +1,167 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+/*
+ * Register shadow cache shared by the sensor drivers in this repo.
+ *
+ * All the sensors here use 16-bit register addresses with 8-bit registers,
+ * so the cache is a flat image of the register space up to max_reg plus a
+ * bitmap of the entries that hold a value known to be in the sensor. This
+ * is the same idea as a REGCACHE_FLAT regmap, without pulling regmap into
+ * drivers that already have their own I2C helpers.
+ *
+ * Registers inside one of the volatile ranges (status, chip ID, OTP
+ * buffers, reset and group hold triggers) and registers above max_reg are
+ * never cached. Everything else is written through: drivers update the
+ * cache after every successful write and may answer reads from it.
+ *
+ * The cache has no lock of its own. Callers access it under the same mutex
+ * that serialises their I2C transfers.
+ */
+
+#ifndef __SENSOR_REGCACHE_H__
+#define __SENSOR_REGCACHE_H__
+
+#include <linux/bitmap.h>
+#include <linux/device.h>
+#include <linux/slab.h>
+#include <linux/types.h>
+
+struct sensor_reg_range {
+	u16 min;
+	u16 max;
+};
+
+#define SENSOR_REG_RANGE(_min, _max)	{ .min = (_min), .max = (_max) }
+
+struct sensor_regcache {
+	u8 *vals;
+	unsigned long *valid;
+	u16 max_reg;
+	const struct sensor_reg_range *volatile_ranges;
+	unsigned int num_volatile_ranges;
+};
+
+/*
+ * sensor_regcache_init - allocate a register cache
+ * @dev: device owning the (devm managed) cache memory
+ * @cache: cache to initialise
+ * @max_reg: highest cacheable register address
+ * @volatile_ranges: registers which must always be read from the sensor
+ * @num_volatile_ranges: number of entries in @volatile_ranges
+ *
+ * The cache starts out empty, so the first read of every register still
+ * goes to the sensor.
+ */
+static inline int sensor_regcache_init(struct device *dev,
+				       struct sensor_regcache *cache,
+				       u16 max_reg,
+				       const struct sensor_reg_range *volatile_ranges,
+				       unsigned int num_volatile_ranges)
+{
+	cache->vals = devm_kzalloc(dev, max_reg + 1, GFP_KERNEL);
+	cache->valid = devm_kcalloc(dev, BITS_TO_LONGS(max_reg + 1),
+				    sizeof(unsigned long), GFP_KERNEL);
+	if (!cache->vals || !cache->valid)
+		return -ENOMEM;
+
+	cache->max_reg = max_reg;
+	cache->volatile_ranges = volatile_ranges;
+	cache->num_volatile_ranges = num_volatile_ranges;
+
+	return 0;
+}
+
+static inline bool sensor_regcache_is_volatile(const struct sensor_regcache *cache,
+					       u16 reg)
+{
+	unsigned int i;
+
+	/* Not initialised yet, or out of the cached register space */
+	if (!cache->vals || reg > cache->max_reg)
+		return true;
+
+	for (i = 0; i < cache->num_volatile_ranges; i++)
+		if (reg >= cache->volatile_ranges[i].min &&
+		    reg <= cache->volatile_ranges[i].max)
+			return true;
+
+	return false;
+}
+
+/*
+ * Forget every cached value. To be called whenever the sensor loses its
+ * register contents, i.e. on power off and on software reset.
+ */
+static inline void sensor_regcache_invalidate(struct sensor_regcache *cache)
+{
+	if (cache->valid)
+		bitmap_zero(cache->valid, cache->max_reg + 1);
+}
+
+/* Returns true and fills @val if @reg can be answered from the cache. */
+static inline bool sensor_regcache_read(const struct sensor_regcache *cache,
+					u16 reg, u8 *val)
+{
+	if (sensor_regcache_is_volatile(cache, reg) ||
+	    !test_bit(reg, cache->valid))
+		return false;
+
+	*val = cache->vals[reg];
+
+	return true;
+}
+
+static inline void sensor_regcache_write(struct sensor_regcache *cache,
+					 u16 reg, u8 val)
+{
+	if (sensor_regcache_is_volatile(cache, reg))
+		return;
+
+	cache->vals[reg] = val;
+	set_bit(reg, cache->valid);
+}
+
+/* Update the cache after a burst write of @len consecutive registers. */
+static inline void sensor_regcache_write_burst(struct sensor_regcache *cache,
+					       u16 reg, const u8 *vals,
+					       unsigned int len)
+{
+	unsigned int i;
+
+	for (i = 0; i < len; i++)
+		sensor_regcache_write(cache, reg + i, vals[i]);
+}
+
+/*
+ * Multi-register values are stored big endian, most significant byte at
+ * the lowest address, which is what all the OmniVision sensors here use.
+ * A lookup only hits if every byte of the value is cached.
+ */
+static inline bool sensor_regcache_read_be(const struct sensor_regcache *cache,
+					   u16 reg, unsigned int len, u32 *val)
+{
+	unsigned int i;
+	u32 tmp = 0;
+	u8 byte;
+
+	for (i = 0; i < len; i++) {
+		if (!sensor_regcache_read(cache, reg + i, &byte))
+			return false;
+		tmp = (tmp << 8) | byte;
+	}
+
+	*val = tmp;
+
+	return true;
+}
+
+static inline void sensor_regcache_write_be(struct sensor_regcache *cache,
+					    u16 reg, unsigned int len, u32 val)
+{
+	unsigned int i;
+
+	for (i = 0; i < len; i++)
+		sensor_regcache_write(cache, reg + i,
+				      val >> (8 * (len - 1 - i)));
+}
+
+#endif /* __SENSOR_REGCACHE_H__ */
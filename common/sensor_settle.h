@@ -0,0 +1,120 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+/*
+ * Power-on settle for the sensor drivers in this repo.
+ *
+ * After the INT3472 GPIOs are raised, a sensor takes a few milliseconds
+ * until it answers on I2C, and the time differs between units. Instead of
+ * sleeping for the worst case, poll a chip ID register with a short
+ * backoff until it answers, bounded by a timeout. Only a NAK is waited
+ * out: once a read succeeds, the value is final, so a different chip is
+ * reported right away instead of after the whole timeout.
+ *
+ * The observed settle time is kept per device, so slow units show up.
+ */
+
+#ifndef __SENSOR_SETTLE_H__
+#define __SENSOR_SETTLE_H__
+
+#include <linux/delay.h>
+#include <linux/device.h>
+#include <linux/i2c.h>
+#include <linux/kernel.h>
+#include <linux/ktime.h>
+#include <linux/types.h>
+
+#include "sensor_stats.h"
+
+/* first poll after 500us, then back off up to one poll every 2ms */
+#define SENSOR_SETTLE_MIN_STEP_US	500
+#define SENSOR_SETTLE_MAX_STEP_US	2000
+
+/* Observed settle times in us, of the last and the slowest power-on */
+struct sensor_settle {
+	unsigned int last_us;
+	unsigned int max_us;
+};
+
+static inline int sensor_settle_read(struct i2c_client *client, u16 reg,
+				     u8 *val, struct sensor_stats *stats)
+{
+	u8 addr[2] = { reg >> 8, reg & 0xff };
+	struct i2c_msg msgs[] = {
+		{
+			.addr = client->addr,
+			.len = sizeof(addr),
+			.buf = addr,
+		}, {
+			.addr = client->addr,
+			.flags = I2C_M_RD,
+			.len = 1,
+			.buf = val,
+		},
+	};
+	ktime_t start = ktime_get();
+	int ret;
+
+	ret = i2c_transfer(client->adapter, msgs, ARRAY_SIZE(msgs));
+	if (ret >= 0)
+		ret = ret == ARRAY_SIZE(msgs) ? 0 : -EIO;
+
+	sensor_stats_xfer(stats, SENSOR_STATS_SETTLE, reg, 1, start, ret);
+
+	return ret;
+}
+
+/*
+ * sensor_settle_wait - wait until a freshly powered sensor answers
+ * @client: sensor
+ * @reg: register to poll, must not read back @expected before power-on
+ * @expected: value @reg holds once the sensor is up
+ * @timeout_us: give up after this long
+ * @settle: updated with the observed settle time on success
+ * @stats: every poll is accounted there, the ones not answered as retries
+ *
+ * Raw I2C reads are used, so the driver's register cache is not touched.
+ *
+ * Return: 0 once @reg reads @expected, -ENODEV if it reads anything else,
+ * -ETIMEDOUT if the sensor did not answer within @timeout_us.
+ */
+static inline int sensor_settle_wait(struct i2c_client *client, u16 reg,
+				     u8 expected, unsigned int timeout_us,
+				     struct sensor_settle *settle,
+				     struct sensor_stats *stats)
+{
+	unsigned int step = SENSOR_SETTLE_MIN_STEP_US;
+	ktime_t start = ktime_get();
+	s64 elapsed;
+	u8 val;
+
+	for (;;) {
+		usleep_range(step, step + step / 4);
+		elapsed = ktime_us_delta(ktime_get(), start);
+
+		if (!sensor_settle_read(client, reg, &val, stats)) {
+			if (val == expected)
+				break;
+
+			dev_err(&client->dev,
+				"unexpected ID 0x%02x at 0x%04x, expected 0x%02x\n",
+				val, reg, expected);
+			return -ENODEV;
+		}
+
+		if (elapsed >= timeout_us) {
+			dev_err(&client->dev,
+				"no answer %lld us after power-on\n", elapsed);
+			return -ETIMEDOUT;
+		}
+
+		sensor_stats_retry(stats, SENSOR_STATS_SETTLE);
+		step = min(step * 2, (unsigned int)SENSOR_SETTLE_MAX_STEP_US);
+	}
+
+	settle->last_us = elapsed;
+	settle->max_us = max(settle->max_us, settle->last_us);
+	dev_dbg(&client->dev, "settled after %u us\n", settle->last_us);
+
+	return 0;
+}
+
+#endif /* __SENSOR_SETTLE_H__ */
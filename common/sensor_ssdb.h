@@ -0,0 +1,139 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+/*
+ * SSDB (sensor specific data block) of the sensor ACPI devices.
+ *
+ * Firmwares made for Windows describe the camera module in a buffer
+ * returned by the SSDB method of the sensor: CSI-2 port and lane count,
+ * mounting orientation, external clock and the VCM and NVM parts fitted on
+ * the module. Reading it lets the drivers configure themselves instead of
+ * guessing. The layout is the one from coreboot also used by
+ * misc/dump_intel_ipu_data.
+ */
+
+#ifndef __SENSOR_SSDB_H__
+#define __SENSOR_SSDB_H__
+
+#include <linux/acpi.h>
+#include <linux/device.h>
+#include <linux/slab.h>
+#include <linux/string.h>
+#include <linux/types.h>
+
+struct sensor_ssdb {
+	u8 version;
+	u8 sensor_card_sku;
+	u8 csi2_data_stream_interface[16];
+	u16 bdf_value;
+	u32 dphy_link_en_fuses;
+	u32 lanes_clock_division;
+	u8 link_used;			/* CSI-2 port */
+	u8 lanes_used;			/* number of data lanes */
+	u32 csi_rx_dly_cnt_termen_clane;
+	u32 csi_rx_dly_cnt_settle_clane;
+	u32 csi_rx_dly_cnt_termen_dlane0;
+	u32 csi_rx_dly_cnt_settle_dlane0;
+	u32 csi_rx_dly_cnt_termen_dlane1;
+	u32 csi_rx_dly_cnt_settle_dlane1;
+	u32 csi_rx_dly_cnt_termen_dlane2;
+	u32 csi_rx_dly_cnt_settle_dlane2;
+	u32 csi_rx_dly_cnt_termen_dlane3;
+	u32 csi_rx_dly_cnt_settle_dlane3;
+	u32 max_lane_speed;		/* 0 on all the machines seen so far */
+	u8 sensor_cal_file_idx;
+	u8 sensor_cal_file_idx_mbz[3];
+	u8 rom_type;			/* enum sensor_ssdb_rom_type */
+	u8 vcm_type;			/* enum sensor_ssdb_vcm_type */
+	u8 platform;
+	u8 platform_sub;
+	u8 flash_support;
+	u8 privacy_led;
+	u8 degree;			/* see sensor_ssdb_rotation() */
+	u8 mipi_define;
+	u32 mclk_speed;			/* external clock in Hz */
+	u8 control_logic_id;
+	u8 mipi_data_format;
+	u8 silicon_version;
+	u8 customer_id;
+	u8 mclk_port;
+	u8 reserved[13];
+} __packed;
+
+enum sensor_ssdb_vcm_type {
+	SENSOR_SSDB_VCM_NONE,
+	SENSOR_SSDB_VCM_AD5823,
+	SENSOR_SSDB_VCM_DW9714,
+	SENSOR_SSDB_VCM_AD5816,
+	SENSOR_SSDB_VCM_DW9719,
+	SENSOR_SSDB_VCM_DW9718,
+	SENSOR_SSDB_VCM_DW9806B,
+	SENSOR_SSDB_VCM_WV517S,
+	SENSOR_SSDB_VCM_LC898122XA,
+	SENSOR_SSDB_VCM_LC898212AXB,
+};
+
+enum sensor_ssdb_rom_type {
+	SENSOR_SSDB_ROM_NONE,
+	/* calibration data in the sensor's own OTP */
+	SENSOR_SSDB_ROM_OTP,
+	SENSOR_SSDB_ROM_EEPROM_16K_64,
+	SENSOR_SSDB_ROM_EEPROM_16K_16,
+	SENSOR_SSDB_ROM_OTP_ACPI,
+	SENSOR_SSDB_ROM_ACPI,
+	SENSOR_SSDB_ROM_EEPROM_BRCC64,
+	SENSOR_SSDB_ROM_EEPROM_BRCC64_GENERIC,
+	SENSOR_SSDB_ROM_EEPROM_CAT24C64,
+};
+
+/*
+ * sensor_ssdb_read - read the SSDB of a sensor
+ * @dev: sensor device, its ACPI companion is evaluated
+ * @ssdb: filled in on success. Fields a short SSDB doesn't cover are 0.
+ *
+ * Returns -ENODEV if the sensor has no (usable) SSDB.
+ */
+static inline int sensor_ssdb_read(struct device *dev,
+				   struct sensor_ssdb *ssdb)
+{
+	struct acpi_buffer buffer = { ACPI_ALLOCATE_BUFFER, NULL };
+	acpi_handle handle = ACPI_HANDLE(dev);
+	union acpi_object *obj;
+	acpi_status status;
+	int ret = 0;
+
+	if (!handle || !acpi_has_method(handle, "SSDB"))
+		return -ENODEV;
+
+	status = acpi_evaluate_object(handle, "SSDB", NULL, &buffer);
+	if (ACPI_FAILURE(status))
+		return -ENODEV;
+
+	obj = buffer.pointer;
+	if (!obj || obj->type != ACPI_TYPE_BUFFER ||
+	    obj->buffer.length > sizeof(*ssdb)) {
+		dev_err(dev, "unexpected SSDB layout\n");
+		ret = -ENODEV;
+		goto out_free;
+	}
+
+	memset(ssdb, 0, sizeof(*ssdb));
+	memcpy(ssdb, obj->buffer.pointer, obj->buffer.length);
+
+out_free:
+	kfree(buffer.pointer);
+	return ret;
+}
+
+/* Mounting rotation in degrees */
+static inline unsigned int sensor_ssdb_rotation(const struct sensor_ssdb *ssdb)
+{
+	/* Most firmwares store 1 for an inverted sensor, some the angle */
+	switch (ssdb->degree) {
+	case 1:
+	case 180:
+		return 180;
+	default:
+		return 0;
+	}
+}
+
+#endif /* __SENSOR_SSDB_H__ */
@@ -0,0 +1,287 @@
+// SPDX-License-Identifier: GPL-2.0
+/*
+ * I2C and stream start statistics of the sensor drivers in this repo.
+ *
+ * Opening a camera can take several hundred milliseconds and most of it
+ * is spent powering the sensor up and writing registers. Every sensor gets
+ * a directory in debugfs, <debugfs>/sensor_stats/<i2c device>/:
+ *
+ *	i2c	transfers, bytes, retries and errors and a latency histogram
+ *		for each kind of transfer
+ *	phases	time histograms of the steps of s_stream(1)
+ *	power	power transitions and the power-on settle time
+ *	reset	write anything to clear the above
+ *
+ * The same events are also available as tracepoints in the "sensor"
+ * trace system.
+ */
+
+#include <linux/debugfs.h>
+#include <linux/kernel.h>
+#include <linux/math64.h>
+#include <linux/module.h>
+#include <linux/seq_file.h>
+#include <linux/string.h>
+
+#include "sensor_settle.h"
+#include "sensor_stats.h"
+
+#define CREATE_TRACE_POINTS
+#include "sensor_trace.h"
+
+static const char * const sensor_stats_site_names[] = {
+	[SENSOR_STATS_READ] = "read",
+	[SENSOR_STATS_WRITE] = "write",
+	[SENSOR_STATS_TABLE] = "table",
+	[SENSOR_STATS_SETTLE] = "settle",
+};
+
+static const char * const sensor_stats_phase_names[] = {
+	[SENSOR_STATS_POWER_ON] = "power_on",
+	[SENSOR_STATS_GLOBAL_REGS] = "global_regs",
+	[SENSOR_STATS_MODE_REGS] = "mode_regs",
+	[SENSOR_STATS_CTRL_SETUP] = "ctrl_setup",
+	[SENSOR_STATS_STREAM_ON] = "stream_on",
+	[SENSOR_STATS_STREAM_START] = "stream_start",
+};
+
+static struct dentry *sensor_stats_root;
+
+static u32 sensor_stats_since(ktime_t start)
+{
+	return min_t(s64, ktime_us_delta(ktime_get(), start), U32_MAX);
+}
+
+static void sensor_stats_hist_add(struct sensor_stats_hist *hist, u32 us)
+{
+	hist->count++;
+	hist->total_us += us;
+	hist->max_us = max(hist->max_us, us);
+	hist->buckets[min(fls(us), SENSOR_STATS_HIST_BUCKETS - 1)]++;
+}
+
+static void sensor_stats_hist_show(struct seq_file *s,
+				   const struct sensor_stats_hist *hist)
+{
+	unsigned int i;
+
+	if (!hist->count)
+		return;
+
+	seq_printf(s, "  count %llu avg %llu us max %u us\n", hist->count,
+		   div64_u64(hist->total_us, hist->count), hist->max_us);
+
+	for (i = 0; i < SENSOR_STATS_HIST_BUCKETS; i++) {
+		if (!hist->buckets[i])
+			continue;
+
+		if (i == SENSOR_STATS_HIST_BUCKETS - 1)
+			seq_printf(s, "  >= %8u us: %llu\n", 1U << (i - 1),
+				   hist->buckets[i]);
+		else
+			seq_printf(s, "  <  %8u us: %llu\n", 1U << i,
+				   hist->buckets[i]);
+	}
+}
+
+static int sensor_stats_i2c_show(struct seq_file *s, void *unused)
+{
+	struct sensor_stats *stats = s->private;
+	const struct sensor_stats_transfers *xfer;
+	unsigned int i;
+
+	spin_lock(&stats->lock);
+
+	for (i = 0; i < SENSOR_STATS_NUM_SITES; i++) {
+		xfer = &stats->xfer[i];
+		seq_printf(s, "%s: transfers %llu bytes %llu retries %llu errors %llu\n",
+			   sensor_stats_site_names[i], xfer->transfers,
+			   xfer->bytes, xfer->retries, xfer->errors);
+		sensor_stats_hist_show(s, &xfer->latency);
+	}
+
+	spin_unlock(&stats->lock);
+
+	return 0;
+}
+DEFINE_SHOW_ATTRIBUTE(sensor_stats_i2c);
+
+static int sensor_stats_phases_show(struct seq_file *s, void *unused)
+{
+	struct sensor_stats *stats = s->private;
+	unsigned int i;
+
+	spin_lock(&stats->lock);
+
+	for (i = 0; i < SENSOR_STATS_NUM_PHASES; i++) {
+		seq_printf(s, "%s:\n", sensor_stats_phase_names[i]);
+		sensor_stats_hist_show(s, &stats->phase[i]);
+	}
+
+	spin_unlock(&stats->lock);
+
+	return 0;
+}
+DEFINE_SHOW_ATTRIBUTE(sensor_stats_phases);
+
+static int sensor_stats_power_show(struct seq_file *s, void *unused)
+{
+	struct sensor_stats *stats = s->private;
+
+	spin_lock(&stats->lock);
+
+	seq_printf(s, "on %llu off %llu\n", stats->power_on, stats->power_off);
+	if (stats->settle)
+		seq_printf(s, "settle last %u us max %u us\n",
+			   stats->settle->last_us, stats->settle->max_us);
+
+	spin_unlock(&stats->lock);
+
+	return 0;
+}
+DEFINE_SHOW_ATTRIBUTE(sensor_stats_power);
+
+static ssize_t sensor_stats_reset_write(struct file *file,
+					const char __user *buf, size_t count,
+					loff_t *ppos)
+{
+	struct sensor_stats *stats = file->private_data;
+
+	spin_lock(&stats->lock);
+	stats->power_on = 0;
+	stats->power_off = 0;
+	memset(stats->xfer, 0, sizeof(stats->xfer));
+	memset(stats->phase, 0, sizeof(stats->phase));
+	spin_unlock(&stats->lock);
+
+	return count;
+}
+
+static const struct file_operations sensor_stats_reset_fops = {
+	.owner = THIS_MODULE,
+	.open = simple_open,
+	.write = sensor_stats_reset_write,
+	.llseek = noop_llseek,
+};
+
+/**
+ * sensor_stats_init - set up the statistics of a sensor
+ * @stats: statistics to set up, zeroed by the caller
+ * @dev: sensor device, names the debugfs directory
+ * @settle: power-on settle times to show, may be NULL
+ *
+ * Must be called before the sensor is accessed. debugfs failures aren't
+ * fatal, the statistics are still gathered for the tracepoints.
+ */
+void sensor_stats_init(struct sensor_stats *stats, struct device *dev,
+		       const struct sensor_settle *settle)
+{
+	spin_lock_init(&stats->lock);
+	stats->dev = dev;
+	stats->settle = settle;
+
+	stats->dir = debugfs_create_dir(dev_name(dev), sensor_stats_root);
+	debugfs_create_file("i2c", 0444, stats->dir, stats,
+			    &sensor_stats_i2c_fops);
+	debugfs_create_file("phases", 0444, stats->dir, stats,
+			    &sensor_stats_phases_fops);
+	debugfs_create_file("power", 0444, stats->dir, stats,
+			    &sensor_stats_power_fops);
+	debugfs_create_file("reset", 0200, stats->dir, stats,
+			    &sensor_stats_reset_fops);
+}
+EXPORT_SYMBOL_GPL(sensor_stats_init);
+
+void sensor_stats_exit(struct sensor_stats *stats)
+{
+	debugfs_remove_recursive(stats->dir);
+	stats->dir = NULL;
+}
+EXPORT_SYMBOL_GPL(sensor_stats_exit);
+
+/*
+ * sensor_stats_xfer - account one I2C transfer
+ * @stats: sensor statistics
+ * @site: kind of transfer
+ * @reg: first register accessed
+ * @len: number of registers accessed
+ * @start: ktime_get() taken before the transfer
+ * @ret: result of the transfer, negative on error
+ */
+void sensor_stats_xfer(struct sensor_stats *stats,
+		       enum sensor_stats_site site, u16 reg, unsigned int len,
+		       ktime_t start, int ret)
+{
+	struct sensor_stats_transfers *xfer = &stats->xfer[site];
+	u32 us = sensor_stats_since(start);
+
+	if (site == SENSOR_STATS_READ || site == SENSOR_STATS_SETTLE)
+		trace_sensor_reg_read(stats->dev, site, reg, len, ret, us);
+	else
+		trace_sensor_reg_write(stats->dev, site, reg, len, ret, us);
+
+	spin_lock(&stats->lock);
+	xfer->transfers++;
+	if (ret < 0) {
+		xfer->errors++;
+	} else {
+		xfer->bytes += len;
+		sensor_stats_hist_add(&xfer->latency, us);
+	}
+	spin_unlock(&stats->lock);
+}
+EXPORT_SYMBOL_GPL(sensor_stats_xfer);
+
+void sensor_stats_retry(struct sensor_stats *stats,
+			enum sensor_stats_site site)
+{
+	spin_lock(&stats->lock);
+	stats->xfer[site].retries++;
+	spin_unlock(&stats->lock);
+}
+EXPORT_SYMBOL_GPL(sensor_stats_retry);
+
+/* Account a step of the stream start, @start taken when it began */
+void sensor_stats_phase(struct sensor_stats *stats,
+			enum sensor_stats_phase phase, ktime_t start)
+{
+	u32 us = sensor_stats_since(start);
+
+	trace_sensor_phase(stats->dev, phase, us);
+
+	spin_lock(&stats->lock);
+	sensor_stats_hist_add(&stats->phase[phase], us);
+	spin_unlock(&stats->lock);
+}
+EXPORT_SYMBOL_GPL(sensor_stats_phase);
+
+void sensor_stats_power(struct sensor_stats *stats, bool on)
+{
+	trace_sensor_power(stats->dev, on);
+
+	spin_lock(&stats->lock);
+	if (on)
+		stats->power_on++;
+	else
+		stats->power_off++;
+	spin_unlock(&stats->lock);
+}
+EXPORT_SYMBOL_GPL(sensor_stats_power);
+
+static int __init sensor_stats_module_init(void)
+{
+	sensor_stats_root = debugfs_create_dir("sensor_stats", NULL);
+
+	return 0;
+}
+module_init(sensor_stats_module_init);
+
+static void __exit sensor_stats_module_exit(void)
+{
+	/* Sensor modules hold a reference to us, their dirs are gone */
+	debugfs_remove_recursive(sensor_stats_root);
+}
+module_exit(sensor_stats_module_exit);
+
+MODULE_DESCRIPTION("I2C and stream start statistics of the IPU3 camera sensors");
+MODULE_LICENSE("GPL");
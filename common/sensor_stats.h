@@ -0,0 +1,82 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+/*
+ * I2C and stream start statistics of the sensor drivers in this repo,
+ * exposed in debugfs. See sensor_stats.c.
+ */
+
+#ifndef __SENSOR_STATS_H__
+#define __SENSOR_STATS_H__
+
+#include <linux/device.h>
+#include <linux/ktime.h>
+#include <linux/spinlock.h>
+#include <linux/types.h>
+
+struct dentry;
+struct sensor_settle;
+
+/* Kinds of I2C transfers, counted separately */
+enum sensor_stats_site {
+	SENSOR_STATS_READ,		/* register reads */
+	SENSOR_STATS_WRITE,		/* single register writes */
+	SENSOR_STATS_TABLE,		/* register table writes */
+	SENSOR_STATS_SETTLE,		/* chip ID polls after power-on */
+	SENSOR_STATS_NUM_SITES,
+};
+
+/* Steps of powering up and starting the stream, timed separately */
+enum sensor_stats_phase {
+	SENSOR_STATS_POWER_ON,
+	SENSOR_STATS_GLOBAL_REGS,
+	SENSOR_STATS_MODE_REGS,
+	SENSOR_STATS_CTRL_SETUP,	/* __v4l2_ctrl_handler_setup() */
+	SENSOR_STATS_STREAM_ON,		/* the stream on register write */
+	SENSOR_STATS_STREAM_START,	/* the whole of s_stream(1) */
+	SENSOR_STATS_NUM_PHASES,
+};
+
+/* bucket n counts durations below 2^n us, the last one everything above */
+#define SENSOR_STATS_HIST_BUCKETS	21
+
+struct sensor_stats_hist {
+	u64 count;
+	u64 total_us;
+	u32 max_us;
+	u64 buckets[SENSOR_STATS_HIST_BUCKETS];
+};
+
+struct sensor_stats_transfers {
+	u64 transfers;
+	u64 bytes;
+	u64 retries;
+	u64 errors;
+	struct sensor_stats_hist latency;
+};
+
+struct sensor_stats {
+	struct device *dev;
+	struct dentry *dir;
+	/* may be NULL, shown along the power transitions */
+	const struct sensor_settle *settle;
+
+	spinlock_t lock;	/* protects everything below */
+	u64 power_on;
+	u64 power_off;
+	struct sensor_stats_transfers xfer[SENSOR_STATS_NUM_SITES];
+	struct sensor_stats_hist phase[SENSOR_STATS_NUM_PHASES];
+};
+
+void sensor_stats_init(struct sensor_stats *stats, struct device *dev,
+		       const struct sensor_settle *settle);
+void sensor_stats_exit(struct sensor_stats *stats);
+
+void sensor_stats_xfer(struct sensor_stats *stats,
+		       enum sensor_stats_site site, u16 reg, unsigned int len,
+		       ktime_t start, int ret);
+void sensor_stats_retry(struct sensor_stats *stats,
+			enum sensor_stats_site site);
+void sensor_stats_phase(struct sensor_stats *stats,
+			enum sensor_stats_phase phase, ktime_t start);
+void sensor_stats_power(struct sensor_stats *stats, bool on);
+
+#endif /* __SENSOR_STATS_H__ */
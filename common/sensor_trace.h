@@ -0,0 +1,117 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+/*
+ * Tracepoints of the sensor drivers in this repo, emitted by sensor_stats.c
+ */
+
+#undef TRACE_SYSTEM
+#define TRACE_SYSTEM sensor
+
+#if !defined(__SENSOR_TRACE_H__) || defined(TRACE_HEADER_MULTI_READ)
+#define __SENSOR_TRACE_H__
+
+#include <linux/device.h>
+#include <linux/tracepoint.h>
+
+#include "sensor_stats.h"
+
+#define show_sensor_site(site)						\
+	__print_symbolic(site,						\
+			 { SENSOR_STATS_READ, "read" },			\
+			 { SENSOR_STATS_WRITE, "write" },		\
+			 { SENSOR_STATS_TABLE, "table" },		\
+			 { SENSOR_STATS_SETTLE, "settle" })
+
+#define show_sensor_phase(phase)					\
+	__print_symbolic(phase,						\
+			 { SENSOR_STATS_POWER_ON, "power_on" },		\
+			 { SENSOR_STATS_GLOBAL_REGS, "global_regs" },	\
+			 { SENSOR_STATS_MODE_REGS, "mode_regs" },	\
+			 { SENSOR_STATS_CTRL_SETUP, "ctrl_setup" },	\
+			 { SENSOR_STATS_STREAM_ON, "stream_on" },	\
+			 { SENSOR_STATS_STREAM_START, "stream_start" })
+
+DECLARE_EVENT_CLASS(sensor_reg,
+	TP_PROTO(struct device *dev, int site, u16 reg, unsigned int len,
+		 int ret, u32 us),
+	TP_ARGS(dev, site, reg, len, ret, us),
+
+	TP_STRUCT__entry(
+		__string(name, dev_name(dev))
+		__field(int, site)
+		__field(u16, reg)
+		__field(unsigned int, len)
+		__field(int, ret)
+		__field(u32, us)
+	),
+
+	TP_fast_assign(
+		__assign_str(name, dev_name(dev));
+		__entry->site = site;
+		__entry->reg = reg;
+		__entry->len = len;
+		__entry->ret = ret;
+		__entry->us = us;
+	),
+
+	TP_printk("%s %s reg=0x%04x len=%u ret=%d %uus", __get_str(name),
+		  show_sensor_site(__entry->site), __entry->reg, __entry->len,
+		  __entry->ret, __entry->us)
+);
+
+DEFINE_EVENT(sensor_reg, sensor_reg_write,
+	TP_PROTO(struct device *dev, int site, u16 reg, unsigned int len,
+		 int ret, u32 us),
+	TP_ARGS(dev, site, reg, len, ret, us)
+);
+
+DEFINE_EVENT(sensor_reg, sensor_reg_read,
+	TP_PROTO(struct device *dev, int site, u16 reg, unsigned int len,
+		 int ret, u32 us),
+	TP_ARGS(dev, site, reg, len, ret, us)
+);
+
+TRACE_EVENT(sensor_power,
+	TP_PROTO(struct device *dev, bool on),
+	TP_ARGS(dev, on),
+
+	TP_STRUCT__entry(
+		__string(name, dev_name(dev))
+		__field(bool, on)
+	),
+
+	TP_fast_assign(
+		__assign_str(name, dev_name(dev));
+		__entry->on = on;
+	),
+
+	TP_printk("%s power %s", __get_str(name), __entry->on ? "on" : "off")
+);
+
+TRACE_EVENT(sensor_phase,
+	TP_PROTO(struct device *dev, int phase, u32 us),
+	TP_ARGS(dev, phase, us),
+
+	TP_STRUCT__entry(
+		__string(name, dev_name(dev))
+		__field(int, phase)
+		__field(u32, us)
+	),
+
+	TP_fast_assign(
+		__assign_str(name, dev_name(dev));
+		__entry->phase = phase;
+		__entry->us = us;
+	),
+
+	TP_printk("%s %s %uus", __get_str(name),
+		  show_sensor_phase(__entry->phase), __entry->us)
+);
+
+#endif /* __SENSOR_TRACE_H__ */
+
+/* This part must be outside protection */
+#undef TRACE_INCLUDE_PATH
+#define TRACE_INCLUDE_PATH .
+#undef TRACE_INCLUDE_FILE
+#define TRACE_INCLUDE_FILE sensor_trace
+#include <trace/define_trace.h>
@@ -0,0 +1,104 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+/*
+ * Lens (VCM) sub-devices of the sensors, driven by vcm/sensor_vcm.c.
+ *
+ * The VCM fitted on a camera module has no ACPI device of its own, the
+ * sensor SSDB names its type. The sensor driver instantiates an I2C client
+ * for it and waits for its sub-device in a sub-notifier, which registers the
+ * lens with the media device. The lens has its own lock and runtime PM, so
+ * focus moves don't contend with sensor controls.
+ *
+ * The lens is not linked to the sensor entity: that takes an ancillary link,
+ * which the kernels this builds for don't have. See vcm/README.md.
+ */
+
+#ifndef __SENSOR_VCM_H__
+#define __SENSOR_VCM_H__
+
+#include <linux/device.h>
+#include <linux/err.h>
+#include <linux/i2c.h>
+#include <linux/string.h>
+#include <media/v4l2-async.h>
+
+#include "sensor_ssdb.h"
+
+#define SENSOR_VCM_ADDR		0x0c
+
+/* I2C device names, distinct from those of the upstream lens drivers */
+#define SENSOR_VCM_DW9714	"sensor_vcm_dw9714"
+#define SENSOR_VCM_AD5823	"sensor_vcm_ad5823"
+
+/* I2C device name of an SSDB VCM type, NULL if there is no driver for it */
+static inline const char *sensor_vcm_name(u8 vcm_type)
+{
+	switch (vcm_type) {
+	case SENSOR_SSDB_VCM_AD5823:
+		return SENSOR_VCM_AD5823;
+	case SENSOR_SSDB_VCM_DW9714:
+		return SENSOR_VCM_DW9714;
+	default:
+		return NULL;
+	}
+}
+
+/*
+ * sensor_vcm_new - instantiate the VCM of a sensor
+ * @sensor: sensor, the VCM sits on the same bus
+ * @name: I2C device name, see sensor_vcm_name()
+ *
+ * The VCM is powered by the sensor GPIOs, so a runtime PM device link keeps
+ * the sensor powered while the lens is in use. The link goes away with the
+ * VCM client.
+ *
+ * Only a lens with its driver bound ever completes the sub-notifier of the
+ * sensor. The lens driver probes synchronously, so -ENODEV is returned if
+ * sensor_vcm.ko isn't loaded or the probe failed, and the sensor goes on
+ * without a lens. The sensor module declares a softdep on sensor_vcm, so
+ * modprobe loads it first.
+ */
+static inline struct i2c_client *sensor_vcm_new(struct i2c_client *sensor,
+						const char *name)
+{
+	struct i2c_board_info info = {
+		.addr = SENSOR_VCM_ADDR,
+	};
+	struct i2c_client *vcm;
+	bool bound;
+
+	strscpy(info.type, name, sizeof(info.type));
+
+	vcm = i2c_new_client_device(sensor->adapter, &info);
+	if (IS_ERR(vcm))
+		return vcm;
+
+	device_lock(&vcm->dev);
+	bound = vcm->dev.driver;
+	device_unlock(&vcm->dev);
+	if (!bound) {
+		i2c_unregister_device(vcm);
+		return ERR_PTR(-ENODEV);
+	}
+
+	if (!device_link_add(&vcm->dev, &sensor->dev,
+			     DL_FLAG_STATELESS | DL_FLAG_PM_RUNTIME)) {
+		i2c_unregister_device(vcm);
+		return ERR_PTR(-EINVAL);
+	}
+
+	return vcm;
+}
+
+/* Add the VCM to the sub-notifier of the sensor, once registered */
+static inline int sensor_vcm_notifier_add(struct v4l2_async_notifier *notifier,
+					  struct i2c_client *vcm)
+{
+	struct v4l2_async_subdev *asd;
+
+	asd = v4l2_async_notifier_add_i2c_subdev(notifier, vcm->adapter->nr,
+						 vcm->addr, sizeof(*asd));
+
+	return PTR_ERR_OR_ZERO(asd);
+}
+
+#endif /* __SENSOR_VCM_H__ */
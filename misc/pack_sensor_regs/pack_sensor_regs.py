@@ -0,0 +1,383 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: GPL-2.0
+"""
+Generate packed register tables for the sensor drivers.
+
+Reads the flat register tables from the driver sources and writes a
+<driver>_regs_packed.h header next to each of them, in the format
+described in common/sensor_burst.h.
+
+For every table:
+  - writes between two barriers (a delay, or a write to a trigger register
+    such as stream on/off, software reset or group hold) are reduced to
+    the last value written to each register, sorted by address and merged
+    into bursts of consecutive registers;
+  - writes of a value the table already put into the register since the
+    last reset are dropped, and so are back-to-back repeats of the same
+    trigger write;
+  - the register image the original sequence leaves in the sensor is
+    compared against the packed one, both at every barrier and at the end.
+    A mismatch aborts the generation.
+
+Usage:
+  pack_sensor_regs.py           regenerate all headers
+  pack_sensor_regs.py --check   fail if a header is out of date
+"""
+
+import argparse
+import os
+import re
+import sys
+
+REPO = os.path.normpath(os.path.join(os.path.dirname(__file__), "..", ".."))
+
+SW_RESET_REG = 0x0103
+# max data bytes per burst (the record also carries the 2 address bytes)
+BURST_MAX = 32
+
+DRIVERS = [
+    {
+        "name": "ov5670",
+        "src": "ov5670/ov5670.c",
+        "fields": ("addr", "val"),
+        "triggers": [0x0100, 0x0103],
+        "tables": [
+            "mipi_data_rate_840mbps",
+            "mipi_data_rate_422mbps",
+            "mipi_data_rate_211mbps",
+            "mode_2592x1944_regs",
+            "mode_1296x972_regs",
+            "mode_648x486_regs",
+            "mode_2560x1440_regs",
+            "mode_1280x720_regs",
+            "mode_640x360_regs",
+        ],
+    },
+    {
+        "name": "ov5693",
+        "src": "ov5693/ov5693.h",
+        "fields": ("type", "addr", "val"),
+        "triggers": [0x0100, 0x0103, 0x3208],
+        "tables": [
+            "ov5693_global_setting",
+            "ov5693_736x496_30fps",
+            "ov5693_1616x1216_30fps",
+            "ov5693_2576x1456_30fps",
+            "ov5693_2576x1936_30fps",
+        ],
+    },
+    {
+        "name": "ov7251",
+        "src": "ov7251/ov7251.c",
+        "fields": ("addr", "val"),
+        "triggers": [0x0100, 0x0103],
+        "tables": [
+            "ov7251_global_init_setting",
+            "ov7251_setting_vga_30fps",
+            "ov7251_setting_vga_60fps",
+            "ov7251_setting_vga_90fps",
+        ],
+    },
+    {
+        "name": "ov8865",
+        "src": "ov8865/ov8865.c",
+        "fields": ("addr", "val", "delay"),
+        "triggers": [0x0100, 0x0103, 0x3208, 0x3d81],
+        "tables": [
+            "ov8865_init_setting_QUXGA",
+            "ov8865_setting_QUXGA",
+            "ov8865_setting_6M",
+            "ov8865_setting_UXGA",
+            "ov8865_setting_SVGA",
+        ],
+    },
+]
+
+
+class PackError(Exception):
+    pass
+
+
+def strip_comments(text):
+    text = re.sub(r"/\*.*?\*/", " ", text, flags=re.S)
+    return re.sub(r"//[^\n]*", "", text)
+
+
+def preprocess(text, defines):
+    """Drop the lines of #if blocks whose condition evaluates to false."""
+    out = []
+    stack = []
+    for line in text.split("\n"):
+        m = re.match(r"\s*#\s*(if|ifdef|ifndef|else|endif)\b(.*)", line)
+        if not m:
+            if all(stack):
+                out.append(line)
+            continue
+
+        directive, arg = m.group(1), m.group(2).strip()
+        if directive == "if":
+            try:
+                stack.append(bool(evaluate(arg, defines)))
+            except PackError:
+                stack.append(True)
+        elif directive in ("ifdef", "ifndef"):
+            # include guards and the like, keep them
+            stack.append(True)
+        elif directive == "else":
+            stack[-1] = not stack[-1]
+        else:
+            stack.pop()
+    return "\n".join(out)
+
+
+def parse_defines(text):
+    defines = {}
+    for m in re.finditer(r"^\s*#define\s+(\w+)[ \t]+([^\n]+)$", text, re.M):
+        defines[m.group(1)] = m.group(2).strip()
+    for m in re.finditer(r"\b([A-Z][A-Z0-9_]*)\s*=\s*(0x[0-9a-fA-F]+|\d+)\s*,",
+                         text):
+        defines.setdefault(m.group(1), m.group(2))
+    return defines
+
+
+def evaluate(expr, defines, depth=0):
+    if depth > 16:
+        raise PackError("define loop in '%s'" % expr)
+
+    def subst(m):
+        word = m.group(0)
+        if word in defines:
+            return "(%d)" % evaluate(defines[word], defines, depth + 1)
+        raise PackError("unknown symbol '%s'" % word)
+
+    expr = re.sub(r"\bBIT\s*\(", "(1 << ", expr)
+    expr = re.sub(r"\b(0x[0-9a-fA-F]+|\d+)[uUlL]+\b", r"\1", expr)
+    expr = re.sub(r"\b[A-Za-z_]\w*\b", subst, expr)
+    if not re.fullmatch(r"[\s\d()xXa-fA-F+\-*/<>|&~]*", expr):
+        raise PackError("cannot evaluate '%s'" % expr)
+    return int(eval(expr.replace("/", "//")))
+
+
+def parse_table(text, name, fields, defines):
+    m = re.search(r"\b%s\s*\[\s*\w*\s*\]\s*=\s*\{(.*?)\n\s*\};" % name,
+                  text, re.S)
+    if not m:
+        raise PackError("table %s not found" % name)
+
+    entries = []
+    for body in re.findall(r"\{([^{}]*)\}", m.group(1)):
+        values = [evaluate(v, defines) for v in body.split(",") if v.strip()]
+        entry = dict(zip(fields, values))
+        entry.setdefault("delay", 0)
+
+        if "type" in entry:
+            kind = entry["type"]
+            if kind == defines_value(defines, "OV5693_TOK_TERM"):
+                break
+            if kind == defines_value(defines, "OV5693_TOK_DELAY"):
+                entries.append({"addr": None, "val": 0,
+                                "delay": entry["val"]})
+                continue
+            if kind != defines_value(defines, "OV5693_8BIT"):
+                raise PackError("%s: only 8-bit entries are supported"
+                                % name)
+        entries.append(entry)
+    return entries
+
+
+def defines_value(defines, name):
+    return evaluate(defines[name], defines) if name in defines else None
+
+
+def simulate(records):
+    """
+    Run a write sequence against a model of the register image.
+
+    Returns the list of observable events: the image at every trigger
+    write and every delay, plus the final image. Back-to-back identical
+    events are merged, as repeating them does not change the sensor state.
+    """
+    image = {}
+    events = []
+    for rec in records:
+        if rec[0] == "delay":
+            event = ("delay", rec[1], tuple(sorted(image.items())))
+        else:
+            addr, vals, trigger = rec[1], rec[2], rec[3]
+            for i, val in enumerate(vals):
+                if addr + i == SW_RESET_REG and val & 1:
+                    image = {}
+                else:
+                    image[addr + i] = val
+            if not trigger:
+                continue
+            event = ("trigger", addr, tuple(vals),
+                     tuple(sorted(image.items())))
+        if not events or events[-1] != event:
+            events.append(event)
+    events.append(("final", tuple(sorted(image.items()))))
+    return events
+
+
+def flat_records(entries, triggers):
+    records = []
+    for e in entries:
+        if e["addr"] is not None:
+            records.append(("write", e["addr"], [e["val"]],
+                            e["addr"] in triggers))
+        if e["delay"]:
+            records.append(("delay", e["delay"]))
+    return records
+
+
+def pack(entries, triggers):
+    records = []
+    pending = {}
+    known = {}
+    last_trigger = None
+
+    def flush():
+        nonlocal last_trigger
+        run = []
+        for addr in sorted(pending):
+            val = pending[addr]
+            if known.get(addr) == val:
+                continue
+            if run and (run[-1][0] + 1 != addr or len(run) == BURST_MAX):
+                emit_run(run)
+                run = []
+            run.append((addr, val))
+            known[addr] = val
+        if run:
+            emit_run(run)
+        pending.clear()
+
+    def emit_run(run):
+        nonlocal last_trigger
+        records.append(("write", run[0][0], [v for _, v in run], False))
+        last_trigger = None
+
+    for e in entries:
+        addr, val, delay = e["addr"], e["val"], e["delay"]
+
+        if addr is not None and addr in triggers:
+            flush()
+            if last_trigger != (addr, val):
+                records.append(("write", addr, [val], True))
+                last_trigger = (addr, val)
+            if addr == SW_RESET_REG and val & 1:
+                known.clear()
+            else:
+                known[addr] = val
+        elif addr is not None:
+            pending[addr] = val
+
+        if delay:
+            flush()
+            records.append(("delay", delay))
+            last_trigger = None
+
+    flush()
+    return records
+
+
+def emit_c(name, records, n_entries):
+    lines = []
+    n_msgs = sum(1 for r in records if r[0] == "write")
+    lines.append("/* %d entries, %d messages */" % (n_entries, n_msgs))
+    lines.append("static const u8 %s_packed[] = {" % name)
+    for rec in records:
+        if rec[0] == "delay":
+            if rec[1] > 0xff:
+                raise PackError("%s: delay %d ms does not fit" %
+                                (name, rec[1]))
+            lines.append("\tSENSOR_BURST_DELAY, %d," % rec[1])
+            continue
+
+        addr, vals = rec[1], rec[2]
+        lines.append("\t%d, 0x%02x, 0x%02x," %
+                     (len(vals) + 2, addr >> 8, addr & 0xff))
+        for i in range(0, len(vals), 8):
+            lines.append("\t\t" + " ".join("0x%02x," % v
+                                            for v in vals[i:i + 8]))
+    lines.append("};")
+    return "\n".join(lines)
+
+
+def generate(drv):
+    src = os.path.join(REPO, drv["src"])
+    with open(src) as f:
+        text = strip_comments(f.read())
+    defines = parse_defines(text)
+    text = preprocess(text, defines)
+
+    out = []
+    out.append("/* SPDX-License-Identifier: GPL-2.0 */")
+    out.append("/*")
+    out.append(" * Generated by misc/pack_sensor_regs/pack_sensor_regs.py "
+               "from %s." % os.path.basename(drv["src"]))
+    out.append(" * Do not edit, regenerate after changing the register "
+               "tables.")
+    out.append(" */")
+    out.append("")
+    guard = "__%s_REGS_PACKED_H__" % drv["name"].upper()
+    out.append("#ifndef %s" % guard)
+    out.append("#define %s" % guard)
+    out.append("")
+    out.append('#include "sensor_burst.h"')
+
+    for name in drv["tables"]:
+        entries = parse_table(text, name, drv["fields"], defines)
+        records = pack(entries, drv["triggers"])
+
+        before = simulate(flat_records(entries, drv["triggers"]))
+        after = simulate(records)
+        if before != after:
+            raise PackError("%s: packed table changes the register image"
+                            % name)
+
+        out.append("")
+        out.append(emit_c(name, records,
+                          sum(1 for e in entries if e["addr"] is not None)))
+
+    out.append("")
+    out.append("#endif /* %s */" % guard)
+    return "\n".join(out) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[1])
+    parser.add_argument("--check", action="store_true",
+                        help="only check that the headers are up to date")
+    args = parser.parse_args()
+
+    stale = False
+    for drv in DRIVERS:
+        dst = os.path.join(REPO, os.path.dirname(drv["src"]),
+                           "%s_regs_packed.h" % drv["name"])
+        try:
+            content = generate(drv)
+        except PackError as e:
+            sys.exit("%s: %s" % (drv["src"], e))
+
+        try:
+            with open(dst) as f:
+                current = f.read()
+        except FileNotFoundError:
+            current = None
+
+        if current == content:
+            continue
+        if args.check:
+            print("%s is out of date" % os.path.relpath(dst, REPO))
+            stale = True
+            continue
+        with open(dst, "w") as f:
+            f.write(content)
+        print("wrote %s" % os.path.relpath(dst, REPO))
+
+    return 1 if stale else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -3,6 +3,7 @@
 
 #include <linux/acpi.h>
 #include <linux/delay.h>
+#include <linux/gcd.h>
 #include <linux/i2c.h>
 #include <linux/module.h>
 #include <linux/pm_runtime.h>
@@ -10,10 +11,19 @@
 #include <media/v4l2-device.h>
 #include <media/v4l2-fwnode.h>
 
+#include "int3472_dep.h"
+#include "sensor_regcache.h"
+#include "sensor_settle.h"
+#include "sensor_ssdb.h"
+#include "sensor_stats.h"
+#include "ov5670_regs_packed.h"
+
 #define OV5670_HID "INT3479"
 
 #define OV5670_REG_CHIP_ID		0x300a
 #define OV5670_CHIP_ID			0x005670
+/* upper bound of the wait for the sensor to answer after power-on */
+#define OV5670_SETTLE_TIMEOUT_US	50000
 
 #define OV5670_REG_MODE_SELECT		0x0100
 #define OV5670_MODE_STANDBY		0x00
@@ -22,14 +32,47 @@
 #define OV5670_REG_SOFTWARE_RST		0x0103
 #define OV5670_SOFTWARE_RST		0x01
 
+/* MIPI PCLK period, in 1/16 ns per bit */
+#define OV5670_REG_PCLK_PERIOD		0x4837
+
+/* Highest register address kept in the register cache */
+#define OV5670_REGCACHE_MAX_REG		0x5fff
+
+/* Max number of data bytes sent in one burst write */
+#define OV5670_REG_BURST_MAX		32
+
 /* vertical-timings from sensor */
 #define OV5670_REG_VTS			0x380e
 #define OV5670_VTS_30FPS		0x0808 /* default for 30 fps */
+#define OV5670_VTS_60FPS		0x040a
+#define OV5670_VTS_120FPS		0x0205
 #define OV5670_VTS_MAX			0xffff
 
 /* horizontal-timings from sensor */
 #define OV5670_REG_HTS			0x380c
 
+/* Array window and output size, 16 bits each from X_ADDR_START on */
+#define OV5670_REG_X_ADDR_START		0x3800
+
+/*
+ * Pixel array, in the addresses of the array window registers. The window
+ * is read with a few more pixels than the output around it, trimmed by the
+ * ISP window: 4 columns on either side, 2 lines above and 6 below.
+ */
+#define OV5670_NATIVE_WIDTH		2624
+#define OV5670_NATIVE_HEIGHT		1980
+#define OV5670_PIXEL_ARRAY_LEFT		16
+#define OV5670_PIXEL_ARRAY_TOP		6
+#define OV5670_PIXEL_ARRAY_WIDTH	2592
+#define OV5670_PIXEL_ARRAY_HEIGHT	1944
+#define OV5670_WIN_PAD_X		4
+#define OV5670_WIN_PAD_TOP		2
+#define OV5670_WIN_PAD_BOTTOM		6
+#define OV5670_CROP_MIN_WIDTH		64
+#define OV5670_CROP_MIN_HEIGHT		64
+/* shortest blanking of the mode tables, that of 1296x972 */
+#define OV5670_VBLANK_MIN		24
+
 /*
  * Pixels-per-line(PPL) = Time-per-line * pixel-rate
  * In OV5670, Time-per-line = HTS/SCLK.
@@ -78,10 +121,13 @@ struct ov5670_reg {
 struct ov5670_reg_list {
 	u32 num_of_regs;
 	const struct ov5670_reg *regs;
+	/* regs pre-coalesced by misc/pack_sensor_regs */
+	struct sensor_burst_table packed;
 };
 
 struct ov5670_link_freq_config {
-	u32 pixel_rate;
+	/* MIPI PCLK period, written over the one of the mode tables */
+	u8 pclk_period;
 	const struct ov5670_reg_list reg_list;
 };
 
@@ -98,13 +144,15 @@ struct ov5670_mode {
 	/* Min vertical timining size */
 	u32 vts_min;
 
-	/* Link frequency needed for this resolution */
-	u32 link_freq_index;
-
 	/* Sensor register settings for this resolution */
-	const struct ov5670_reg_list reg_list;
+	struct ov5670_reg_list reg_list;
 };
 
+/*
+ * PLL1 feeds the MIPI clock only, the divider in 0x0303 (divided by value
+ * + 1) sets the link frequency. The sensor clock comes from PLL2, so the
+ * timings and the pixel rate don't change with it.
+ */
 static const struct ov5670_reg mipi_data_rate_840mbps[] = {
 	{0x0300, 0x04},
 	{0x0301, 0x00},
@@ -123,6 +171,42 @@ static const struct ov5670_reg mipi_data_rate_840mbps[] = {
 	{0x3031, 0x0a},
 };
 
+static const struct ov5670_reg mipi_data_rate_422mbps[] = {
+	{0x0300, 0x04},
+	{0x0301, 0x00},
+	{0x0302, 0x84},
+	{0x0303, 0x01},
+	{0x0304, 0x03},
+	{0x0305, 0x01},
+	{0x0306, 0x01},
+	{0x030a, 0x00},
+	{0x030b, 0x00},
+	{0x030c, 0x00},
+	{0x030d, 0x26},
+	{0x030e, 0x00},
+	{0x030f, 0x06},
+	{0x0312, 0x01},
+	{0x3031, 0x0a},
+};
+
+static const struct ov5670_reg mipi_data_rate_211mbps[] = {
+	{0x0300, 0x04},
+	{0x0301, 0x00},
+	{0x0302, 0x84},
+	{0x0303, 0x03},
+	{0x0304, 0x03},
+	{0x0305, 0x01},
+	{0x0306, 0x01},
+	{0x030a, 0x00},
+	{0x030b, 0x00},
+	{0x030c, 0x00},
+	{0x030d, 0x26},
+	{0x030e, 0x00},
+	{0x030f, 0x06},
+	{0x0312, 0x01},
+	{0x3031, 0x0a},
+};
+
 static const struct ov5670_reg mode_2592x1944_regs[] = {
 	{0x3000, 0x00},
 	{0x3002, 0x21},
@@ -1723,28 +1807,70 @@ static const char * const ov5670_test_pattern_menu[] = {
 	"Vertical Color Bar Type 1",
 };
 
-/* Supported link frequencies */
+/* The register tables drive a 2 lane link */
+#define OV5670_DATA_LANES		2
+
+#define OV5670_BITS_PER_SAMPLE		10
+
+/*
+ * Share of the raw link bandwidth a line may use. The rest is left for
+ * the CSI-2 packet header and footer and the HS/LP transitions of every
+ * line.
+ */
+#define OV5670_LINK_HEADROOM_PCT	80
+
+/*
+ * Sensor pixel rate, that of the full speed link:
+ * pixel_rate = link_freq * 2 * nr_of_lanes / bits_per_sample
+ */
+#define OV5670_PIXEL_RATE		168960000
+
+/* Supported link frequencies, fastest first */
 #define OV5670_LINK_FREQ_422MHZ		422400000
-#define OV5670_LINK_FREQ_422MHZ_INDEX	0
+#define OV5670_LINK_FREQ_211MHZ		211200000
+#define OV5670_LINK_FREQ_105MHZ		105600000
 static const struct ov5670_link_freq_config link_freq_configs[] = {
 	{
-		/* pixel_rate = link_freq * 2 * nr_of_lanes / bits_per_sample */
-		.pixel_rate = (OV5670_LINK_FREQ_422MHZ * 2 * 2) / 10,
+		.pclk_period = 0x13,
 		.reg_list = {
 			.num_of_regs = ARRAY_SIZE(mipi_data_rate_840mbps),
 			.regs = mipi_data_rate_840mbps,
+			.packed = SENSOR_BURST_TABLE(mipi_data_rate_840mbps_packed),
+		}
+	},
+	{
+		.pclk_period = 0x26,
+		.reg_list = {
+			.num_of_regs = ARRAY_SIZE(mipi_data_rate_422mbps),
+			.regs = mipi_data_rate_422mbps,
+			.packed = SENSOR_BURST_TABLE(mipi_data_rate_422mbps_packed),
+		}
+	},
+	{
+		.pclk_period = 0x4c,
+		.reg_list = {
+			.num_of_regs = ARRAY_SIZE(mipi_data_rate_211mbps),
+			.regs = mipi_data_rate_211mbps,
+			.packed = SENSOR_BURST_TABLE(mipi_data_rate_211mbps_packed),
 		}
 	}
 };
 
 static const s64 link_freq_menu_items[] = {
-	OV5670_LINK_FREQ_422MHZ
+	OV5670_LINK_FREQ_422MHZ,
+	OV5670_LINK_FREQ_211MHZ,
+	OV5670_LINK_FREQ_105MHZ
 };
 
 /*
  * OV5670 sensor supports following resolutions with full FOV:
  * 4:3  ==> {2592x1944, 1296x972, 648x486}
  * 16:9 ==> {2560x1440, 1280x720, 640x360}
+ *
+ * The binned modes also come at 60 fps, and the two smallest at 120 fps.
+ * Those entries only differ in their default VTS and follow the 30 fps
+ * ones, which v4l2_find_nearest_size() returns first for a size. They are
+ * picked through the frame interval.
  */
 static const struct ov5670_mode supported_modes[] = {
 	{
@@ -1755,8 +1881,8 @@ static const struct ov5670_mode supported_modes[] = {
 		.reg_list = {
 			.num_of_regs = ARRAY_SIZE(mode_2592x1944_regs),
 			.regs = mode_2592x1944_regs,
+			.packed = SENSOR_BURST_TABLE(mode_2592x1944_regs_packed),
 		},
-		.link_freq_index = OV5670_LINK_FREQ_422MHZ_INDEX,
 	},
 	{
 		.width = 1296,
@@ -1766,8 +1892,8 @@ static const struct ov5670_mode supported_modes[] = {
 		.reg_list = {
 			.num_of_regs = ARRAY_SIZE(mode_1296x972_regs),
 			.regs = mode_1296x972_regs,
+			.packed = SENSOR_BURST_TABLE(mode_1296x972_regs_packed),
 		},
-		.link_freq_index = OV5670_LINK_FREQ_422MHZ_INDEX,
 	},
 	{
 		.width = 648,
@@ -1777,8 +1903,8 @@ static const struct ov5670_mode supported_modes[] = {
 		.reg_list = {
 			.num_of_regs = ARRAY_SIZE(mode_648x486_regs),
 			.regs = mode_648x486_regs,
+			.packed = SENSOR_BURST_TABLE(mode_648x486_regs_packed),
 		},
-		.link_freq_index = OV5670_LINK_FREQ_422MHZ_INDEX,
 	},
 	{
 		.width = 2560,
@@ -1788,8 +1914,8 @@ static const struct ov5670_mode supported_modes[] = {
 		.reg_list = {
 			.num_of_regs = ARRAY_SIZE(mode_2560x1440_regs),
 			.regs = mode_2560x1440_regs,
+			.packed = SENSOR_BURST_TABLE(mode_2560x1440_regs_packed),
 		},
-		.link_freq_index = OV5670_LINK_FREQ_422MHZ_INDEX,
 	},
 	{
 		.width = 1280,
@@ -1799,8 +1925,8 @@ static const struct ov5670_mode supported_modes[] = {
 		.reg_list = {
 			.num_of_regs = ARRAY_SIZE(mode_1280x720_regs),
 			.regs = mode_1280x720_regs,
+			.packed = SENSOR_BURST_TABLE(mode_1280x720_regs_packed),
 		},
-		.link_freq_index = OV5670_LINK_FREQ_422MHZ_INDEX,
 	},
 	{
 		.width = 640,
@@ -1810,11 +1936,84 @@ static const struct ov5670_mode supported_modes[] = {
 		.reg_list = {
 			.num_of_regs = ARRAY_SIZE(mode_640x360_regs),
 			.regs = mode_640x360_regs,
+			.packed = SENSOR_BURST_TABLE(mode_640x360_regs_packed),
+		},
+	},
+	{
+		.width = 1296,
+		.height = 972,
+		.vts_def = OV5670_VTS_60FPS,
+		.vts_min = 996,
+		.reg_list = {
+			.num_of_regs = ARRAY_SIZE(mode_1296x972_regs),
+			.regs = mode_1296x972_regs,
+			.packed = SENSOR_BURST_TABLE(mode_1296x972_regs_packed),
+		},
+	},
+	{
+		.width = 1280,
+		.height = 720,
+		.vts_def = OV5670_VTS_60FPS,
+		.vts_min = 1020,
+		.reg_list = {
+			.num_of_regs = ARRAY_SIZE(mode_1280x720_regs),
+			.regs = mode_1280x720_regs,
+			.packed = SENSOR_BURST_TABLE(mode_1280x720_regs_packed),
+		},
+	},
+	{
+		.width = 648,
+		.height = 486,
+		.vts_def = OV5670_VTS_60FPS,
+		.vts_min = 516,
+		.reg_list = {
+			.num_of_regs = ARRAY_SIZE(mode_648x486_regs),
+			.regs = mode_648x486_regs,
+			.packed = SENSOR_BURST_TABLE(mode_648x486_regs_packed),
+		},
+	},
+	{
+		.width = 648,
+		.height = 486,
+		.vts_def = OV5670_VTS_120FPS,
+		.vts_min = 516,
+		.reg_list = {
+			.num_of_regs = ARRAY_SIZE(mode_648x486_regs),
+			.regs = mode_648x486_regs,
+			.packed = SENSOR_BURST_TABLE(mode_648x486_regs_packed),
+		},
+	},
+	{
+		.width = 640,
+		.height = 360,
+		.vts_def = OV5670_VTS_60FPS,
+		.vts_min = 510,
+		.reg_list = {
+			.num_of_regs = ARRAY_SIZE(mode_640x360_regs),
+			.regs = mode_640x360_regs,
+			.packed = SENSOR_BURST_TABLE(mode_640x360_regs_packed),
+		},
+	},
+	{
+		.width = 640,
+		.height = 360,
+		.vts_def = OV5670_VTS_120FPS,
+		.vts_min = 510,
+		.reg_list = {
+			.num_of_regs = ARRAY_SIZE(mode_640x360_regs),
+			.regs = mode_640x360_regs,
+			.packed = SENSOR_BURST_TABLE(mode_640x360_regs_packed),
 		},
-		.link_freq_index = OV5670_LINK_FREQ_422MHZ_INDEX,
 	}
 };
 
+static const struct v4l2_rect ov5670_default_crop = {
+	.left = OV5670_PIXEL_ARRAY_LEFT,
+	.top = OV5670_PIXEL_ARRAY_TOP,
+	.width = OV5670_PIXEL_ARRAY_WIDTH,
+	.height = OV5670_PIXEL_ARRAY_HEIGHT,
+};
+
 struct ov5670 {
 	struct v4l2_subdev sd;
 	struct media_pad pad;
@@ -1829,6 +2028,18 @@ struct ov5670 {
 
 	/* Current mode */
 	const struct ov5670_mode *cur_mode;
+	/* Link frequency of cur_mode, an index in link_freq_configs[] */
+	unsigned int link_freq_index;
+	/* Link frequencies the firmware allows, bit n for index n */
+	unsigned long link_freq_mask;
+
+	/*
+	 * Analog crop, in the full size readout only. The other modes read
+	 * the whole array. When set, cur_mode points to crop_mode, the full
+	 * size mode with the size and frame length of the crop.
+	 */
+	struct v4l2_rect crop;
+	struct ov5670_mode crop_mode;
 
 	/* To serialize asynchronus callbacks */
 	struct mutex mutex;
@@ -1836,21 +2047,34 @@ struct ov5670 {
 	/* Streaming on/off */
 	bool streaming;
 
-	/* dependent device (PMIC) */
-	struct device *dep_dev;
+	/* Shadow of the sensor registers, protected by mutex */
+	struct sensor_regcache regcache;
 
-	/* GPIOs defined in dep_dev _CRS. The last "led_gpio" may not exist
-	 * depending on devices.
+	/*
+	 * The sensor holds a complete PLL and mode register image written
+	 * since it was last powered up, so a mode change only needs to
+	 * write the registers that differ.
 	 */
-	struct gpio_desc *xshutdn;
-	struct gpio_desc *pwdnb;
-	struct gpio_desc *led_gpio;
+	bool regs_programmed;
+
+	/* Time the sensor took to answer after power-on */
+	struct sensor_settle settle;
+	/* I2C and stream start statistics, in debugfs */
+	struct sensor_stats stats;
+
+	/* dependent device (PMIC) holding the power GPIOs */
+	struct int3472_dep *dep;
 
 	bool is_rpm_supported;
 };
 
 #define to_ov5670(_sd)	container_of(_sd, struct ov5670, sd)
 
+static const struct sensor_reg_range ov5670_volatile_regs[] = {
+	SENSOR_REG_RANGE(OV5670_REG_SOFTWARE_RST, OV5670_REG_SOFTWARE_RST),
+	SENSOR_REG_RANGE(OV5670_REG_CHIP_ID, OV5670_REG_CHIP_ID + 2),
+};
+
 /* Read registers up to 4 at a time */
 static int ov5670_read_reg(struct ov5670 *ov5670, u16 reg, unsigned int len,
 			   u32 *val)
@@ -1860,11 +2084,15 @@ static int ov5670_read_reg(struct ov5670 *ov5670, u16 reg, unsigned int len,
 	u8 *data_be_p;
 	__be32 data_be = 0;
 	__be16 reg_addr_be = cpu_to_be16(reg);
+	ktime_t start;
 	int ret;
 
 	if (len > 4)
 		return -EINVAL;
 
+	if (sensor_regcache_read_be(&ov5670->regcache, reg, len, val))
+		return 0;
+
 	data_be_p = (u8 *)&data_be;
 	/* Write register address */
 	msgs[0].addr = client->addr;
@@ -1878,11 +2106,16 @@ static int ov5670_read_reg(struct ov5670 *ov5670, u16 reg, unsigned int len,
 	msgs[1].len = len;
 	msgs[1].buf = &data_be_p[4 - len];
 
+	start = ktime_get();
 	ret = i2c_transfer(client->adapter, msgs, ARRAY_SIZE(msgs));
-	if (ret != ARRAY_SIZE(msgs))
-		return -EIO;
+	ret = ret == ARRAY_SIZE(msgs) ? 0 : -EIO;
+	sensor_stats_xfer(&ov5670->stats, SENSOR_STATS_READ, reg, len, start,
+			  ret);
+	if (ret)
+		return ret;
 
 	*val = be32_to_cpu(data_be);
+	sensor_regcache_write_be(&ov5670->regcache, reg, len, *val);
 
 	return 0;
 }
@@ -1892,11 +2125,13 @@ static int ov5670_write_reg(struct ov5670 *ov5670, u16 reg, unsigned int len,
 			    u32 val)
 {
 	struct i2c_client *client = v4l2_get_subdevdata(&ov5670->sd);
+	ktime_t start;
 	int buf_i;
 	int val_i;
 	u8 buf[6];
 	u8 *val_p;
 	__be32 tmp;
+	int ret;
 
 	if (len > 4)
 		return -EINVAL;
@@ -1912,8 +2147,18 @@ static int ov5670_write_reg(struct ov5670 *ov5670, u16 reg, unsigned int len,
 	while (val_i < 4)
 		buf[buf_i++] = val_p[val_i++];
 
-	if (i2c_master_send(client, buf, len + 2) != len + 2)
-		return -EIO;
+	start = ktime_get();
+	ret = i2c_master_send(client, buf, len + 2) == len + 2 ? 0 : -EIO;
+	sensor_stats_xfer(&ov5670->stats, SENSOR_STATS_WRITE, reg, len, start,
+			  ret);
+	if (ret)
+		return ret;
+
+	/* A software reset brings every register back to its default */
+	if (reg == OV5670_REG_SOFTWARE_RST && (val & OV5670_SOFTWARE_RST))
+		sensor_regcache_invalidate(&ov5670->regcache);
+	else
+		sensor_regcache_write_be(&ov5670->regcache, reg, len, val);
 
 	return 0;
 }
@@ -1944,9 +2189,95 @@ static int ov5670_write_regs(struct ov5670 *ov5670,
 static int ov5670_write_reg_list(struct ov5670 *ov5670,
 				 const struct ov5670_reg_list *r_list)
 {
+	struct i2c_client *client = v4l2_get_subdevdata(&ov5670->sd);
+
+	if (r_list->packed.data)
+		return sensor_burst_write(client, &r_list->packed,
+					  &ov5670->regcache, &ov5670->stats);
+
 	return ov5670_write_regs(ov5670, r_list->regs, r_list->num_of_regs);
 }
 
+/* Write @len consecutive 8-bit registers starting at @reg in one message */
+static int ov5670_write_burst(struct ov5670 *ov5670, u16 reg, const u8 *vals,
+			      unsigned int len)
+{
+	struct i2c_client *client = v4l2_get_subdevdata(&ov5670->sd);
+	u8 buf[OV5670_REG_BURST_MAX + 2];
+	ktime_t start;
+	int ret;
+
+	if (len > OV5670_REG_BURST_MAX)
+		return -EINVAL;
+
+	buf[0] = reg >> 8;
+	buf[1] = reg & 0xff;
+	memcpy(&buf[2], vals, len);
+
+	start = ktime_get();
+	ret = i2c_master_send(client, buf, len + 2) == len + 2 ? 0 : -EIO;
+	sensor_stats_xfer(&ov5670->stats, SENSOR_STATS_TABLE, reg, len, start,
+			  ret);
+	if (ret)
+		return ret;
+
+	sensor_regcache_write_burst(&ov5670->regcache, reg, vals, len);
+
+	return 0;
+}
+
+/*
+ * Write only the registers of a list whose value differs from what the
+ * register cache says the sensor already holds. Registers that are not in
+ * the cache are written as well. The list order is kept, and runs of
+ * consecutive addresses are sent as a single burst.
+ */
+static int ov5670_write_reg_list_delta(struct ov5670 *ov5670,
+				       const struct ov5670_reg_list *r_list)
+{
+	struct i2c_client *client = v4l2_get_subdevdata(&ov5670->sd);
+	const struct ov5670_reg *regs = r_list->regs;
+	u8 vals[OV5670_REG_BURST_MAX];
+	unsigned int i, n = 0;
+	u16 start = 0;
+	u8 cur;
+	int ret;
+
+	for (i = 0; i < r_list->num_of_regs; i++) {
+		if (sensor_regcache_read(&ov5670->regcache, regs[i].address,
+					 &cur) && cur == regs[i].val)
+			continue;
+
+		if (n && (start + n != regs[i].address ||
+			  n == OV5670_REG_BURST_MAX)) {
+			ret = ov5670_write_burst(ov5670, start, vals, n);
+			if (ret)
+				goto err;
+			n = 0;
+		}
+
+		if (!n)
+			start = regs[i].address;
+		vals[n++] = regs[i].val;
+	}
+
+	if (!n)
+		return 0;
+
+	ret = ov5670_write_burst(ov5670, start, vals, n);
+	if (ret)
+		goto err;
+
+	return 0;
+
+err:
+	dev_err_ratelimited(&client->dev,
+			    "Failed to write regs from 0x%4.4x. error = %d\n",
+			    start, ret);
+
+	return ret;
+}
+
 /* Open sub-device */
 static int ov5670_open(struct v4l2_subdev *sd, struct v4l2_subdev_fh *fh)
 {
@@ -1962,7 +2293,8 @@ static int ov5670_open(struct v4l2_subdev *sd, struct v4l2_subdev_fh *fh)
 	try_fmt->code = MEDIA_BUS_FMT_SGRBG10_1X10;
 	try_fmt->field = V4L2_FIELD_NONE;
 
-	/* No crop or compose */
+	/* No compose */
+	*v4l2_subdev_get_try_crop(sd, fh->pad, 0) = ov5670->crop;
 	mutex_unlock(&ov5670->mutex);
 
 	return 0;
@@ -1988,7 +2320,7 @@ static int ov5670_update_digital_gain(struct ov5670 *ov5670, u32 d_gain)
 
 static int ov5670_enable_test_pattern(struct ov5670 *ov5670, u32 pattern)
 {
-	u32 val;
+	u32 val, old;
 	int ret;
 
 	/* Set the bayer order that we support */
@@ -1997,15 +2329,19 @@ static int ov5670_enable_test_pattern(struct ov5670 *ov5670, u32 pattern)
 	if (ret)
 		return ret;
 
+	/* Answered from the register cache once the mode has been written */
 	ret = ov5670_read_reg(ov5670, OV5670_REG_TEST_PATTERN,
-			      OV5670_REG_VALUE_08BIT, &val);
+			      OV5670_REG_VALUE_08BIT, &old);
 	if (ret)
 		return ret;
 
 	if (pattern)
-		val |= OV5670_TEST_PATTERN_ENABLE;
+		val = old | OV5670_TEST_PATTERN_ENABLE;
 	else
-		val &= ~OV5670_TEST_PATTERN_ENABLE;
+		val = old & ~OV5670_TEST_PATTERN_ENABLE;
+
+	if (val == old)
+		return 0;
 
 	return ov5670_write_reg(ov5670, OV5670_REG_TEST_PATTERN,
 				OV5670_REG_VALUE_08BIT, val);
@@ -2072,81 +2408,41 @@ static const struct v4l2_ctrl_ops ov5670_ctrl_ops = {
 	.s_ctrl = ov5670_set_ctrl,
 };
 
-/* Get GPIOs defined in dep_dev _CRS */
-static int gpio_crs_get(struct ov5670 *sensor, struct device *dep_dev)
-{
-	sensor->xshutdn = devm_gpiod_get_index(dep_dev, NULL, 0, GPIOD_ASIS);
-	if (IS_ERR(sensor->xshutdn)) {
-		dev_err(dep_dev, "Couldn't get GPIO XSHUTDN\n");
-		return -EINVAL;
-	}
-
-	sensor->pwdnb = devm_gpiod_get_index(dep_dev, NULL, 1, GPIOD_ASIS);
-	if (IS_ERR(sensor->pwdnb)) {
-		dev_err(dep_dev, "Couldn't get GPIO PWDNB\n");
-		return -EINVAL;
-	}
-
-	sensor->led_gpio = devm_gpiod_get_index(dep_dev, NULL, 2, GPIOD_ASIS);
-	if (IS_ERR(sensor->led_gpio))
-		dev_info(dep_dev,
-			 "Couldn't get GPIO LED. Maybe not exist, continue anyway.\n");
-
-	return 0;
-}
-
-/* Put GPIOs defined in dep_dev _CRS */
-static void gpio_crs_put(struct ov5670 *sensor)
-{
-	gpiod_put(sensor->xshutdn);
-	gpiod_put(sensor->pwdnb);
-	if (!IS_ERR(sensor->led_gpio))
-		gpiod_put(sensor->led_gpio);
-}
-
-/* Control GPIOs defined in dep_dev _CRS */
-static int gpio_crs_ctrl(struct v4l2_subdev *sd, bool flag)
-{
-	struct ov5670 *sensor = to_ov5670(sd);
-
-	gpiod_set_value_cansleep(sensor->xshutdn, flag);
-	gpiod_set_value_cansleep(sensor->pwdnb, flag);
-	if (!IS_ERR(sensor->led_gpio))
-		gpiod_set_value_cansleep(sensor->led_gpio, flag);
-
-	return 0;
-}
-
 static int __power_down(struct v4l2_subdev *sd)
 {
-	int ret = 0;
+	struct ov5670 *ov5670 = to_ov5670(sd);
 
-	ret = gpio_crs_ctrl(sd, false);
+	int3472_dep_set_power(ov5670->dep, false);
+	sensor_stats_power(&ov5670->stats, false);
+	sensor_regcache_invalidate(&ov5670->regcache);
+	ov5670->regs_programmed = false;
 
-	return ret;
+	return 0;
 }
 
 static int __power_up(struct v4l2_subdev *sd)
 {
+	struct ov5670 *ov5670 = to_ov5670(sd);
 	struct i2c_client *client = v4l2_get_subdevdata(sd);
+	ktime_t start = ktime_get();
 	int ret;
 
-	ret = gpio_crs_ctrl(sd, true);
-	if (ret)
-		goto fail_power;
-
-	/* Add some delay (10~11ms).
-	 * This is required or identify_module() will fail.
-	 */
-	usleep_range(10000, 11000);
+	int3472_dep_set_power(ov5670->dep, true);
 
-	return 0;
+	/* Wait until the sensor answers, or identify_module() will fail */
+	ret = sensor_settle_wait(client, OV5670_REG_CHIP_ID + 1,
+				 (OV5670_CHIP_ID >> 8) & 0xff,
+				 OV5670_SETTLE_TIMEOUT_US, &ov5670->settle,
+				 &ov5670->stats);
+	if (ret) {
+		int3472_dep_set_power(ov5670->dep, false);
+		return ret;
+	}
 
-fail_power:
-	gpio_crs_ctrl(sd, false);
-	dev_err(&client->dev, "sensor power-up failed\n");
+	sensor_stats_power(&ov5670->stats, true);
+	sensor_stats_phase(&ov5670->stats, SENSOR_STATS_POWER_ON, start);
 
-	return ret;
+	return 0;
 }
 
 static int ov5670_s_power(struct v4l2_subdev *sd, int on)
@@ -2179,16 +2475,17 @@ static int ov5670_init_controls(struct ov5670 *ov5670)
 	ov5670->link_freq = v4l2_ctrl_new_int_menu(ctrl_hdlr,
 						   &ov5670_ctrl_ops,
 						   V4L2_CID_LINK_FREQ,
-						   0, 0, link_freq_menu_items);
+						   ARRAY_SIZE(link_freq_menu_items) - 1,
+						   ov5670->link_freq_index,
+						   link_freq_menu_items);
 	if (ov5670->link_freq)
 		ov5670->link_freq->flags |= V4L2_CTRL_FLAG_READ_ONLY;
 
 	/* By default, V4L2_CID_PIXEL_RATE is read only */
 	ov5670->pixel_rate = v4l2_ctrl_new_std(ctrl_hdlr, &ov5670_ctrl_ops,
 					       V4L2_CID_PIXEL_RATE, 0,
-					       link_freq_configs[0].pixel_rate,
-					       1,
-					       link_freq_configs[0].pixel_rate);
+					       OV5670_PIXEL_RATE, 1,
+					       OV5670_PIXEL_RATE);
 
 	vblank_max = OV5670_VTS_MAX - ov5670->cur_mode->height;
 	vblank_def = ov5670->cur_mode->vts_def - ov5670->cur_mode->height;
@@ -2265,22 +2562,76 @@ static int ov5670_enum_mbus_code(struct v4l2_subdev *sd,
 	return 0;
 }
 
+/* First entry of supported_modes with the size of entry i */
+static bool ov5670_is_first_of_size(unsigned int i)
+{
+	unsigned int j;
+
+	for (j = 0; j < i; j++)
+		if (supported_modes[j].width == supported_modes[i].width &&
+		    supported_modes[j].height == supported_modes[i].height)
+			return false;
+
+	return true;
+}
+
 static int ov5670_enum_frame_size(struct v4l2_subdev *sd,
 				  struct v4l2_subdev_pad_config *cfg,
 				  struct v4l2_subdev_frame_size_enum *fse)
 {
-	if (fse->index >= ARRAY_SIZE(supported_modes))
-		return -EINVAL;
+	unsigned int i, index = 0;
 
 	if (fse->code != MEDIA_BUS_FMT_SGRBG10_1X10)
 		return -EINVAL;
 
-	fse->min_width = supported_modes[fse->index].width;
-	fse->max_width = fse->min_width;
-	fse->min_height = supported_modes[fse->index].height;
-	fse->max_height = fse->min_height;
+	for (i = 0; i < ARRAY_SIZE(supported_modes); i++) {
+		if (!ov5670_is_first_of_size(i) || index++ != fse->index)
+			continue;
+
+		fse->min_width = supported_modes[i].width;
+		fse->max_width = fse->min_width;
+		fse->min_height = supported_modes[i].height;
+		fse->max_height = fse->min_height;
 
-	return 0;
+		return 0;
+	}
+
+	return -EINVAL;
+}
+
+/* Frame interval of a mode with a frame length of vts lines */
+static void ov5670_mode_interval(u32 vts, struct v4l2_fract *interval)
+{
+	u32 num = OV5670_FIXED_PPL * vts;
+	u32 den = OV5670_PIXEL_RATE;
+	unsigned long div = gcd(num, den);
+
+	interval->numerator = num / div;
+	interval->denominator = den / div;
+}
+
+static int ov5670_enum_frame_interval(struct v4l2_subdev *sd,
+				      struct v4l2_subdev_pad_config *cfg,
+				      struct v4l2_subdev_frame_interval_enum *fie)
+{
+	const struct ov5670_mode *mode;
+	unsigned int i, index = 0;
+
+	if (fie->code != MEDIA_BUS_FMT_SGRBG10_1X10)
+		return -EINVAL;
+
+	for (i = 0; i < ARRAY_SIZE(supported_modes); i++) {
+		mode = &supported_modes[i];
+		if (mode->width != fie->width || mode->height != fie->height ||
+		    index++ != fie->index)
+			continue;
+
+		ov5670_mode_interval(mode->vts_def, &fie->interval);
+
+		return 0;
+	}
+
+	return -EINVAL;
 }
 
 static void ov5670_update_pad_format(const struct ov5670_mode *mode,
@@ -2319,14 +2670,57 @@ static int ov5670_get_pad_format(struct v4l2_subdev *sd,
 	return ret;
 }
 
+/* Update the blanking limits of a new mode and set FPS to default */
+static void ov5670_update_blanking(struct ov5670 *ov5670)
+{
+	const struct ov5670_mode *mode = ov5670->cur_mode;
+	s32 vblank_def = mode->vts_def - mode->height;
+	s32 h_blank = OV5670_FIXED_PPL - mode->width;
+
+	__v4l2_ctrl_modify_range(ov5670->vblank, mode->vts_min - mode->height,
+				 OV5670_VTS_MAX - mode->height, 1, vblank_def);
+	__v4l2_ctrl_s_ctrl(ov5670->vblank, vblank_def);
+	__v4l2_ctrl_modify_range(ov5670->hblank, h_blank, h_blank, 1, h_blank);
+}
+
+/*
+ * The lowest link frequency the firmware allows that carries a line of the
+ * mode within the line time, with OV5670_LINK_HEADROOM_PCT of the link,
+ * the highest allowed one if none does.
+ */
+static unsigned int ov5670_pick_link_freq(struct ov5670 *ov5670,
+					  const struct ov5670_mode *mode)
+{
+	u64 needed = div_u64((u64)mode->width * OV5670_BITS_PER_SAMPLE *
+			     OV5670_PIXEL_RATE, OV5670_FIXED_PPL);
+	unsigned int i, best = __ffs(ov5670->link_freq_mask);
+
+	for_each_set_bit(i, &ov5670->link_freq_mask,
+			 ARRAY_SIZE(link_freq_menu_items)) {
+		if (div_u64(link_freq_menu_items[i] * 2 * OV5670_DATA_LANES *
+			    OV5670_LINK_HEADROOM_PCT, 100) < needed)
+			break;
+		best = i;
+	}
+
+	return best;
+}
+
+static void ov5670_set_mode(struct ov5670 *ov5670,
+			    const struct ov5670_mode *mode)
+{
+	ov5670->cur_mode = mode;
+	ov5670->link_freq_index = ov5670_pick_link_freq(ov5670, mode);
+	__v4l2_ctrl_s_ctrl(ov5670->link_freq, ov5670->link_freq_index);
+	ov5670_update_blanking(ov5670);
+}
+
 static int ov5670_set_pad_format(struct v4l2_subdev *sd,
 				 struct v4l2_subdev_pad_config *cfg,
 				 struct v4l2_subdev_format *fmt)
 {
 	struct ov5670 *ov5670 = to_ov5670(sd);
 	const struct ov5670_mode *mode;
-	s32 vblank_def;
-	s32 h_blank;
 
 	mutex_lock(&ov5670->mutex);
 
@@ -2337,33 +2731,172 @@ static int ov5670_set_pad_format(struct v4l2_subdev *sd,
 				      width, height,
 				      fmt->format.width, fmt->format.height);
 	ov5670_update_pad_format(mode, fmt);
+	/* The modes read the whole array */
 	if (fmt->which == V4L2_SUBDEV_FORMAT_TRY) {
 		*v4l2_subdev_get_try_format(sd, cfg, fmt->pad) = fmt->format;
+		*v4l2_subdev_get_try_crop(sd, cfg, fmt->pad) =
+			ov5670_default_crop;
 	} else {
-		ov5670->cur_mode = mode;
-		__v4l2_ctrl_s_ctrl(ov5670->link_freq, mode->link_freq_index);
-		__v4l2_ctrl_s_ctrl_int64(
-			ov5670->pixel_rate,
-			link_freq_configs[mode->link_freq_index].pixel_rate);
-		/* Update limits and set FPS to default */
-		vblank_def = ov5670->cur_mode->vts_def -
-			     ov5670->cur_mode->height;
-		__v4l2_ctrl_modify_range(
-			ov5670->vblank,
-			ov5670->cur_mode->vts_min - ov5670->cur_mode->height,
-			OV5670_VTS_MAX - ov5670->cur_mode->height, 1,
-			vblank_def);
-		__v4l2_ctrl_s_ctrl(ov5670->vblank, vblank_def);
-		h_blank = OV5670_FIXED_PPL - ov5670->cur_mode->width;
-		__v4l2_ctrl_modify_range(ov5670->hblank, h_blank, h_blank, 1,
-					 h_blank);
+		ov5670->crop = ov5670_default_crop;
+		ov5670_set_mode(ov5670, mode);
+	}
+
+	mutex_unlock(&ov5670->mutex);
+
+	return 0;
+}
+
+static int ov5670_get_selection(struct v4l2_subdev *sd,
+				struct v4l2_subdev_pad_config *cfg,
+				struct v4l2_subdev_selection *sel)
+{
+	struct ov5670 *ov5670 = to_ov5670(sd);
+
+	switch (sel->target) {
+	case V4L2_SEL_TGT_CROP:
+		mutex_lock(&ov5670->mutex);
+		if (sel->which == V4L2_SUBDEV_FORMAT_TRY)
+			sel->r = *v4l2_subdev_get_try_crop(sd, cfg, sel->pad);
+		else
+			sel->r = ov5670->crop;
+		mutex_unlock(&ov5670->mutex);
+		return 0;
+	case V4L2_SEL_TGT_NATIVE_SIZE:
+		sel->r.left = 0;
+		sel->r.top = 0;
+		sel->r.width = OV5670_NATIVE_WIDTH;
+		sel->r.height = OV5670_NATIVE_HEIGHT;
+		return 0;
+	case V4L2_SEL_TGT_CROP_DEFAULT:
+	case V4L2_SEL_TGT_CROP_BOUNDS:
+		sel->r = ov5670_default_crop;
+		return 0;
+	default:
+		return -EINVAL;
 	}
+}
+
+/*
+ * The crop is read out in full size and sent as is, so it also sets the
+ * format. The frame can then be as short as the crop height plus the
+ * minimum blanking, VBLANK is reset to the 30 fps default.
+ */
+static int ov5670_set_selection(struct v4l2_subdev *sd,
+				struct v4l2_subdev_pad_config *cfg,
+				struct v4l2_subdev_selection *sel)
+{
+	struct ov5670 *ov5670 = to_ov5670(sd);
+	const struct ov5670_mode *full = &supported_modes[0];
+	struct v4l2_mbus_framefmt *try_fmt;
+	struct v4l2_rect *r = &sel->r;
+	int ret = 0;
+
+	if (sel->target != V4L2_SEL_TGT_CROP)
+		return -EINVAL;
+
+	/* Even sizes and offsets keep the Bayer order */
+	r->width = clamp_t(u32, ALIGN(r->width, 2), OV5670_CROP_MIN_WIDTH,
+			   OV5670_PIXEL_ARRAY_WIDTH);
+	r->height = clamp_t(u32, ALIGN(r->height, 2), OV5670_CROP_MIN_HEIGHT,
+			    OV5670_PIXEL_ARRAY_HEIGHT);
+	r->left = ALIGN_DOWN(clamp_t(s32, r->left, OV5670_PIXEL_ARRAY_LEFT,
+				     OV5670_PIXEL_ARRAY_LEFT +
+				     OV5670_PIXEL_ARRAY_WIDTH - r->width), 2);
+	r->top = ALIGN_DOWN(clamp_t(s32, r->top, OV5670_PIXEL_ARRAY_TOP,
+				    OV5670_PIXEL_ARRAY_TOP +
+				    OV5670_PIXEL_ARRAY_HEIGHT - r->height), 2);
+
+	mutex_lock(&ov5670->mutex);
 
+	if (sel->which == V4L2_SUBDEV_FORMAT_TRY) {
+		*v4l2_subdev_get_try_crop(sd, cfg, sel->pad) = *r;
+		try_fmt = v4l2_subdev_get_try_format(sd, cfg, sel->pad);
+		try_fmt->width = r->width;
+		try_fmt->height = r->height;
+		goto out;
+	}
+
+	if (ov5670->streaming) {
+		ret = -EBUSY;
+		goto out;
+	}
+
+	ov5670->crop = *r;
+	ov5670->crop_mode = *full;
+	ov5670->crop_mode.width = r->width;
+	ov5670->crop_mode.height = r->height;
+	ov5670->crop_mode.vts_min = r->height + OV5670_VBLANK_MIN;
+	ov5670_set_mode(ov5670, &ov5670->crop_mode);
+
+out:
+	mutex_unlock(&ov5670->mutex);
+
+	return ret;
+}
+
+static int ov5670_g_frame_interval(struct v4l2_subdev *sd,
+				   struct v4l2_subdev_frame_interval *fi)
+{
+	struct ov5670 *ov5670 = to_ov5670(sd);
+
+	mutex_lock(&ov5670->mutex);
+	ov5670_mode_interval(ov5670->cur_mode->height + ov5670->vblank->val,
+			     &fi->interval);
 	mutex_unlock(&ov5670->mutex);
 
 	return 0;
 }
 
+/*
+ * Pick the entry of the current size with the nearest default frame
+ * interval, which resets VBLANK to its default. Finer steps are left to
+ * VBLANK, as is the frame rate of a crop.
+ */
+static int ov5670_s_frame_interval(struct v4l2_subdev *sd,
+				   struct v4l2_subdev_frame_interval *fi)
+{
+	struct ov5670 *ov5670 = to_ov5670(sd);
+	const struct ov5670_mode *cur, *mode, *best;
+	u64 vts = 0;
+	unsigned int i;
+	int ret = 0;
+
+	mutex_lock(&ov5670->mutex);
+
+	if (ov5670->streaming) {
+		ret = -EBUSY;
+		goto out;
+	}
+
+	cur = ov5670->cur_mode;
+	best = cur;
+	/* interval = PPL * VTS / pixel rate, as fast as possible for 0 */
+	if (fi->interval.numerator && fi->interval.denominator)
+		vts = div_u64((u64)OV5670_PIXEL_RATE * fi->interval.numerator,
+			      (u64)OV5670_FIXED_PPL * fi->interval.denominator);
+
+	for (i = 0; cur != &ov5670->crop_mode &&
+		    i < ARRAY_SIZE(supported_modes); i++) {
+		mode = &supported_modes[i];
+		if (mode->width != cur->width || mode->height != cur->height)
+			continue;
+
+		if (abs((s64)mode->vts_def - (s64)vts) <
+		    abs((s64)best->vts_def - (s64)vts))
+			best = mode;
+	}
+
+	if (best != cur)
+		ov5670_set_mode(ov5670, best);
+
+out:
+	ov5670_mode_interval(ov5670->cur_mode->height + ov5670->vblank->val,
+			     &fi->interval);
+	mutex_unlock(&ov5670->mutex);
+
+	return ret;
+}
+
 static int ov5670_get_skip_frames(struct v4l2_subdev *sd, u32 *frames)
 {
 	*frames = OV5670_NUM_OF_SKIP_FRAMES;
@@ -2371,11 +2904,36 @@ static int ov5670_get_skip_frames(struct v4l2_subdev *sd, u32 *frames)
 	return 0;
 }
 
+/* Window and output size of the crop, over those of the full size mode */
+static int ov5670_write_crop(struct ov5670 *ov5670)
+{
+	const struct v4l2_rect *crop = &ov5670->crop;
+	u16 win[] = {
+		crop->left - OV5670_WIN_PAD_X,
+		crop->top - OV5670_WIN_PAD_TOP,
+		crop->left + crop->width + OV5670_WIN_PAD_X - 1,
+		crop->top + crop->height + OV5670_WIN_PAD_BOTTOM - 1,
+		crop->width,
+		crop->height,
+	};
+	u8 vals[2 * ARRAY_SIZE(win)];
+	unsigned int i;
+
+	for (i = 0; i < ARRAY_SIZE(win); i++) {
+		vals[2 * i] = win[i] >> 8;
+		vals[2 * i + 1] = win[i] & 0xff;
+	}
+
+	return ov5670_write_burst(ov5670, OV5670_REG_X_ADDR_START, vals,
+				  sizeof(vals));
+}
+
 /* Prepare streaming by writing default values and customized values */
-static int ov5670_start_streaming(struct ov5670 *ov5670)
+static int ov5670_load_mode_full(struct ov5670 *ov5670)
 {
 	struct i2c_client *client = v4l2_get_subdevdata(&ov5670->sd);
 	const struct ov5670_reg_list *reg_list;
+	ktime_t start = ktime_get();
 	int link_freq_index;
 	int ret;
 
@@ -2389,33 +2947,100 @@ static int ov5670_start_streaming(struct ov5670 *ov5670)
 	}
 
 	/* Setup PLL */
-	link_freq_index = ov5670->cur_mode->link_freq_index;
+	link_freq_index = ov5670->link_freq_index;
 	reg_list = &link_freq_configs[link_freq_index].reg_list;
 	ret = ov5670_write_reg_list(ov5670, reg_list);
 	if (ret) {
 		dev_err(&client->dev, "%s failed to set plls\n", __func__);
 		return ret;
 	}
+	sensor_stats_phase(&ov5670->stats, SENSOR_STATS_GLOBAL_REGS, start);
 
 	/* Apply default values of current mode */
+	start = ktime_get();
 	reg_list = &ov5670->cur_mode->reg_list;
 	ret = ov5670_write_reg_list(ov5670, reg_list);
 	if (ret) {
 		dev_err(&client->dev, "%s failed to set mode\n", __func__);
 		return ret;
 	}
+	sensor_stats_phase(&ov5670->stats, SENSOR_STATS_MODE_REGS, start);
+
+	return 0;
+}
+
+/*
+ * All the mode lists program the same set of registers, so when the sensor
+ * still holds a complete image from a previous mode, writing the registers
+ * that differ is enough to switch modes without a software reset.
+ */
+static int ov5670_load_mode_delta(struct ov5670 *ov5670)
+{
+	struct i2c_client *client = v4l2_get_subdevdata(&ov5670->sd);
+	const struct ov5670_reg_list *reg_list;
+	ktime_t start = ktime_get();
+	int link_freq_index;
+	int ret;
+
+	link_freq_index = ov5670->link_freq_index;
+	reg_list = &link_freq_configs[link_freq_index].reg_list;
+	ret = ov5670_write_reg_list_delta(ov5670, reg_list);
+	if (ret) {
+		dev_err(&client->dev, "%s failed to set plls\n", __func__);
+		return ret;
+	}
+	sensor_stats_phase(&ov5670->stats, SENSOR_STATS_GLOBAL_REGS, start);
+
+	start = ktime_get();
+	reg_list = &ov5670->cur_mode->reg_list;
+	ret = ov5670_write_reg_list_delta(ov5670, reg_list);
+	if (ret) {
+		dev_err(&client->dev, "%s failed to set mode\n", __func__);
+		return ret;
+	}
+	sensor_stats_phase(&ov5670->stats, SENSOR_STATS_MODE_REGS, start);
+
+	return 0;
+}
+
+static int ov5670_start_streaming(struct ov5670 *ov5670)
+{
+	struct i2c_client *client = v4l2_get_subdevdata(&ov5670->sd);
+	const struct ov5670_link_freq_config *link =
+				&link_freq_configs[ov5670->link_freq_index];
+	ktime_t start;
+	int ret;
 
+	if (ov5670->regs_programmed)
+		ret = ov5670_load_mode_delta(ov5670);
+	else
+		ret = ov5670_load_mode_full(ov5670);
+	if (!ret)
+		ret = ov5670_write_reg(ov5670, OV5670_REG_PCLK_PERIOD,
+				       OV5670_REG_VALUE_08BIT,
+				       link->pclk_period);
+	if (!ret && ov5670->cur_mode == &ov5670->crop_mode)
+		ret = ov5670_write_crop(ov5670);
+	/* On failure the sensor state is unknown, start over next time */
+	ov5670->regs_programmed = !ret;
+	if (ret)
+		return ret;
+
+	start = ktime_get();
 	ret = __v4l2_ctrl_handler_setup(ov5670->sd.ctrl_handler);
 	if (ret)
 		return ret;
+	sensor_stats_phase(&ov5670->stats, SENSOR_STATS_CTRL_SETUP, start);
 
 	/* Write stream on list */
+	start = ktime_get();
 	ret = ov5670_write_reg(ov5670, OV5670_REG_MODE_SELECT,
 			       OV5670_REG_VALUE_08BIT, OV5670_MODE_STREAMING);
 	if (ret) {
 		dev_err(&client->dev, "%s failed to set stream\n", __func__);
 		return ret;
 	}
+	sensor_stats_phase(&ov5670->stats, SENSOR_STATS_STREAM_ON, start);
 
 	return 0;
 }
@@ -2439,6 +3064,7 @@ static int ov5670_stop_streaming(struct ov5670 *ov5670)
 static int __ov5670_set_stream_no_rpm(struct v4l2_subdev *sd, int enable)
 {
 	struct ov5670 *ov5670 = to_ov5670(sd);
+	ktime_t start = ktime_get();
 	int ret = 0;
 
 	mutex_lock(&ov5670->mutex);
@@ -2455,6 +3081,9 @@ static int __ov5670_set_stream_no_rpm(struct v4l2_subdev *sd, int enable)
 		ret = ov5670_start_streaming(ov5670);
 		if (ret)
 			goto error;
+
+		sensor_stats_phase(&ov5670->stats, SENSOR_STATS_STREAM_START,
+				   start);
 	} else {
 		ret = ov5670_stop_streaming(ov5670);
 		__power_down(sd);
@@ -2477,6 +3106,7 @@ static int __ov5670_set_stream_rpm(struct v4l2_subdev *sd, int enable)
 {
 	struct ov5670 *ov5670 = to_ov5670(sd);
 	struct i2c_client *client = v4l2_get_subdevdata(sd);
+	ktime_t start = ktime_get();
 	int ret = 0;
 
 	mutex_lock(&ov5670->mutex);
@@ -2493,6 +3123,9 @@ static int __ov5670_set_stream_rpm(struct v4l2_subdev *sd, int enable)
 		ret = ov5670_start_streaming(ov5670);
 		if (ret)
 			goto error;
+
+		sensor_stats_phase(&ov5670->stats, SENSOR_STATS_STREAM_START,
+				   start);
 	} else {
 		ret = ov5670_stop_streaming(ov5670);
 		pm_runtime_put(&client->dev);
@@ -2537,6 +3170,10 @@ static int __maybe_unused ov5670_suspend(struct device *dev)
 	if (ov5670->streaming)
 		ov5670_stop_streaming(ov5670);
 
+	/* Power may be lost during system sleep */
+	sensor_regcache_invalidate(&ov5670->regcache);
+	ov5670->regs_programmed = false;
+
 	return 0;
 }
 
@@ -2583,6 +3220,8 @@ static int ov5670_identify_module(struct ov5670 *ov5670)
 }
 
 static const struct v4l2_subdev_video_ops ov5670_video_ops = {
+	.g_frame_interval = ov5670_g_frame_interval,
+	.s_frame_interval = ov5670_s_frame_interval,
 	.s_stream = ov5670_set_stream,
 };
 
@@ -2595,6 +3234,9 @@ static const struct v4l2_subdev_pad_ops ov5670_pad_ops = {
 	.get_fmt = ov5670_get_pad_format,
 	.set_fmt = ov5670_set_pad_format,
 	.enum_frame_size = ov5670_enum_frame_size,
+	.enum_frame_interval = ov5670_enum_frame_interval,
+	.get_selection = ov5670_get_selection,
+	.set_selection = ov5670_set_selection,
 };
 
 static const struct v4l2_subdev_sensor_ops ov5670_sensor_ops = {
@@ -2615,119 +3257,57 @@ static const struct v4l2_subdev_internal_ops ov5670_internal_ops = {
 	.open = ov5670_open,
 };
 
-/* Get acpi_device of dependent INT3472 device */
-static struct acpi_device *get_dep_adev(struct device *dev)
+/*
+ * Link frequencies of the endpoint, as the firmware or the cio2 bridge
+ * describes it. Without an endpoint or link-frequencies, all of them are
+ * allowed.
+ */
+static int ov5670_get_link_freqs(struct ov5670 *ov5670, struct device *dev)
 {
-	struct acpi_handle *dev_handle;
-	struct acpi_device *sensor_adev;
-	struct acpi_handle_list dep_devices;
-	struct acpi_device *dep_adev;
-	acpi_status status;
-	const char *dep_hid = "INT3472";
-	int i;
-
-	sensor_adev = acpi_dev_get_first_match_dev(OV5670_HID, NULL, -1);
-	if (!sensor_adev) {
-		dev_err(dev, "Couldn't get sensor ACPI device\n");
-		return ERR_PTR(-ENODEV);
-	}
-	dev_handle = sensor_adev->handle;
-	acpi_dev_put(sensor_adev);
-
-	if (!acpi_has_method(dev_handle, "_DEP")) {
-		dev_err(dev, "No _DEP entry found\n");
-		return ERR_PTR(-ENODEV);
-	}
-
-	status = acpi_evaluate_reference(dev_handle, "_DEP", NULL, &dep_devices);
-	if (ACPI_FAILURE(status)) {
-		dev_err(dev, "Failed to evaluate _DEP.\n");
-		return ERR_PTR(-ENODEV);
-	}
-
-	for (i = 0; i < dep_devices.count; i++) {
-		struct acpi_device_info *info;
-		int match;
-
-		status = acpi_get_object_info(dep_devices.handles[i], &info);
-		if (ACPI_FAILURE(status)) {
-			dev_dbg(dev,
-				"Error reading _DEP device info, continue next\n");
-			continue;
-		}
-
-		match = info->valid & ACPI_VALID_HID &&
-			!strcmp(info->hardware_id.string, dep_hid);
-
-		kfree(info);
-
-		if (!match)
-			continue;
-
-		if (acpi_bus_get_device(dep_devices.handles[i], &dep_adev)) {
-			dev_err(dev, "Error getting dependent ACPI device\n");
-			return ERR_PTR(-ENODEV);
-		}
-
-		/* found acpi_device of dependent device */
-		break;
-	}
+	struct v4l2_fwnode_endpoint bus_cfg = {
+		.bus_type = V4L2_MBUS_CSI2_DPHY
+	};
+	struct fwnode_handle *ep;
+	unsigned int i, j;
+	int ret;
 
-	if (!dep_adev) {
-		dev_err(dev, "Dependent ACPI device not found\n");
-		return ERR_PTR(-ENODEV);
-	}
+	ov5670->link_freq_mask = GENMASK(ARRAY_SIZE(link_freq_menu_items) - 1,
+					 0);
 
-	dev_info(dev, "Dependent ACPI device found: %s\n",
-		 dev_name(&dep_adev->dev));
+	ep = fwnode_graph_get_next_endpoint(dev_fwnode(dev), NULL);
+	if (!ep)
+		return 0;
 
-	return dep_adev;
-}
+	ret = v4l2_fwnode_endpoint_alloc_parse(ep, &bus_cfg);
+	fwnode_handle_put(ep);
+	if (ret)
+		return ret;
 
-/* Get dependent INT3472 device */
-static struct device *get_dep_dev(struct device *dev)
-{
-	struct acpi_device *dep_adev;
-	struct acpi_device_physical_node *dep_phys;
+	if (!bus_cfg.nr_of_link_frequencies)
+		goto out;
 
-	dep_adev = get_dep_adev(dev);
-	if (!dep_adev) {
-		dev_err(dev, "get_dep_adev() failed\n");
-		return ERR_PTR(-ENODEV);
-	}
+	ov5670->link_freq_mask = 0;
+	for (i = 0; i < ARRAY_SIZE(link_freq_menu_items); i++)
+		for (j = 0; j < bus_cfg.nr_of_link_frequencies; j++)
+			if (link_freq_menu_items[i] ==
+			    bus_cfg.link_frequencies[j])
+				ov5670->link_freq_mask |= BIT(i);
 
-	/*
-	 * HACK: We know that the PMIC is a "discrete" PMIC, an ACPI device
-	 * that just serves as a container to list system GPIOs.
-	 *
-	 * The ACPI device has no fwnode, nor does it have a platform device.
-	 * This prevents fetching GPIOs. It however seems to be backed by the
-	 * PCI root complex (pci0000:00/0000:00:00.0) as its physical device,
-	 * and that device has its fwnode set to \_SB.PCI0.DSC1. Whether this
-	 * is correct or not is unknown, let's just get the physical device and
-	 * move on for now.
-	 *
-	 * (@kitakar5525)This is observed on Microsoft Surface Go series
-	 * and Acer Switch Alpha 12.
-	 */
-	dep_phys = list_first_entry_or_null(&dep_adev->physical_node_list,
-					    struct acpi_device_physical_node,
-					    node);
-	if (!dep_phys) {
-		dev_info(dev,
-			 "Error getting physical node of dependent device\n");
-		return ERR_PTR(-ENODEV);
+	if (!ov5670->link_freq_mask) {
+		dev_err(dev, "no supported link frequency\n");
+		ret = -EINVAL;
 	}
 
-	dev_info(dev, "Dependent device found: %s\n", dev_name(dep_phys->dev));
+out:
+	v4l2_fwnode_endpoint_free(&bus_cfg);
 
-	return dep_phys->dev;
+	return ret;
 }
 
 static int ov5670_probe(struct i2c_client *client)
 {
 	struct ov5670 *ov5670;
-	struct device *dep_dev;
+	struct sensor_ssdb ssdb;
 	const char *err_msg;
 	int ret;
 
@@ -2741,38 +3321,58 @@ static int ov5670_probe(struct i2c_client *client)
 	/* Initialize subdev */
 	v4l2_i2c_subdev_init(&ov5670->sd, client, &ov5670_subdev_ops);
 
-	ov5670->dep_dev = get_dep_dev(&client->dev);
-	if (IS_ERR(ov5670->dep_dev)) {
-		ret = PTR_ERR(ov5670->dep_dev);
-		dev_err(&client->dev, "cannot get dep_dev: ret %d\n", ret);
-		return ret;
+	ret = sensor_regcache_init(&client->dev, &ov5670->regcache,
+				   OV5670_REGCACHE_MAX_REG,
+				   ov5670_volatile_regs,
+				   ARRAY_SIZE(ov5670_volatile_regs));
+	if (ret) {
+		err_msg = "sensor_regcache_init() error";
+		goto error_print;
+	}
+
+	if (!sensor_ssdb_read(&client->dev, &ssdb) &&
+	    ssdb.lanes_used != OV5670_DATA_LANES) {
+		ret = -EINVAL;
+		err_msg = "unsupported number of data lanes";
+		goto error_print;
 	}
-	dep_dev = ov5670->dep_dev;
 
-	ret = gpio_crs_get(ov5670, dep_dev);
+	ret = ov5670_get_link_freqs(ov5670, &client->dev);
 	if (ret) {
-		dev_err(dep_dev, "Failed to get _CRS GPIOs\n");
-		return ret;
+		err_msg = "ov5670_get_link_freqs() error";
+		goto error_print;
+	}
+
+	ov5670->dep = int3472_dep_get(&client->dev);
+	if (IS_ERR(ov5670->dep)) {
+		ret = PTR_ERR(ov5670->dep);
+		err_msg = "int3472_dep_get() error";
+		goto error_print;
 	}
 
+	sensor_stats_init(&ov5670->stats, &client->dev, &ov5670->settle);
+
 	ret = __power_up(&ov5670->sd);
 	if (ret) {
 		err_msg = "ov5670 power-up error";
 		__power_down(&ov5670->sd);
-		goto error_gpio_crs_put;
+		goto error_dep_put;
 	}
 
 	/* Check module identity */
 	ret = ov5670_identify_module(ov5670);
 	if (ret) {
 		err_msg = "ov5670_identify_module() error";
-		goto error_gpio_crs_put;
+		goto error_dep_put;
 	}
 
 	mutex_init(&ov5670->mutex);
 
 	/* Set default mode to max resolution */
 	ov5670->cur_mode = &supported_modes[0];
+	ov5670->link_freq_index = ov5670_pick_link_freq(ov5670,
+							 ov5670->cur_mode);
+	ov5670->crop = ov5670_default_crop;
 
 	ret = ov5670_init_controls(ov5670);
 	if (ret) {
@@ -2833,8 +3433,9 @@ error_handler_free:
 error_mutex_destroy:
 	mutex_destroy(&ov5670->mutex);
 
-error_gpio_crs_put:
-	gpio_crs_put(ov5670);
+error_dep_put:
+	sensor_stats_exit(&ov5670->stats);
+	int3472_dep_put(ov5670->dep);
 
 error_print:
 	dev_err(&client->dev, "%s: %s %d\n", __func__, err_msg, ret);
@@ -2847,9 +3448,10 @@ static int ov5670_remove(struct i2c_client *client)
 	struct v4l2_subdev *sd = i2c_get_clientdata(client);
 	struct ov5670 *ov5670 = to_ov5670(sd);
 
-	gpio_crs_put(ov5670);
+	int3472_dep_put(ov5670->dep);
 
 	v4l2_async_unregister_subdev(sd);
+	sensor_stats_exit(&ov5670->stats);
 	media_entity_cleanup(&sd->entity);
 	v4l2_ctrl_handler_free(sd->ctrl_handler);
 	mutex_destroy(&ov5670->mutex);
@@ -2876,6 +3478,7 @@ static struct i2c_driver ov5670_i2c_driver = {
 	.driver = {
 		.name = "ov5670",
 		.pm = &ov5670_pm_ops,
+		.probe_type = PROBE_PREFER_ASYNCHRONOUS,
 		.acpi_match_table = ACPI_PTR(ov5670_acpi_ids),
 	},
 	.probe_new = ov5670_probe,
@@ -0,0 +1,1368 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+/*
+ * Generated by misc/pack_sensor_regs/pack_sensor_regs.py from ov5670.c.
+ * Do not edit, regenerate after changing the register tables.
+ */
+
+#ifndef __OV5670_REGS_PACKED_H__
+#define __OV5670_REGS_PACKED_H__
+
+#include "sensor_burst.h"
+
+/* 15 entries, 4 messages */
+static const u8 mipi_data_rate_840mbps_packed[] = {
+	9, 0x03, 0x00,
+		0x04, 0x00, 0x84, 0x00, 0x03, 0x01, 0x01,
+	8, 0x03, 0x0a,
+		0x00, 0x00, 0x00, 0x26, 0x00, 0x06,
+	3, 0x03, 0x12,
+		0x01,
+	3, 0x30, 0x31,
+		0x0a,
+};
+
+/* 15 entries, 4 messages */
+static const u8 mipi_data_rate_422mbps_packed[] = {
+	9, 0x03, 0x00,
+		0x04, 0x00, 0x84, 0x01, 0x03, 0x01, 0x01,
+	8, 0x03, 0x0a,
+		0x00, 0x00, 0x00, 0x26, 0x00, 0x06,
+	3, 0x03, 0x12,
+		0x01,
+	3, 0x30, 0x31,
+		0x0a,
+};
+
+/* 15 entries, 4 messages */
+static const u8 mipi_data_rate_211mbps_packed[] = {
+	9, 0x03, 0x00,
+		0x04, 0x00, 0x84, 0x03, 0x03, 0x01, 0x01,
+	8, 0x03, 0x0a,
+		0x00, 0x00, 0x00, 0x26, 0x00, 0x06,
+	3, 0x03, 0x12,
+		0x01,
+	3, 0x30, 0x31,
+		0x0a,
+};
+
+/* 263 entries, 105 messages */
+static const u8 mode_2592x1944_regs_packed[] = {
+	3, 0x30, 0x00,
+		0x00,
+	3, 0x30, 0x02,
+		0x21,
+	3, 0x30, 0x05,
+		0xf0,
+	3, 0x30, 0x07,
+		0x00,
+	3, 0x30, 0x15,
+		0x0f,
+	3, 0x30, 0x18,
+		0x32,
+	7, 0x30, 0x1a,
+		0xf0, 0xf0, 0xf0, 0xf0, 0xf0,
+	4, 0x30, 0x30,
+		0x00, 0x0a,
+	3, 0x30, 0x3c,
+		0xff,
+	3, 0x30, 0x3e,
+		0xff,
+	5, 0x30, 0x40,
+		0xf0, 0x00, 0xf0,
+	3, 0x31, 0x06,
+		0x11,
+	8, 0x35, 0x00,
+		0x00, 0x80, 0x00, 0x00, 0x03, 0x83,
+	4, 0x35, 0x08,
+		0x04, 0x00,
+	7, 0x35, 0x0e,
+		0x04, 0x00, 0x00, 0x02, 0x00,
+	3, 0x36, 0x01,
+		0xc8,
+	3, 0x36, 0x10,
+		0x88,
+	3, 0x36, 0x12,
+		0x48,
+	4, 0x36, 0x14,
+		0x5b, 0x96,
+	3, 0x36, 0x18,
+		0x2a,
+	5, 0x36, 0x21,
+		0xd0, 0x00, 0x00,
+	6, 0x36, 0x33,
+		0x13, 0x13, 0x13, 0x13,
+	4, 0x36, 0x45,
+		0x13, 0x82,
+	3, 0x36, 0x50,
+		0x00,
+	3, 0x36, 0x52,
+		0xff,
+	4, 0x36, 0x55,
+		0x20, 0xff,
+	3, 0x36, 0x5a,
+		0xff,
+	3, 0x36, 0x5e,
+		0xff,
+	3, 0x36, 0x68,
+		0x00,
+	3, 0x36, 0x6a,
+		0x07,
+	5, 0x36, 0x6d,
+		0x00, 0x10, 0x80,
+	14, 0x37, 0x00,
+		0x28, 0x10, 0x3a, 0x19, 0x10, 0x00, 0x66, 0x08,
+		0x34, 0x40, 0x01, 0x1b,
+	3, 0x37, 0x14,
+		0x24,
+	3, 0x37, 0x1a,
+		0x3e,
+	4, 0x37, 0x33,
+		0x00, 0x40,
+	5, 0x37, 0x3a,
+		0x05, 0x06, 0x0a,
+	3, 0x37, 0x3f,
+		0xa0,
+	3, 0x37, 0x55,
+		0x00,
+	3, 0x37, 0x58,
+		0x00,
+	3, 0x37, 0x5b,
+		0x0e,
+	3, 0x37, 0x66,
+		0x5f,
+	4, 0x37, 0x68,
+		0x00, 0x22,
+	4, 0x37, 0x73,
+		0x08, 0x1f,
+	3, 0x37, 0x76,
+		0x06,
+	4, 0x37, 0xa0,
+		0x88, 0x5c,
+	4, 0x37, 0xa7,
+		0x88, 0x70,
+	4, 0x37, 0xaa,
+		0x88, 0x48,
+	3, 0x37, 0xb3,
+		0x66,
+	3, 0x37, 0xc2,
+		0x04,
+	3, 0x37, 0xc5,
+		0x00,
+	3, 0x37, 0xc8,
+		0x00,
+	18, 0x38, 0x00,
+		0x00, 0x0c, 0x00, 0x04, 0x0a, 0x33, 0x07, 0xa3,
+		0x0a, 0x20, 0x07, 0x98, 0x06, 0x90, 0x08, 0x08,
+	3, 0x38, 0x11,
+		0x04,
+	9, 0x38, 0x13,
+		0x02, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00,
+	5, 0x38, 0x20,
+		0x84, 0x46, 0x48,
+	4, 0x38, 0x26,
+		0x00, 0x08,
+	4, 0x38, 0x2a,
+		0x01, 0x01,
+	3, 0x38, 0x30,
+		0x08,
+	5, 0x38, 0x36,
+		0x02, 0x00, 0x10,
+	3, 0x38, 0x41,
+		0xff,
+	3, 0x38, 0x46,
+		0x48,
+	5, 0x38, 0x61,
+		0x00, 0x04, 0x06,
+	4, 0x3a, 0x11,
+		0x01, 0x78,
+	3, 0x3b, 0x00,
+		0x00,
+	6, 0x3b, 0x02,
+		0x00, 0x00, 0x00, 0x00,
+	10, 0x3c, 0x00,
+		0x89, 0xab, 0x01, 0x00, 0x00, 0x03, 0x00, 0x05,
+	6, 0x3c, 0x0c,
+		0x00, 0x00, 0x00, 0x00,
+	4, 0x3c, 0x40,
+		0x00, 0xa3,
+	3, 0x3c, 0x43,
+		0x7d,
+	3, 0x3c, 0x45,
+		0xd7,
+	3, 0x3c, 0x47,
+		0xfc,
+	3, 0x3c, 0x50,
+		0x05,
+	3, 0x3c, 0x52,
+		0xaa,
+	3, 0x3c, 0x54,
+		0x71,
+	3, 0x3c, 0x56,
+		0x80,
+	3, 0x3d, 0x85,
+		0x17,
+	4, 0x3d, 0x8c,
+		0x71, 0xea,
+	3, 0x3f, 0x03,
+		0x00,
+	4, 0x3f, 0x0a,
+		0x00, 0x00,
+	3, 0x40, 0x01,
+		0x60,
+	3, 0x40, 0x03,
+		0x40,
+	3, 0x40, 0x09,
+		0x0d,
+	3, 0x40, 0x17,
+		0x08,
+	18, 0x40, 0x20,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	12, 0x40, 0x40,
+		0x00, 0x03, 0x00, 0x7a, 0x00, 0x7a, 0x00, 0x7a,
+		0x00, 0x7a,
+	3, 0x43, 0x07,
+		0x30,
+	6, 0x45, 0x00,
+		0x58, 0x04, 0x40, 0x10,
+	6, 0x45, 0x08,
+		0xaa, 0xaa, 0x00, 0x00,
+	4, 0x46, 0x00,
+		0x01, 0x03,
+	3, 0x47, 0x00,
+		0xa4,
+	3, 0x48, 0x00,
+		0x4c,
+	3, 0x48, 0x16,
+		0x53,
+	3, 0x48, 0x1f,
+		0x40,
+	3, 0x48, 0x37,
+		0x13,
+	5, 0x50, 0x00,
+		0x56, 0x01, 0x28,
+	3, 0x50, 0x04,
+		0x0c,
+	6, 0x50, 0x06,
+		0x0c, 0xe0, 0x01, 0xb0,
+	3, 0x50, 0x45,
+		0x05,
+	3, 0x50, 0x48,
+		0x40,
+	23, 0x57, 0x80,
+		0x3e, 0x0f, 0x44, 0x02, 0x01, 0x01, 0x00, 0x04,
+		0x02, 0x0f, 0xfd, 0xf5, 0xf5, 0x03, 0x08, 0x0c,
+		0x08, 0x06, 0x00, 0x52, 0xa3,
+	3, 0x59, 0x01,
+		0x00,
+	3, 0x5a, 0x01,
+		0x00,
+	8, 0x5a, 0x03,
+		0x00, 0x0c, 0xe0, 0x09, 0xb0, 0x06,
+	6, 0x5b, 0x00,
+		0x01, 0x10, 0x01, 0xdb,
+	3, 0x5e, 0x00,
+		0x00,
+};
+
+/* 263 entries, 105 messages */
+static const u8 mode_1296x972_regs_packed[] = {
+	3, 0x30, 0x00,
+		0x00,
+	3, 0x30, 0x02,
+		0x21,
+	3, 0x30, 0x05,
+		0xf0,
+	3, 0x30, 0x07,
+		0x00,
+	3, 0x30, 0x15,
+		0x0f,
+	3, 0x30, 0x18,
+		0x32,
+	7, 0x30, 0x1a,
+		0xf0, 0xf0, 0xf0, 0xf0, 0xf0,
+	4, 0x30, 0x30,
+		0x00, 0x0a,
+	3, 0x30, 0x3c,
+		0xff,
+	3, 0x30, 0x3e,
+		0xff,
+	5, 0x30, 0x40,
+		0xf0, 0x00, 0xf0,
+	3, 0x31, 0x06,
+		0x11,
+	8, 0x35, 0x00,
+		0x00, 0x80, 0x00, 0x00, 0x03, 0x83,
+	4, 0x35, 0x08,
+		0x07, 0x80,
+	7, 0x35, 0x0e,
+		0x04, 0x00, 0x00, 0x02, 0x00,
+	3, 0x36, 0x01,
+		0xc8,
+	3, 0x36, 0x10,
+		0x88,
+	3, 0x36, 0x12,
+		0x48,
+	4, 0x36, 0x14,
+		0x5b, 0x96,
+	3, 0x36, 0x18,
+		0x2a,
+	5, 0x36, 0x21,
+		0xd0, 0x00, 0x00,
+	6, 0x36, 0x33,
+		0x13, 0x13, 0x13, 0x13,
+	4, 0x36, 0x45,
+		0x13, 0x82,
+	3, 0x36, 0x50,
+		0x00,
+	3, 0x36, 0x52,
+		0xff,
+	4, 0x36, 0x55,
+		0x20, 0xff,
+	3, 0x36, 0x5a,
+		0xff,
+	3, 0x36, 0x5e,
+		0xff,
+	3, 0x36, 0x68,
+		0x00,
+	3, 0x36, 0x6a,
+		0x07,
+	5, 0x36, 0x6d,
+		0x00, 0x08, 0x80,
+	14, 0x37, 0x00,
+		0x28, 0x10, 0x3a, 0x19, 0x10, 0x00, 0x66, 0x08,
+		0x34, 0x40, 0x01, 0x1b,
+	3, 0x37, 0x14,
+		0x24,
+	3, 0x37, 0x1a,
+		0x3e,
+	4, 0x37, 0x33,
+		0x00, 0x40,
+	5, 0x37, 0x3a,
+		0x05, 0x06, 0x0a,
+	3, 0x37, 0x3f,
+		0xa0,
+	3, 0x37, 0x55,
+		0x00,
+	3, 0x37, 0x58,
+		0x00,
+	3, 0x37, 0x5b,
+		0x0e,
+	3, 0x37, 0x66,
+		0x5f,
+	4, 0x37, 0x68,
+		0x00, 0x22,
+	4, 0x37, 0x73,
+		0x08, 0x1f,
+	3, 0x37, 0x76,
+		0x06,
+	4, 0x37, 0xa0,
+		0x88, 0x5c,
+	4, 0x37, 0xa7,
+		0x88, 0x70,
+	4, 0x37, 0xaa,
+		0x88, 0x48,
+	3, 0x37, 0xb3,
+		0x66,
+	3, 0x37, 0xc2,
+		0x04,
+	3, 0x37, 0xc5,
+		0x00,
+	3, 0x37, 0xc8,
+		0x00,
+	18, 0x38, 0x00,
+		0x00, 0x0c, 0x00, 0x04, 0x0a, 0x33, 0x07, 0xa3,
+		0x05, 0x10, 0x03, 0xcc, 0x06, 0x90, 0x08, 0x08,
+	3, 0x38, 0x11,
+		0x04,
+	9, 0x38, 0x13,
+		0x04, 0x03, 0x01, 0x00, 0x00, 0x00, 0x00,
+	5, 0x38, 0x20,
+		0x94, 0x47, 0x48,
+	4, 0x38, 0x26,
+		0x00, 0x08,
+	4, 0x38, 0x2a,
+		0x03, 0x01,
+	3, 0x38, 0x30,
+		0x08,
+	5, 0x38, 0x36,
+		0x02, 0x00, 0x10,
+	3, 0x38, 0x41,
+		0xff,
+	3, 0x38, 0x46,
+		0x48,
+	5, 0x38, 0x61,
+		0x00, 0x04, 0x06,
+	4, 0x3a, 0x11,
+		0x01, 0x78,
+	3, 0x3b, 0x00,
+		0x00,
+	6, 0x3b, 0x02,
+		0x00, 0x00, 0x00, 0x00,
+	10, 0x3c, 0x00,
+		0x89, 0xab, 0x01, 0x00, 0x00, 0x03, 0x00, 0x05,
+	6, 0x3c, 0x0c,
+		0x00, 0x00, 0x00, 0x00,
+	4, 0x3c, 0x40,
+		0x00, 0xa3,
+	3, 0x3c, 0x43,
+		0x7d,
+	3, 0x3c, 0x45,
+		0xd7,
+	3, 0x3c, 0x47,
+		0xfc,
+	3, 0x3c, 0x50,
+		0x05,
+	3, 0x3c, 0x52,
+		0xaa,
+	3, 0x3c, 0x54,
+		0x71,
+	3, 0x3c, 0x56,
+		0x80,
+	3, 0x3d, 0x85,
+		0x17,
+	4, 0x3d, 0x8c,
+		0x71, 0xea,
+	3, 0x3f, 0x03,
+		0x00,
+	4, 0x3f, 0x0a,
+		0x00, 0x00,
+	3, 0x40, 0x01,
+		0x60,
+	3, 0x40, 0x03,
+		0x40,
+	3, 0x40, 0x09,
+		0x05,
+	3, 0x40, 0x17,
+		0x10,
+	18, 0x40, 0x20,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	12, 0x40, 0x40,
+		0x00, 0x03, 0x00, 0x7a, 0x00, 0x7a, 0x00, 0x7a,
+		0x00, 0x7a,
+	3, 0x43, 0x07,
+		0x30,
+	6, 0x45, 0x00,
+		0x58, 0x04, 0x48, 0x10,
+	6, 0x45, 0x08,
+		0x55, 0x55, 0x00, 0x00,
+	4, 0x46, 0x00,
+		0x00, 0x81,
+	3, 0x47, 0x00,
+		0xa4,
+	3, 0x48, 0x00,
+		0x4c,
+	3, 0x48, 0x16,
+		0x53,
+	3, 0x48, 0x1f,
+		0x40,
+	3, 0x48, 0x37,
+		0x13,
+	5, 0x50, 0x00,
+		0x56, 0x01, 0x28,
+	3, 0x50, 0x04,
+		0x0c,
+	6, 0x50, 0x06,
+		0x0c, 0xe0, 0x01, 0xb0,
+	3, 0x50, 0x45,
+		0x05,
+	3, 0x50, 0x48,
+		0x40,
+	23, 0x57, 0x80,
+		0x3e, 0x0f, 0x44, 0x02, 0x01, 0x01, 0x00, 0x04,
+		0x02, 0x0f, 0xfd, 0xf5, 0xf5, 0x03, 0x08, 0x0c,
+		0x08, 0x04, 0x00, 0x52, 0xa3,
+	3, 0x59, 0x01,
+		0x00,
+	3, 0x5a, 0x01,
+		0x00,
+	8, 0x5a, 0x03,
+		0x00, 0x0c, 0xe0, 0x09, 0xb0, 0x06,
+	6, 0x5b, 0x00,
+		0x01, 0x10, 0x01, 0xdb,
+	3, 0x5e, 0x00,
+		0x00,
+};
+
+/* 263 entries, 105 messages */
+static const u8 mode_648x486_regs_packed[] = {
+	3, 0x30, 0x00,
+		0x00,
+	3, 0x30, 0x02,
+		0x21,
+	3, 0x30, 0x05,
+		0xf0,
+	3, 0x30, 0x07,
+		0x00,
+	3, 0x30, 0x15,
+		0x0f,
+	3, 0x30, 0x18,
+		0x32,
+	7, 0x30, 0x1a,
+		0xf0, 0xf0, 0xf0, 0xf0, 0xf0,
+	4, 0x30, 0x30,
+		0x00, 0x0a,
+	3, 0x30, 0x3c,
+		0xff,
+	3, 0x30, 0x3e,
+		0xff,
+	5, 0x30, 0x40,
+		0xf0, 0x00, 0xf0,
+	3, 0x31, 0x06,
+		0x11,
+	8, 0x35, 0x00,
+		0x00, 0x80, 0x00, 0x00, 0x03, 0x83,
+	4, 0x35, 0x08,
+		0x04, 0x00,
+	7, 0x35, 0x0e,
+		0x04, 0x00, 0x00, 0x02, 0x00,
+	3, 0x36, 0x01,
+		0xc8,
+	3, 0x36, 0x10,
+		0x88,
+	3, 0x36, 0x12,
+		0x48,
+	4, 0x36, 0x14,
+		0x5b, 0x96,
+	3, 0x36, 0x18,
+		0x2a,
+	5, 0x36, 0x21,
+		0xd0, 0x00, 0x04,
+	6, 0x36, 0x33,
+		0x13, 0x13, 0x13, 0x13,
+	4, 0x36, 0x45,
+		0x13, 0x82,
+	3, 0x36, 0x50,
+		0x00,
+	3, 0x36, 0x52,
+		0xff,
+	4, 0x36, 0x55,
+		0x20, 0xff,
+	3, 0x36, 0x5a,
+		0xff,
+	3, 0x36, 0x5e,
+		0xff,
+	3, 0x36, 0x68,
+		0x00,
+	3, 0x36, 0x6a,
+		0x07,
+	5, 0x36, 0x6d,
+		0x00, 0x08, 0x80,
+	14, 0x37, 0x00,
+		0x28, 0x10, 0x3a, 0x19, 0x10, 0x00, 0x66, 0x08,
+		0x34, 0x40, 0x01, 0x1b,
+	3, 0x37, 0x14,
+		0x24,
+	3, 0x37, 0x1a,
+		0x3e,
+	4, 0x37, 0x33,
+		0x00, 0x40,
+	5, 0x37, 0x3a,
+		0x05, 0x06, 0x0a,
+	3, 0x37, 0x3f,
+		0xa0,
+	3, 0x37, 0x55,
+		0x00,
+	3, 0x37, 0x58,
+		0x00,
+	3, 0x37, 0x5b,
+		0x0e,
+	3, 0x37, 0x66,
+		0x5f,
+	4, 0x37, 0x68,
+		0x00, 0x22,
+	4, 0x37, 0x73,
+		0x08, 0x1f,
+	3, 0x37, 0x76,
+		0x06,
+	4, 0x37, 0xa0,
+		0x88, 0x5c,
+	4, 0x37, 0xa7,
+		0x88, 0x70,
+	4, 0x37, 0xaa,
+		0x88, 0x48,
+	3, 0x37, 0xb3,
+		0x66,
+	3, 0x37, 0xc2,
+		0x04,
+	3, 0x37, 0xc5,
+		0x00,
+	3, 0x37, 0xc8,
+		0x00,
+	18, 0x38, 0x00,
+		0x00, 0x0c, 0x00, 0x04, 0x0a, 0x33, 0x07, 0xa3,
+		0x02, 0x88, 0x01, 0xe6, 0x06, 0x90, 0x08, 0x08,
+	3, 0x38, 0x11,
+		0x04,
+	9, 0x38, 0x13,
+		0x02, 0x07, 0x01, 0x00, 0x00, 0x00, 0x00,
+	5, 0x38, 0x20,
+		0x94, 0xc6, 0x48,
+	4, 0x38, 0x26,
+		0x00, 0x08,
+	4, 0x38, 0x2a,
+		0x07, 0x01,
+	3, 0x38, 0x30,
+		0x08,
+	5, 0x38, 0x36,
+		0x02, 0x00, 0x10,
+	3, 0x38, 0x41,
+		0xff,
+	3, 0x38, 0x46,
+		0x48,
+	5, 0x38, 0x61,
+		0x00, 0x04, 0x06,
+	4, 0x3a, 0x11,
+		0x01, 0x78,
+	3, 0x3b, 0x00,
+		0x00,
+	6, 0x3b, 0x02,
+		0x00, 0x00, 0x00, 0x00,
+	10, 0x3c, 0x00,
+		0x89, 0xab, 0x01, 0x00, 0x00, 0x03, 0x00, 0x05,
+	6, 0x3c, 0x0c,
+		0x00, 0x00, 0x00, 0x00,
+	4, 0x3c, 0x40,
+		0x00, 0xa3,
+	3, 0x3c, 0x43,
+		0x7d,
+	3, 0x3c, 0x45,
+		0xd7,
+	3, 0x3c, 0x47,
+		0xfc,
+	3, 0x3c, 0x50,
+		0x05,
+	3, 0x3c, 0x52,
+		0xaa,
+	3, 0x3c, 0x54,
+		0x71,
+	3, 0x3c, 0x56,
+		0x80,
+	3, 0x3d, 0x85,
+		0x17,
+	4, 0x3d, 0x8c,
+		0x71, 0xea,
+	3, 0x3f, 0x03,
+		0x00,
+	4, 0x3f, 0x0a,
+		0x00, 0x00,
+	3, 0x40, 0x01,
+		0x60,
+	3, 0x40, 0x03,
+		0x40,
+	3, 0x40, 0x09,
+		0x05,
+	3, 0x40, 0x17,
+		0x10,
+	18, 0x40, 0x20,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	12, 0x40, 0x40,
+		0x00, 0x03, 0x00, 0x7a, 0x00, 0x7a, 0x00, 0x7a,
+		0x00, 0x7a,
+	3, 0x43, 0x07,
+		0x30,
+	6, 0x45, 0x00,
+		0x58, 0x04, 0x40, 0x10,
+	6, 0x45, 0x08,
+		0x55, 0x55, 0x02, 0x00,
+	4, 0x46, 0x00,
+		0x00, 0x40,
+	3, 0x47, 0x00,
+		0xa4,
+	3, 0x48, 0x00,
+		0x4c,
+	3, 0x48, 0x16,
+		0x53,
+	3, 0x48, 0x1f,
+		0x40,
+	3, 0x48, 0x37,
+		0x13,
+	5, 0x50, 0x00,
+		0x56, 0x01, 0x28,
+	3, 0x50, 0x04,
+		0x0c,
+	6, 0x50, 0x06,
+		0x0c, 0xe0, 0x01, 0xb0,
+	3, 0x50, 0x45,
+		0x05,
+	3, 0x50, 0x48,
+		0x40,
+	23, 0x57, 0x80,
+		0x3e, 0x0f, 0x44, 0x02, 0x01, 0x01, 0x00, 0x04,
+		0x02, 0x0f, 0xfd, 0xf5, 0xf5, 0x03, 0x08, 0x0c,
+		0x08, 0x06, 0x00, 0x52, 0xa3,
+	3, 0x59, 0x01,
+		0x00,
+	3, 0x5a, 0x01,
+		0x00,
+	8, 0x5a, 0x03,
+		0x00, 0x0c, 0xe0, 0x09, 0xb0, 0x06,
+	6, 0x5b, 0x00,
+		0x01, 0x10, 0x01, 0xdb,
+	3, 0x5e, 0x00,
+		0x00,
+};
+
+/* 262 entries, 105 messages */
+static const u8 mode_2560x1440_regs_packed[] = {
+	3, 0x30, 0x00,
+		0x00,
+	3, 0x30, 0x02,
+		0x21,
+	3, 0x30, 0x05,
+		0xf0,
+	3, 0x30, 0x07,
+		0x00,
+	3, 0x30, 0x15,
+		0x0f,
+	3, 0x30, 0x18,
+		0x32,
+	7, 0x30, 0x1a,
+		0xf0, 0xf0, 0xf0, 0xf0, 0xf0,
+	4, 0x30, 0x30,
+		0x00, 0x0a,
+	3, 0x30, 0x3c,
+		0xff,
+	3, 0x30, 0x3e,
+		0xff,
+	5, 0x30, 0x40,
+		0xf0, 0x00, 0xf0,
+	3, 0x31, 0x06,
+		0x11,
+	8, 0x35, 0x00,
+		0x00, 0x80, 0x00, 0x04, 0x03, 0x83,
+	4, 0x35, 0x08,
+		0x04, 0x00,
+	7, 0x35, 0x0e,
+		0x04, 0x00, 0x00, 0x02, 0x00,
+	3, 0x36, 0x01,
+		0xc8,
+	3, 0x36, 0x10,
+		0x88,
+	3, 0x36, 0x12,
+		0x48,
+	4, 0x36, 0x14,
+		0x5b, 0x96,
+	3, 0x36, 0x18,
+		0x2a,
+	5, 0x36, 0x21,
+		0xd0, 0x00, 0x00,
+	6, 0x36, 0x33,
+		0x13, 0x13, 0x13, 0x13,
+	4, 0x36, 0x45,
+		0x13, 0x82,
+	3, 0x36, 0x50,
+		0x00,
+	3, 0x36, 0x52,
+		0xff,
+	4, 0x36, 0x55,
+		0x20, 0xff,
+	3, 0x36, 0x5a,
+		0xff,
+	3, 0x36, 0x5e,
+		0xff,
+	3, 0x36, 0x68,
+		0x00,
+	3, 0x36, 0x6a,
+		0x07,
+	5, 0x36, 0x6d,
+		0x00, 0x10, 0x80,
+	14, 0x37, 0x00,
+		0x28, 0x10, 0x3a, 0x19, 0x10, 0x00, 0x66, 0x08,
+		0x34, 0x40, 0x01, 0x1b,
+	3, 0x37, 0x14,
+		0x24,
+	3, 0x37, 0x1a,
+		0x3e,
+	4, 0x37, 0x33,
+		0x00, 0x40,
+	5, 0x37, 0x3a,
+		0x05, 0x06, 0x0a,
+	3, 0x37, 0x3f,
+		0xa0,
+	3, 0x37, 0x55,
+		0x00,
+	3, 0x37, 0x58,
+		0x00,
+	3, 0x37, 0x5b,
+		0x0e,
+	3, 0x37, 0x66,
+		0x5f,
+	4, 0x37, 0x68,
+		0x00, 0x22,
+	4, 0x37, 0x73,
+		0x08, 0x1f,
+	3, 0x37, 0x76,
+		0x06,
+	4, 0x37, 0xa0,
+		0x88, 0x5c,
+	4, 0x37, 0xa7,
+		0x88, 0x70,
+	4, 0x37, 0xaa,
+		0x88, 0x48,
+	3, 0x37, 0xb3,
+		0x66,
+	3, 0x37, 0xc2,
+		0x04,
+	3, 0x37, 0xc5,
+		0x00,
+	3, 0x37, 0xc8,
+		0x00,
+	18, 0x38, 0x00,
+		0x00, 0x0c, 0x00, 0x04, 0x0a, 0x33, 0x07, 0xa3,
+		0x0a, 0x00, 0x05, 0xa0, 0x06, 0x90, 0x08, 0x08,
+	3, 0x38, 0x11,
+		0x04,
+	9, 0x38, 0x13,
+		0x02, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00,
+	5, 0x38, 0x20,
+		0x84, 0x46, 0x48,
+	4, 0x38, 0x26,
+		0x00, 0x08,
+	4, 0x38, 0x2a,
+		0x01, 0x01,
+	3, 0x38, 0x30,
+		0x08,
+	5, 0x38, 0x36,
+		0x02, 0x00, 0x10,
+	3, 0x38, 0x41,
+		0xff,
+	3, 0x38, 0x46,
+		0x48,
+	5, 0x38, 0x61,
+		0x00, 0x04, 0x06,
+	4, 0x3a, 0x11,
+		0x01, 0x78,
+	3, 0x3b, 0x00,
+		0x00,
+	6, 0x3b, 0x02,
+		0x00, 0x00, 0x00, 0x00,
+	10, 0x3c, 0x00,
+		0x89, 0xab, 0x01, 0x00, 0x00, 0x03, 0x00, 0x05,
+	6, 0x3c, 0x0c,
+		0x00, 0x00, 0x00, 0x00,
+	4, 0x3c, 0x40,
+		0x00, 0xa3,
+	3, 0x3c, 0x43,
+		0x7d,
+	3, 0x3c, 0x45,
+		0xd7,
+	3, 0x3c, 0x47,
+		0xfc,
+	3, 0x3c, 0x50,
+		0x05,
+	3, 0x3c, 0x52,
+		0xaa,
+	3, 0x3c, 0x54,
+		0x71,
+	3, 0x3c, 0x56,
+		0x80,
+	3, 0x3d, 0x85,
+		0x17,
+	4, 0x3d, 0x8c,
+		0x71, 0xea,
+	3, 0x3f, 0x03,
+		0x00,
+	4, 0x3f, 0x0a,
+		0x00, 0x00,
+	3, 0x40, 0x01,
+		0x60,
+	3, 0x40, 0x03,
+		0x40,
+	3, 0x40, 0x09,
+		0x0d,
+	3, 0x40, 0x17,
+		0x08,
+	18, 0x40, 0x20,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	12, 0x40, 0x40,
+		0x00, 0x03, 0x00, 0x7a, 0x00, 0x7a, 0x00, 0x7a,
+		0x00, 0x7a,
+	3, 0x43, 0x07,
+		0x30,
+	6, 0x45, 0x00,
+		0x58, 0x04, 0x40, 0x10,
+	6, 0x45, 0x08,
+		0xaa, 0xaa, 0x00, 0x00,
+	4, 0x46, 0x00,
+		0x01, 0x00,
+	3, 0x47, 0x00,
+		0xa4,
+	3, 0x48, 0x00,
+		0x4c,
+	3, 0x48, 0x16,
+		0x53,
+	3, 0x48, 0x1f,
+		0x40,
+	3, 0x48, 0x37,
+		0x13,
+	5, 0x50, 0x00,
+		0x56, 0x01, 0x28,
+	3, 0x50, 0x04,
+		0x0c,
+	6, 0x50, 0x06,
+		0x0c, 0xe0, 0x01, 0xb0,
+	3, 0x50, 0x45,
+		0x05,
+	3, 0x50, 0x48,
+		0x40,
+	23, 0x57, 0x80,
+		0x3e, 0x0f, 0x44, 0x02, 0x01, 0x01, 0x00, 0x04,
+		0x02, 0x0f, 0xfd, 0xf5, 0xf5, 0x03, 0x08, 0x0c,
+		0x08, 0x06, 0x00, 0x52, 0xa3,
+	3, 0x59, 0x01,
+		0x00,
+	3, 0x5a, 0x01,
+		0x00,
+	8, 0x5a, 0x03,
+		0x00, 0x0c, 0xe0, 0x09, 0xb0, 0x06,
+	6, 0x5b, 0x00,
+		0x01, 0x10, 0x01, 0xdb,
+	3, 0x5e, 0x00,
+		0x00,
+};
+
+/* 263 entries, 105 messages */
+static const u8 mode_1280x720_regs_packed[] = {
+	3, 0x30, 0x00,
+		0x00,
+	3, 0x30, 0x02,
+		0x21,
+	3, 0x30, 0x05,
+		0xf0,
+	3, 0x30, 0x07,
+		0x00,
+	3, 0x30, 0x15,
+		0x0f,
+	3, 0x30, 0x18,
+		0x32,
+	7, 0x30, 0x1a,
+		0xf0, 0xf0, 0xf0, 0xf0, 0xf0,
+	4, 0x30, 0x30,
+		0x00, 0x0a,
+	3, 0x30, 0x3c,
+		0xff,
+	3, 0x30, 0x3e,
+		0xff,
+	5, 0x30, 0x40,
+		0xf0, 0x00, 0xf0,
+	3, 0x31, 0x06,
+		0x11,
+	8, 0x35, 0x00,
+		0x00, 0x80, 0x00, 0x00, 0x03, 0x83,
+	4, 0x35, 0x08,
+		0x04, 0x00,
+	7, 0x35, 0x0e,
+		0x04, 0x00, 0x00, 0x02, 0x00,
+	3, 0x36, 0x01,
+		0xc8,
+	3, 0x36, 0x10,
+		0x88,
+	3, 0x36, 0x12,
+		0x48,
+	4, 0x36, 0x14,
+		0x5b, 0x96,
+	3, 0x36, 0x18,
+		0x2a,
+	5, 0x36, 0x21,
+		0xd0, 0x00, 0x00,
+	6, 0x36, 0x33,
+		0x13, 0x13, 0x13, 0x13,
+	4, 0x36, 0x45,
+		0x13, 0x82,
+	3, 0x36, 0x50,
+		0x00,
+	3, 0x36, 0x52,
+		0xff,
+	4, 0x36, 0x55,
+		0x20, 0xff,
+	3, 0x36, 0x5a,
+		0xff,
+	3, 0x36, 0x5e,
+		0xff,
+	3, 0x36, 0x68,
+		0x00,
+	3, 0x36, 0x6a,
+		0x07,
+	5, 0x36, 0x6d,
+		0x00, 0x08, 0x80,
+	14, 0x37, 0x00,
+		0x28, 0x10, 0x3a, 0x19, 0x10, 0x00, 0x66, 0x08,
+		0x34, 0x40, 0x01, 0x1b,
+	3, 0x37, 0x14,
+		0x24,
+	3, 0x37, 0x1a,
+		0x3e,
+	4, 0x37, 0x33,
+		0x00, 0x40,
+	5, 0x37, 0x3a,
+		0x05, 0x06, 0x0a,
+	3, 0x37, 0x3f,
+		0xa0,
+	3, 0x37, 0x55,
+		0x00,
+	3, 0x37, 0x58,
+		0x00,
+	3, 0x37, 0x5b,
+		0x0e,
+	3, 0x37, 0x66,
+		0x5f,
+	4, 0x37, 0x68,
+		0x00, 0x22,
+	4, 0x37, 0x73,
+		0x08, 0x1f,
+	3, 0x37, 0x76,
+		0x06,
+	4, 0x37, 0xa0,
+		0x88, 0x5c,
+	4, 0x37, 0xa7,
+		0x88, 0x70,
+	4, 0x37, 0xaa,
+		0x88, 0x48,
+	3, 0x37, 0xb3,
+		0x66,
+	3, 0x37, 0xc2,
+		0x04,
+	3, 0x37, 0xc5,
+		0x00,
+	3, 0x37, 0xc8,
+		0x00,
+	18, 0x38, 0x00,
+		0x00, 0x0c, 0x00, 0x04, 0x0a, 0x33, 0x07, 0xa3,
+		0x05, 0x00, 0x02, 0xd0, 0x06, 0x90, 0x08, 0x08,
+	3, 0x38, 0x11,
+		0x04,
+	9, 0x38, 0x13,
+		0x02, 0x03, 0x01, 0x00, 0x00, 0x00, 0x00,
+	5, 0x38, 0x20,
+		0x94, 0x47, 0x48,
+	4, 0x38, 0x26,
+		0x00, 0x08,
+	4, 0x38, 0x2a,
+		0x03, 0x01,
+	3, 0x38, 0x30,
+		0x08,
+	5, 0x38, 0x36,
+		0x02, 0x00, 0x10,
+	3, 0x38, 0x41,
+		0xff,
+	3, 0x38, 0x46,
+		0x48,
+	5, 0x38, 0x61,
+		0x00, 0x04, 0x06,
+	4, 0x3a, 0x11,
+		0x01, 0x78,
+	3, 0x3b, 0x00,
+		0x00,
+	6, 0x3b, 0x02,
+		0x00, 0x00, 0x00, 0x00,
+	10, 0x3c, 0x00,
+		0x89, 0xab, 0x01, 0x00, 0x00, 0x03, 0x00, 0x05,
+	6, 0x3c, 0x0c,
+		0x00, 0x00, 0x00, 0x00,
+	4, 0x3c, 0x40,
+		0x00, 0xa3,
+	3, 0x3c, 0x43,
+		0x7d,
+	3, 0x3c, 0x45,
+		0xd7,
+	3, 0x3c, 0x47,
+		0xfc,
+	3, 0x3c, 0x50,
+		0x05,
+	3, 0x3c, 0x52,
+		0xaa,
+	3, 0x3c, 0x54,
+		0x71,
+	3, 0x3c, 0x56,
+		0x80,
+	3, 0x3d, 0x85,
+		0x17,
+	4, 0x3d, 0x8c,
+		0x71, 0xea,
+	3, 0x3f, 0x03,
+		0x00,
+	4, 0x3f, 0x0a,
+		0x00, 0x00,
+	3, 0x40, 0x01,
+		0x60,
+	3, 0x40, 0x03,
+		0x40,
+	3, 0x40, 0x09,
+		0x05,
+	3, 0x40, 0x17,
+		0x10,
+	18, 0x40, 0x20,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	12, 0x40, 0x40,
+		0x00, 0x03, 0x00, 0x7a, 0x00, 0x7a, 0x00, 0x7a,
+		0x00, 0x7a,
+	3, 0x43, 0x07,
+		0x30,
+	6, 0x45, 0x00,
+		0x58, 0x04, 0x48, 0x10,
+	6, 0x45, 0x08,
+		0x55, 0x55, 0x00, 0x00,
+	4, 0x46, 0x00,
+		0x00, 0x80,
+	3, 0x47, 0x00,
+		0xa4,
+	3, 0x48, 0x00,
+		0x4c,
+	3, 0x48, 0x16,
+		0x53,
+	3, 0x48, 0x1f,
+		0x40,
+	3, 0x48, 0x37,
+		0x13,
+	5, 0x50, 0x00,
+		0x56, 0x01, 0x28,
+	3, 0x50, 0x04,
+		0x0c,
+	6, 0x50, 0x06,
+		0x0c, 0xe0, 0x01, 0xb0,
+	3, 0x50, 0x45,
+		0x05,
+	3, 0x50, 0x48,
+		0x40,
+	23, 0x57, 0x80,
+		0x3e, 0x0f, 0x44, 0x02, 0x01, 0x01, 0x00, 0x04,
+		0x02, 0x0f, 0xfd, 0xf5, 0xf5, 0x03, 0x08, 0x0c,
+		0x08, 0x06, 0x00, 0x52, 0xa3,
+	3, 0x59, 0x01,
+		0x00,
+	3, 0x5a, 0x01,
+		0x00,
+	8, 0x5a, 0x03,
+		0x00, 0x0c, 0xe0, 0x09, 0xb0, 0x06,
+	6, 0x5b, 0x00,
+		0x01, 0x10, 0x01, 0xdb,
+	3, 0x5e, 0x00,
+		0x00,
+};
+
+/* 263 entries, 105 messages */
+static const u8 mode_640x360_regs_packed[] = {
+	3, 0x30, 0x00,
+		0x00,
+	3, 0x30, 0x02,
+		0x21,
+	3, 0x30, 0x05,
+		0xf0,
+	3, 0x30, 0x07,
+		0x00,
+	3, 0x30, 0x15,
+		0x0f,
+	3, 0x30, 0x18,
+		0x32,
+	7, 0x30, 0x1a,
+		0xf0, 0xf0, 0xf0, 0xf0, 0xf0,
+	4, 0x30, 0x30,
+		0x00, 0x0a,
+	3, 0x30, 0x3c,
+		0xff,
+	3, 0x30, 0x3e,
+		0xff,
+	5, 0x30, 0x40,
+		0xf0, 0x00, 0xf0,
+	3, 0x31, 0x06,
+		0x11,
+	8, 0x35, 0x00,
+		0x00, 0x80, 0x00, 0x00, 0x03, 0x83,
+	4, 0x35, 0x08,
+		0x04, 0x00,
+	7, 0x35, 0x0e,
+		0x04, 0x00, 0x00, 0x02, 0x00,
+	3, 0x36, 0x01,
+		0xc8,
+	3, 0x36, 0x10,
+		0x88,
+	3, 0x36, 0x12,
+		0x48,
+	4, 0x36, 0x14,
+		0x5b, 0x96,
+	3, 0x36, 0x18,
+		0x2a,
+	5, 0x36, 0x21,
+		0xd0, 0x00, 0x04,
+	6, 0x36, 0x33,
+		0x13, 0x13, 0x13, 0x13,
+	4, 0x36, 0x45,
+		0x13, 0x82,
+	3, 0x36, 0x50,
+		0x00,
+	3, 0x36, 0x52,
+		0xff,
+	4, 0x36, 0x55,
+		0x20, 0xff,
+	3, 0x36, 0x5a,
+		0xff,
+	3, 0x36, 0x5e,
+		0xff,
+	3, 0x36, 0x68,
+		0x00,
+	3, 0x36, 0x6a,
+		0x07,
+	5, 0x36, 0x6d,
+		0x00, 0x08, 0x80,
+	14, 0x37, 0x00,
+		0x28, 0x10, 0x3a, 0x19, 0x10, 0x00, 0x66, 0x08,
+		0x34, 0x40, 0x01, 0x1b,
+	3, 0x37, 0x14,
+		0x24,
+	3, 0x37, 0x1a,
+		0x3e,
+	4, 0x37, 0x33,
+		0x00, 0x40,
+	5, 0x37, 0x3a,
+		0x05, 0x06, 0x0a,
+	3, 0x37, 0x3f,
+		0xa0,
+	3, 0x37, 0x55,
+		0x00,
+	3, 0x37, 0x58,
+		0x00,
+	3, 0x37, 0x5b,
+		0x0e,
+	3, 0x37, 0x66,
+		0x5f,
+	4, 0x37, 0x68,
+		0x00, 0x22,
+	4, 0x37, 0x73,
+		0x08, 0x1f,
+	3, 0x37, 0x76,
+		0x06,
+	4, 0x37, 0xa0,
+		0x88, 0x5c,
+	4, 0x37, 0xa7,
+		0x88, 0x70,
+	4, 0x37, 0xaa,
+		0x88, 0x48,
+	3, 0x37, 0xb3,
+		0x66,
+	3, 0x37, 0xc2,
+		0x04,
+	3, 0x37, 0xc5,
+		0x00,
+	3, 0x37, 0xc8,
+		0x00,
+	18, 0x38, 0x00,
+		0x00, 0x0c, 0x00, 0x04, 0x0a, 0x33, 0x07, 0xa3,
+		0x02, 0x80, 0x01, 0x68, 0x06, 0x90, 0x08, 0x08,
+	3, 0x38, 0x11,
+		0x04,
+	9, 0x38, 0x13,
+		0x02, 0x07, 0x01, 0x00, 0x00, 0x00, 0x00,
+	5, 0x38, 0x20,
+		0x94, 0xc6, 0x48,
+	4, 0x38, 0x26,
+		0x00, 0x08,
+	4, 0x38, 0x2a,
+		0x07, 0x01,
+	3, 0x38, 0x30,
+		0x08,
+	5, 0x38, 0x36,
+		0x02, 0x00, 0x10,
+	3, 0x38, 0x41,
+		0xff,
+	3, 0x38, 0x46,
+		0x48,
+	5, 0x38, 0x61,
+		0x00, 0x04, 0x06,
+	4, 0x3a, 0x11,
+		0x01, 0x78,
+	3, 0x3b, 0x00,
+		0x00,
+	6, 0x3b, 0x02,
+		0x00, 0x00, 0x00, 0x00,
+	10, 0x3c, 0x00,
+		0x89, 0xab, 0x01, 0x00, 0x00, 0x03, 0x00, 0x05,
+	6, 0x3c, 0x0c,
+		0x00, 0x00, 0x00, 0x00,
+	4, 0x3c, 0x40,
+		0x00, 0xa3,
+	3, 0x3c, 0x43,
+		0x7d,
+	3, 0x3c, 0x45,
+		0xd7,
+	3, 0x3c, 0x47,
+		0xfc,
+	3, 0x3c, 0x50,
+		0x05,
+	3, 0x3c, 0x52,
+		0xaa,
+	3, 0x3c, 0x54,
+		0x71,
+	3, 0x3c, 0x56,
+		0x80,
+	3, 0x3d, 0x85,
+		0x17,
+	4, 0x3d, 0x8c,
+		0x71, 0xea,
+	3, 0x3f, 0x03,
+		0x00,
+	4, 0x3f, 0x0a,
+		0x00, 0x00,
+	3, 0x40, 0x01,
+		0x60,
+	3, 0x40, 0x03,
+		0x40,
+	3, 0x40, 0x09,
+		0x05,
+	3, 0x40, 0x17,
+		0x10,
+	18, 0x40, 0x20,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	12, 0x40, 0x40,
+		0x00, 0x03, 0x00, 0x7a, 0x00, 0x7a, 0x00, 0x7a,
+		0x00, 0x7a,
+	3, 0x43, 0x07,
+		0x30,
+	6, 0x45, 0x00,
+		0x58, 0x04, 0x40, 0x10,
+	6, 0x45, 0x08,
+		0x55, 0x55, 0x02, 0x00,
+	4, 0x46, 0x00,
+		0x00, 0x40,
+	3, 0x47, 0x00,
+		0xa4,
+	3, 0x48, 0x00,
+		0x4c,
+	3, 0x48, 0x16,
+		0x53,
+	3, 0x48, 0x1f,
+		0x40,
+	3, 0x48, 0x37,
+		0x13,
+	5, 0x50, 0x00,
+		0x56, 0x01, 0x28,
+	3, 0x50, 0x04,
+		0x0c,
+	6, 0x50, 0x06,
+		0x0c, 0xe0, 0x01, 0xb0,
+	3, 0x50, 0x45,
+		0x05,
+	3, 0x50, 0x48,
+		0x40,
+	23, 0x57, 0x80,
+		0x3e, 0x0f, 0x44, 0x02, 0x01, 0x01, 0x00, 0x04,
+		0x02, 0x0f, 0xfd, 0xf5, 0xf5, 0x03, 0x08, 0x0c,
+		0x08, 0x06, 0x00, 0x52, 0xa3,
+	3, 0x59, 0x01,
+		0x00,
+	3, 0x5a, 0x01,
+		0x00,
+	8, 0x5a, 0x03,
+		0x00, 0x0c, 0xe0, 0x09, 0xb0, 0x06,
+	6, 0x5b, 0x00,
+		0x01, 0x10, 0x01, 0xdb,
+	3, 0x5e, 0x00,
+		0x00,
+};
+
+#endif /* __OV5670_REGS_PACKED_H__ */
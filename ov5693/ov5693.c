@@ -29,106 +29,67 @@
 #include <linux/slab.h>
 #include <linux/i2c.h>
 #include <linux/moduleparam.h>
+#include <linux/pm_runtime.h>
 #include <media/v4l2-device.h>
 #include <linux/io.h>
 #include <linux/acpi.h>
 
 #include "ov5693.h"
-#include "ad5823.h"
-
-#define __cci_delay(t) \
-	do { \
-		if ((t) < 10) { \
-			usleep_range((t) * 1000, ((t) + 1) * 1000); \
-		} else { \
-			msleep((t)); \
-		} \
-	} while (0)
 
 /* Value 30ms reached through experimentation on byt ecs.
  * The DS specifies a much lower value but when using a smaller value
  * the I2C bus sometimes locks up permanently when starting the camera.
  * This issue could not be reproduced on cht, so we can reduce the
  * delay value to a lower value when insmod.
+ *
+ * The chip ID is polled once the sensor is powered, so this is only the
+ * upper bound of the wait. Most units answer well before.
  */
 static uint up_delay = 30;
 module_param(up_delay, uint, 0644);
 MODULE_PARM_DESC(up_delay,
-		 "Delay prior to the first CCI transaction for ov5693");
+		 "Max delay prior to the first CCI transaction for ov5693 (ms)");
 
-static int vcm_ad_i2c_wr8(struct i2c_client *client, u8 reg, u8 val)
-{
-	int err;
-	struct i2c_msg msg;
-	u8 buf[2];
-
-	buf[0] = reg;
-	buf[1] = val;
+static bool embedded_data = true;
+module_param(embedded_data, bool, 0644);
+MODULE_PARM_DESC(embedded_data,
+		 "Send the embedded data line, applied on the next stream start");
 
-	msg.addr = VCM_ADDR;
-	msg.flags = 0;
-	msg.len = 2;
-	msg.buf = &buf[0];
+/* Bytes of the embedded line holding register values, the rest is padding */
+static const u32 ov5693_embedded_effective_size = 28;
 
-	err = i2c_transfer(client->adapter, &msg, 1);
-	if (err != 1) {
-		dev_err(&client->dev, "%s: vcm i2c fail, err code = %d\n",
-			__func__, err);
-		return -EIO;
-	}
-	return 0;
-}
+static const struct sensor_reg_range ov5693_volatile_regs[] = {
+	SENSOR_REG_RANGE(OV5693_SW_RESET, OV5693_SW_RESET),
+	SENSOR_REG_RANGE(OV5693_SC_CMMN_CHIP_ID_H, OV5693_SC_CMMN_SCCB_ID),
+	SENSOR_REG_RANGE(OV5693_SC_CMMN_SUB_ID, OV5693_SC_CMMN_SUB_ID),
+	SENSOR_REG_RANGE(OV5693_GROUP_ACCESS, OV5693_GROUP_ACCESS),
+	SENSOR_REG_RANGE(OV5693_OTP_START_ADDR, OV5693_OTP_BANK_REG),
+};
 
-static int ad5823_i2c_write(struct i2c_client *client, u8 reg, u8 val)
+static struct sensor_regcache *ov5693_regcache(struct i2c_client *client)
 {
-	struct i2c_msg msg;
-	u8 buf[2];
-
-	buf[0] = reg;
-	buf[1] = val;
-	msg.addr = AD5823_VCM_ADDR;
-	msg.flags = 0;
-	msg.len = 0x02;
-	msg.buf = &buf[0];
+	struct v4l2_subdev *sd = i2c_get_clientdata(client);
 
-	if (i2c_transfer(client->adapter, &msg, 1) != 1)
-		return -EIO;
-	return 0;
+	return &to_ov5693_sensor(sd)->regcache;
 }
 
-static int ad5823_i2c_read(struct i2c_client *client, u8 reg, u8 *val)
+static struct sensor_stats *ov5693_stats(struct i2c_client *client)
 {
-	struct i2c_msg msg[2];
-	u8 buf[2];
-
-	buf[0] = reg;
-	buf[1] = 0;
-
-	msg[0].addr = AD5823_VCM_ADDR;
-	msg[0].flags = 0;
-	msg[0].len = 0x01;
-	msg[0].buf = &buf[0];
+	struct v4l2_subdev *sd = i2c_get_clientdata(client);
 
-	msg[1].addr = 0x0c;
-	msg[1].flags = I2C_M_RD;
-	msg[1].len = 0x01;
-	msg[1].buf = &buf[1];
-	*val = 0;
-	if (i2c_transfer(client->adapter, msg, 2) != 2)
-		return -EIO;
-	*val = buf[1];
-	return 0;
+	return &to_ov5693_sensor(sd)->stats;
 }
 
-static const u32 ov5693_embedded_effective_size = 28;
-
 /* i2c read/write stuff */
 static int ov5693_read_reg(struct i2c_client *client,
 			   u16 data_length, u16 reg, u16 *val)
 {
+	struct sensor_regcache *cache = ov5693_regcache(client);
 	int err;
 	struct i2c_msg msg[2];
 	unsigned char data[6];
+	ktime_t start;
+	u32 cached;
 
 	if (!client->adapter) {
 		dev_err(&client->dev, "%s error, no client->adapter\n",
@@ -143,6 +104,12 @@ static int ov5693_read_reg(struct i2c_client *client,
 		return -EINVAL;
 	}
 
+	if (data_length != OV5693_32BIT &&
+	    sensor_regcache_read_be(cache, reg, data_length, &cached)) {
+		*val = cached;
+		return 0;
+	}
+
 	memset(msg, 0, sizeof(msg));
 
 	msg[0].addr = client->addr;
@@ -159,10 +126,13 @@ static int ov5693_read_reg(struct i2c_client *client,
 	msg[1].flags = I2C_M_RD;
 	msg[1].buf = data;
 
+	start = ktime_get();
 	err = i2c_transfer(client->adapter, msg, 2);
-	if (err != 2) {
-		if (err >= 0)
-			err = -EIO;
+	if (err >= 0)
+		err = err == 2 ? 0 : -EIO;
+	sensor_stats_xfer(ov5693_stats(client), SENSOR_STATS_READ, reg,
+			  data_length, start, err);
+	if (err) {
 		dev_err(&client->dev,
 			"read from offset 0x%x error %d", reg, err);
 		return err;
@@ -177,85 +147,43 @@ static int ov5693_read_reg(struct i2c_client *client,
 	else
 		*val = be32_to_cpu(*(__be32 *)&data[0]);
 
+	if (data_length != OV5693_32BIT)
+		sensor_regcache_write_be(cache, reg, data_length, *val);
+
 	return 0;
 }
 
 static int ov5693_i2c_write(struct i2c_client *client, u16 len, u8 *data)
 {
+	struct sensor_regcache *cache = ov5693_regcache(client);
 	struct i2c_msg msg;
 	const int num_msg = 1;
+	ktime_t start;
 	int ret;
+	u16 reg;
 
+	reg = (data[0] << 8) | data[1];
 	msg.addr = client->addr;
 	msg.flags = 0;
 	msg.len = len;
 	msg.buf = data;
+	start = ktime_get();
 	ret = i2c_transfer(client->adapter, &msg, 1);
+	sensor_stats_xfer(ov5693_stats(client), SENSOR_STATS_WRITE, reg,
+			  len - 2, start, ret == num_msg ? 0 : -EIO);
+	if (ret != num_msg)
+		return -EIO;
 
-	return ret == num_msg ? 0 : -EIO;
-}
-
-static int vcm_dw_i2c_write(struct i2c_client *client, u16 data)
-{
-	struct i2c_msg msg;
-	const int num_msg = 1;
-	int ret;
-	__be16 val;
-
-	val = cpu_to_be16(data);
-	msg.addr = VCM_ADDR;
-	msg.flags = 0;
-	msg.len = OV5693_16BIT;
-	msg.buf = (void *)&val;
-
-	ret = i2c_transfer(client->adapter, &msg, 1);
-
-	return ret == num_msg ? 0 : -EIO;
-}
-
-/*
- * Theory: per datasheet, the two VCMs both allow for a 2-byte read.
- * The DW9714 doesn't actually specify what this does (it has a
- * two-byte write-only protocol, but specifies the read sequence as
- * legal), but it returns the same data (zeroes) always, after an
- * undocumented initial NAK.  The AD5823 has a one-byte address
- * register to which all writes go, and subsequent reads will cycle
- * through the 8 bytes of registers.  Notably, the default values (the
- * device is always power-cycled affirmatively, so we can rely on
- * these) in AD5823 are not pairwise repetitions of the same 16 bit
- * word.  So all we have to do is sequentially read two bytes at a
- * time and see if we detect a difference in any of the first four
- * pairs.
- */
-static int vcm_detect(struct i2c_client *client)
-{
-	int i, ret;
-	struct i2c_msg msg;
-	u16 data0 = 0, data;
-
-	for (i = 0; i < 4; i++) {
-		msg.addr = VCM_ADDR;
-		msg.flags = I2C_M_RD;
-		msg.len = sizeof(data);
-		msg.buf = (u8 *)&data;
-		ret = i2c_transfer(client->adapter, &msg, 1);
-
-		/*
-		 * DW9714 always fails the first read and returns
-		 * zeroes for subsequent ones
-		 */
-		if (i == 0 && ret == -EREMOTEIO) {
-			data0 = 0;
-			continue;
-		}
-
-		if (i == 0)
-			data0 = data;
+	/*
+	 * Keep the register cache in sync. A software reset brings every
+	 * register back to its default, so drop everything in that case.
+	 */
+	if (reg == OV5693_SW_RESET && (data[2] & 0x01))
+		sensor_regcache_invalidate(cache);
+	else
+		sensor_regcache_write_burst(cache, reg, data + 2, len - 2);
 
-		if (data != data0)
-			return VCM_AD5823;
-	}
-	return ret == 1 ? VCM_DW9714 : ret;
+	return 0;
 }
 
 static int ov5693_write_reg(struct i2c_client *client, u16 data_length,
@@ -577,20 +505,38 @@ static int ov5693_set_exposure(struct v4l2_subdev *sd, int exposure,
 	return ret;
 }
 
+/*
+ * Read @size bytes of the OTP buffer in a single sequential read. The
+ * sensor auto-increments the register address, so one address write
+ * followed by one read covers a whole bank.
+ */
 static int ov5693_read_otp_reg_array(struct i2c_client *client, u16 size,
 				     u16 addr, u8 *buf)
 {
-	u16 index;
+	struct i2c_msg msg[2];
+	__be16 reg = cpu_to_be16(addr);
+	ktime_t start;
 	int ret;
-	u16 *pVal = NULL;
 
-	for (index = 0; index <= size; index++) {
-		pVal = (u16 *)(buf + index);
-		ret =
-		    ov5693_read_reg(client, OV5693_8BIT, addr + index,
-				    pVal);
-		if (ret)
-			return ret;
+	msg[0].addr = client->addr;
+	msg[0].flags = 0;
+	msg[0].len = sizeof(reg);
+	msg[0].buf = (u8 *)&reg;
+
+	msg[1].addr = client->addr;
+	msg[1].flags = I2C_M_RD;
+	msg[1].len = size;
+	msg[1].buf = buf;
+
+	start = ktime_get();
+	ret = i2c_transfer(client->adapter, msg, ARRAY_SIZE(msg));
+	if (ret >= 0)
+		ret = ret == ARRAY_SIZE(msg) ? 0 : -EIO;
+	sensor_stats_xfer(ov5693_stats(client), SENSOR_STATS_READ, addr, size,
+			  start, ret);
+	if (ret) {
+		dev_err(&client->dev, "read OTP at 0x%x error %d\n", addr, ret);
+		return ret;
 	}
 
 	return 0;
@@ -675,43 +621,102 @@ static int __ov5693_otp_read(struct v4l2_subdev *sd, u8 *buf)
 }
 
 /*
- * Read otp data and store it into a kmalloced buffer.
- * The caller must kfree the buffer when no more needed.
- * @size: set to the size of the returned otp data.
+ * Read otp data and store it into a devm allocated buffer.
+ * dev->otp_size is set to the size of the returned otp data.
  */
 static void *ov5693_otp_read(struct v4l2_subdev *sd)
 {
 	struct i2c_client *client = v4l2_get_subdevdata(sd);
 	u8 *buf;
-	int ret;
+	int ret, err;
 
-	buf = devm_kzalloc(&client->dev, (OV5693_OTP_DATA_SIZE + 16), GFP_KERNEL);
+	/* one spare bank, the bank that ends the data area is read in too */
+	buf = devm_kzalloc(&client->dev,
+			   OV5693_OTP_DATA_SIZE + OV5693_OTP_BANK_SIZE,
+			   GFP_KERNEL);
 	if (!buf)
 		return ERR_PTR(-ENOMEM);
 
 	//otp valid after mipi on and sw stream on
 	ret = ov5693_write_reg(client, OV5693_8BIT, OV5693_FRAME_OFF_NUM, 0x00);
-
-	ret = ov5693_write_reg(client, OV5693_8BIT,
-			       OV5693_SW_STREAM, OV5693_START_STREAMING);
-
-	ret = __ov5693_otp_read(sd, buf);
+	if (!ret)
+		ret = ov5693_write_reg(client, OV5693_8BIT,
+				       OV5693_SW_STREAM, OV5693_START_STREAMING);
+	if (!ret)
+		ret = __ov5693_otp_read(sd, buf);
 
 	//mipi off and sw stream off after otp read
-	ret = ov5693_write_reg(client, OV5693_8BIT, OV5693_FRAME_OFF_NUM, 0x0f);
+	err = ov5693_write_reg(client, OV5693_8BIT, OV5693_FRAME_OFF_NUM, 0x0f);
+	if (!ret)
+		ret = err;
 
-	ret = ov5693_write_reg(client, OV5693_8BIT,
+	err = ov5693_write_reg(client, OV5693_8BIT,
 			       OV5693_SW_STREAM, OV5693_STOP_STREAMING);
+	if (!ret)
+		ret = err;
 
 	/* Driver has failed to find valid data */
 	if (ret) {
 		dev_err(&client->dev, "sensor found no valid OTP data\n");
+		devm_kfree(&client->dev, buf);
 		return ERR_PTR(ret);
 	}
 
 	return buf;
 }
 
+/*
+ * The OTP is read by ov5693_identify() on the first runtime resume and kept
+ * for the lifetime of the device. Probe leaves the sensor off, so a read
+ * before the first power up resumes the sensor to load it.
+ */
+static ssize_t otp_read(struct file *filp, struct kobject *kobj,
+			struct bin_attribute *attr, char *buf,
+			loff_t off, size_t count)
+{
+	struct i2c_client *client = to_i2c_client(kobj_to_dev(kobj));
+	struct ov5693_device *dev =
+		to_ov5693_sensor(i2c_get_clientdata(client));
+	int ret;
+
+	/* The OTP is read on the first power up, do it now if needed */
+	if (!dev->identified) {
+		mutex_lock(&dev->input_lock);
+		ret = pm_runtime_get_sync(&client->dev);
+		if (ret >= 0) {
+			pm_runtime_mark_last_busy(&client->dev);
+			pm_runtime_put_autosuspend(&client->dev);
+		} else {
+			pm_runtime_put_noidle(&client->dev);
+		}
+		mutex_unlock(&dev->input_lock);
+		if (ret < 0)
+			return ret;
+	}
+
+	if (!dev->otp_data)
+		return 0;
+
+	return memory_read_from_buffer(buf, count, &off, dev->otp_data,
+				       dev->otp_size);
+}
+static BIN_ATTR_RO(otp, OV5693_OTP_DATA_SIZE);
+
+static struct bin_attribute *ov5693_bin_attrs[] = {
+	&bin_attr_otp,
+	NULL
+};
+
+static const struct attribute_group ov5693_attr_group = {
+	.bin_attrs = ov5693_bin_attrs,
+};
+
+/* Added by the driver core once probe succeeded, removed before remove */
+static const struct attribute_group *ov5693_attr_groups[] = {
+	&ov5693_attr_group,
+	NULL
+};
+
 /*
  * This returns the exposure time being used. This should only be used
  * for filling in EXIF data, not for actual image processing.
@@ -747,111 +752,10 @@ err:
 	return ret;
 }
 
-static int ad5823_t_focus_vcm(struct v4l2_subdev *sd, u16 val)
-{
-	struct i2c_client *client = v4l2_get_subdevdata(sd);
-	int ret = -EINVAL;
-	u8 vcm_code;
-
-	ret = ad5823_i2c_read(client, AD5823_REG_VCM_CODE_MSB, &vcm_code);
-	if (ret)
-		return ret;
-
-	/* set reg VCM_CODE_MSB Bit[1:0] */
-	vcm_code = (vcm_code & VCM_CODE_MSB_MASK) |
-		   ((val >> 8) & ~VCM_CODE_MSB_MASK);
-	ret = ad5823_i2c_write(client, AD5823_REG_VCM_CODE_MSB, vcm_code);
-	if (ret)
-		return ret;
-
-	/* set reg VCM_CODE_LSB Bit[7:0] */
-	ret = ad5823_i2c_write(client, AD5823_REG_VCM_CODE_LSB, (val & 0xff));
-	if (ret)
-		return ret;
-
-	/* set required vcm move time */
-	vcm_code = AD5823_RESONANCE_PERIOD / AD5823_RESONANCE_COEF
-		   - AD5823_HIGH_FREQ_RANGE;
-	ret = ad5823_i2c_write(client, AD5823_REG_VCM_MOVE_TIME, vcm_code);
-
-	return ret;
-}
-
-static int ad5823_t_focus_abs(struct v4l2_subdev *sd, s32 value)
-{
-	value = min(value, AD5823_MAX_FOCUS_POS);
-	return ad5823_t_focus_vcm(sd, value);
-}
-
-static int ov5693_t_focus_abs(struct v4l2_subdev *sd, s32 value)
-{
-	struct ov5693_device *dev = to_ov5693_sensor(sd);
-	struct i2c_client *client = v4l2_get_subdevdata(sd);
-	int ret = 0;
-
-	dev_dbg(&client->dev, "%s: FOCUS_POS: 0x%x\n", __func__, value);
-	value = clamp(value, 0, OV5693_VCM_MAX_FOCUS_POS);
-	if (dev->vcm == VCM_DW9714) {
-		if (dev->vcm_update) {
-			ret = vcm_dw_i2c_write(client, VCM_PROTECTION_OFF);
-			if (ret)
-				return ret;
-			ret = vcm_dw_i2c_write(client, DIRECT_VCM);
-			if (ret)
-				return ret;
-			ret = vcm_dw_i2c_write(client, VCM_PROTECTION_ON);
-			if (ret)
-				return ret;
-			dev->vcm_update = false;
-		}
-		ret = vcm_dw_i2c_write(client,
-				       vcm_val(value, VCM_DEFAULT_S));
-	} else if (dev->vcm == VCM_AD5823) {
-		ad5823_t_focus_abs(sd, value);
-	}
-	if (ret == 0) {
-		dev->number_of_steps = value - dev->focus;
-		dev->focus = value;
-		dev->timestamp_t_focus_abs = ktime_get();
-	} else
-		dev_err(&client->dev,
-			"%s: i2c failed. ret %d\n", __func__, ret);
-
-	return ret;
-}
-
-static int ov5693_t_focus_rel(struct v4l2_subdev *sd, s32 value)
-{
-	struct ov5693_device *dev = to_ov5693_sensor(sd);
-
-	return ov5693_t_focus_abs(sd, dev->focus + value);
-}
-
-#define DELAY_PER_STEP_NS	1000000
-#define DELAY_MAX_PER_STEP_NS	(1000000 * 1023)
-
+/* Focus is set on the lens sub-device, see common/sensor_vcm.h */
 static int ov5693_s_ctrl(struct v4l2_ctrl *ctrl)
 {
-	struct ov5693_device *dev =
-	    container_of(ctrl->handler, struct ov5693_device, ctrl_handler);
-	struct i2c_client *client = v4l2_get_subdevdata(&dev->sd);
-	int ret = 0;
-
-	switch (ctrl->id) {
-	case V4L2_CID_FOCUS_ABSOLUTE:
-		dev_dbg(&client->dev, "%s: CID_FOCUS_ABSOLUTE:%d.\n",
-			__func__, ctrl->val);
-		ret = ov5693_t_focus_abs(&dev->sd, ctrl->val);
-		break;
-	case V4L2_CID_FOCUS_RELATIVE:
-		dev_dbg(&client->dev, "%s: CID_FOCUS_RELATIVE:%d.\n",
-			__func__, ctrl->val);
-		ret = ov5693_t_focus_rel(&dev->sd, ctrl->val);
-		break;
-	default:
-		ret = -EINVAL;
-	}
-	return ret;
+	return -EINVAL;
 }
 
 static int ov5693_g_volatile_ctrl(struct v4l2_ctrl *ctrl)
@@ -864,9 +768,6 @@ static int ov5693_g_volatile_ctrl(struct v4l2_ctrl *ctrl)
 	case V4L2_CID_EXPOSURE_ABSOLUTE:
 		ret = ov5693_q_exposure(&dev->sd, &ctrl->val);
 		break;
-	case V4L2_CID_FOCUS_ABSOLUTE:
-		/* NOTE: there was atomisp-specific function ov5693_q_focus_abs() */
-		break;
 	default:
 		ret = -EINVAL;
 	}
@@ -891,160 +792,54 @@ static const struct v4l2_ctrl_config ov5693_controls[] = {
 		.def = 0x00,
 		.flags = 0,
 	},
-	{
-		.ops = &ctrl_ops,
-		.id = V4L2_CID_FOCUS_ABSOLUTE,
-		.type = V4L2_CTRL_TYPE_INTEGER,
-		.name = "focus move absolute",
-		.min = 0,
-		.max = OV5693_VCM_MAX_FOCUS_POS,
-		.step = 1,
-		.def = 0,
-		.flags = 0,
-	},
-	{
-		.ops = &ctrl_ops,
-		.id = V4L2_CID_FOCUS_RELATIVE,
-		.type = V4L2_CTRL_TYPE_INTEGER,
-		.name = "focus move relative",
-		.min = OV5693_VCM_MAX_FOCUS_NEG,
-		.max = OV5693_VCM_MAX_FOCUS_POS,
-		.step = 1,
-		.def = 0,
-		.flags = 0,
-	},
 };
 
-static int ov5693_init(struct v4l2_subdev *sd)
-{
-	struct ov5693_device *dev = to_ov5693_sensor(sd);
-	struct i2c_client *client = v4l2_get_subdevdata(sd);
-	int ret;
-
-	if (!dev->has_vcm)
-		return 0;
-
-	dev_info(&client->dev, "%s\n", __func__);
-	mutex_lock(&dev->input_lock);
-	dev->vcm_update = false;
-
-	if (dev->vcm == VCM_AD5823) {
-		ret = vcm_ad_i2c_wr8(client, 0x01, 0x01); /* vcm init test */
-		if (ret)
-			dev_err(&client->dev,
-				"vcm reset failed\n");
-		/*change the mode*/
-		ret = ad5823_i2c_write(client, AD5823_REG_VCM_CODE_MSB,
-				       AD5823_RING_CTRL_ENABLE);
-		if (ret)
-			dev_err(&client->dev,
-				"vcm enable ringing failed\n");
-		ret = ad5823_i2c_write(client, AD5823_REG_MODE,
-				       AD5823_ARC_RES1);
-		if (ret)
-			dev_err(&client->dev,
-				"vcm change mode failed\n");
-	}
-
-	/*change initial focus value for ad5823*/
-	if (dev->vcm == VCM_AD5823) {
-		dev->focus = AD5823_INIT_FOCUS_POS;
-		ov5693_t_focus_abs(sd, AD5823_INIT_FOCUS_POS);
-	} else {
-		dev->focus = 0;
-		ov5693_t_focus_abs(sd, 0);
-	}
-
-	mutex_unlock(&dev->input_lock);
-
-	return 0;
-}
-
-/* Get GPIOs defined in dep_dev _CRS */
-static int gpio_crs_get(struct ov5693_device *sensor, struct device *dep_dev)
-{
-	sensor->xshutdn = devm_gpiod_get_index(dep_dev, NULL, 0, GPIOD_ASIS);
-	if (IS_ERR(sensor->xshutdn)) {
-		dev_err(dep_dev, "Couldn't get GPIO XSHUTDN\n");
-		return -EINVAL;
-	}
-
-	sensor->pwdnb = devm_gpiod_get_index(dep_dev, NULL, 1, GPIOD_ASIS);
-	if (IS_ERR(sensor->pwdnb)) {
-		dev_err(dep_dev, "Couldn't get GPIO PWDNB\n");
-		return -EINVAL;
-	}
-
-	sensor->led_gpio = devm_gpiod_get_index(dep_dev, NULL, 2, GPIOD_ASIS);
-	if (IS_ERR(sensor->led_gpio))
-		dev_info(dep_dev,
-			 "Couldn't get GPIO LED. Maybe not exist, continue anyway.\n");
-
-	return 0;
-}
-
-/* Put GPIOs defined in dep_dev _CRS */
-static void gpio_crs_put(struct ov5693_device *sensor)
-{
-	gpiod_put(sensor->xshutdn);
-	gpiod_put(sensor->pwdnb);
-	if (!IS_ERR(sensor->led_gpio))
-		gpiod_put(sensor->led_gpio);
-}
-
-/* Control GPIOs defined in dep_dev _CRS */
-static int gpio_crs_ctrl(struct v4l2_subdev *sd, bool flag)
-{
-	struct ov5693_device *sensor = to_ov5693_sensor(sd);
-
-	gpiod_set_value_cansleep(sensor->xshutdn, flag);
-	gpiod_set_value_cansleep(sensor->pwdnb, flag);
-	if (!IS_ERR(sensor->led_gpio))
-		gpiod_set_value_cansleep(sensor->led_gpio, flag);
-
-	return 0;
-}
-
 static int __power_up(struct v4l2_subdev *sd)
 {
 	struct i2c_client *client = v4l2_get_subdevdata(sd);
-	int ret;
-
-	ret = gpio_crs_ctrl(sd, true);
-	if (ret)
-		goto fail_power;
-
-	__cci_delay(up_delay);
-
-	return 0;
+	struct ov5693_device *dev = to_ov5693_sensor(sd);
 
-fail_power:
-	gpio_crs_ctrl(sd, false);
-	dev_err(&client->dev, "sensor power-up failed\n");
+	int3472_dep_set_power(dev->dep, true);
+	sensor_stats_power(&dev->stats, true);
 
-	return ret;
+	return sensor_settle_wait(client, OV5693_SC_CMMN_CHIP_ID_H,
+				  OV5693_ID >> 8, up_delay * 1000,
+				  &dev->settle, &dev->stats);
 }
 
 static int power_down(struct v4l2_subdev *sd)
 {
 	struct ov5693_device *dev = to_ov5693_sensor(sd);
 
-	dev->focus = OV5693_INVALID_CONFIG;
+	sensor_regcache_invalidate(&dev->regcache);
+	int3472_dep_set_power(dev->dep, false);
+	sensor_stats_power(&dev->stats, false);
 
-	return gpio_crs_ctrl(sd, false);
+	return 0;
 }
 
 static int power_up(struct v4l2_subdev *sd)
 {
 	static const int retry_count = 4;
+	struct ov5693_device *dev = to_ov5693_sensor(sd);
+	ktime_t start = ktime_get();
 	int i, ret;
 
 	for (i = 0; i < retry_count; i++) {
 		ret = __power_up(sd);
-		if (!ret)
+		if (!ret) {
+			sensor_stats_phase(&dev->stats, SENSOR_STATS_POWER_ON,
+					   start);
 			return 0;
+		}
 
 		power_down(sd);
+
+		/* a sensor that answered with a wrong ID won't do better */
+		if (ret == -ENODEV)
+			break;
+
+		sensor_stats_retry(&dev->stats, SENSOR_STATS_SETTLE);
 	}
 	return ret;
 }
@@ -1056,19 +851,25 @@ static int ov5693_s_power(struct v4l2_subdev *sd, int on)
 
 	dev_info(&client->dev, "%s: on %d\n", __func__, on);
 
-	if (on == 0)
-		return power_down(sd);
+	if (on == 0) {
+		pm_runtime_mark_last_busy(&client->dev);
+		pm_runtime_put_autosuspend(&client->dev);
+		return 0;
+	}
 
 	/* on == 1 */
-	ret = power_up(sd);
-	if (!ret) {
-		ret = ov5693_init(sd);
-		/* restore settings */
-		ov5693_res = ov5693_res_preview;
-		N_RES = N_RES_PREVIEW;
+	ret = pm_runtime_get_sync(&client->dev);
+	if (ret < 0) {
+		pm_runtime_put_noidle(&client->dev);
+		return ret;
 	}
 
-	return ret;
+	/* restore settings */
+	ov5693_res = ov5693_res_preview;
+	N_RES = N_RES_PREVIEW;
+	to_ov5693_sensor(sd)->programmed_idx = -1;
+
+	return 0;
 }
 
 /*
@@ -1155,10 +956,55 @@ static int get_resolution_index(int w, int h)
 }
 
 /* TODO: remove it. */
+static const struct sensor_burst_table ov5693_global_setting_packed_table =
+	SENSOR_BURST_TABLE(ov5693_global_setting_packed);
+
+/*
+ * The global table already enables the embedded line on the channel below,
+ * so this programs the same VC/DT that get_frame_desc reports and toggles
+ * the enable bit. The global table was just written, so the read is served
+ * from the register cache.
+ */
+static int ov5693_set_embedded_data(struct v4l2_subdev *sd, bool enable)
+{
+	struct ov5693_device *dev = to_ov5693_sensor(sd);
+	struct i2c_client *client = v4l2_get_subdevdata(sd);
+	u16 val;
+	int ret;
+
+	if (enable) {
+		ret = ov5693_write_reg(client, OV5693_8BIT,
+				       OV5693_MIPI_EMBEDDED_DT,
+				       (OV5693_EMBEDDED_VC << 6) |
+				       OV5693_EMBEDDED_DT);
+		if (ret)
+			return ret;
+	}
+
+	ret = ov5693_read_reg(client, OV5693_8BIT, OV5693_EMBEDDED_CTRL, &val);
+	if (ret)
+		return ret;
+
+	if (enable)
+		val |= OV5693_EMBEDDED_EN;
+	else
+		val &= ~OV5693_EMBEDDED_EN;
+
+	ret = ov5693_write_reg(client, OV5693_8BIT, OV5693_EMBEDDED_CTRL, val);
+	if (ret)
+		return ret;
+
+	dev->embedded_data = enable;
+
+	return 0;
+}
+
 static int startup(struct v4l2_subdev *sd)
 {
 	struct ov5693_device *dev = to_ov5693_sensor(sd);
 	struct i2c_client *client = v4l2_get_subdevdata(sd);
+	const struct ov5693_resolution *res = &ov5693_res[dev->fmt_idx];
+	ktime_t start = ktime_get();
 	int ret = 0;
 
 	ret = ov5693_write_reg(client, OV5693_8BIT,
@@ -1168,21 +1014,62 @@ static int startup(struct v4l2_subdev *sd)
 		return ret;
 	}
 
-	ret = ov5693_write_reg_array(client, ov5693_global_setting);
+	ret = sensor_burst_write(client, &ov5693_global_setting_packed_table,
+				 &dev->regcache, &dev->stats);
 	if (ret) {
 		dev_err(&client->dev, "ov5693 write register err.\n");
 		return ret;
 	}
+	sensor_stats_phase(&dev->stats, SENSOR_STATS_GLOBAL_REGS, start);
 
-	ret = ov5693_write_reg_array(client, ov5693_res[dev->fmt_idx].regs);
+	ret = ov5693_set_embedded_data(sd, embedded_data);
+	if (ret)
+		return ret;
+
+	start = ktime_get();
+	if (res->packed.data)
+		ret = sensor_burst_write(client, &res->packed, &dev->regcache,
+					 &dev->stats);
+	else
+		ret = ov5693_write_reg_array(client, res->regs);
 	if (ret) {
 		dev_err(&client->dev, "ov5693 write register err.\n");
 		return ret;
 	}
+	sensor_stats_phase(&dev->stats, SENSOR_STATS_MODE_REGS, start);
 
 	return ret;
 }
 
+/* Load ov5693_res[fmt_idx] into the sensor, with input_lock held */
+static int ov5693_program_mode(struct v4l2_subdev *sd)
+{
+	struct ov5693_device *dev = to_ov5693_sensor(sd);
+	struct i2c_client *client = v4l2_get_subdevdata(sd);
+	int ret = 0;
+	int cnt;
+
+	dev->programmed_idx = -1;
+
+	/* startup() begins with a software reset, so it can simply be retried */
+	for (cnt = 0; cnt < OV5693_POWER_UP_RETRY_NUM; cnt++) {
+		ret = startup(sd);
+		if (!ret)
+			break;
+
+		dev_err(&client->dev, " startup() FAILED!\n");
+		sensor_stats_retry(&dev->stats, SENSOR_STATS_TABLE);
+	}
+	if (ret) {
+		dev_err(&client->dev, "power up failed, gave up\n");
+		return ret;
+	}
+
+	dev->programmed_idx = dev->fmt_idx;
+
+	return 0;
+}
+
 static int ov5693_set_fmt(struct v4l2_subdev *sd,
 			  struct v4l2_subdev_pad_config *cfg,
 			  struct v4l2_subdev_format *format)
@@ -1192,7 +1079,6 @@ static int ov5693_set_fmt(struct v4l2_subdev *sd,
 	struct i2c_client *client = v4l2_get_subdevdata(sd);
 	int ret = 0;
 	int idx;
-	int cnt;
 
 	if (format->pad)
 		return -EINVAL;
@@ -1217,44 +1103,20 @@ static int ov5693_set_fmt(struct v4l2_subdev *sd,
 		goto mutex_unlock;
 	}
 
-	dev->fmt_idx = get_resolution_index(fmt->width, fmt->height);
-	if (dev->fmt_idx == -1) {
-		dev_err(&client->dev, "get resolution fail\n");
-		ret = -EINVAL;
+	if (dev->streaming) {
+		ret = -EBUSY;
 		goto mutex_unlock;
 	}
 
-	for (cnt = 0; cnt < OV5693_POWER_UP_RETRY_NUM; cnt++) {
-		power_down(sd);
-		ret = power_up(sd);
-		if (ret) {
-			dev_err(&client->dev, "power up failed\n");
-			continue;
-		}
-
-		mutex_unlock(&dev->input_lock);
-		ov5693_init(sd);
-		mutex_lock(&dev->input_lock);
-		ret = startup(sd);
-		if (ret)
-			dev_err(&client->dev, " startup() FAILED!\n");
-		else
-			break;
-	}
-	if (cnt == OV5693_POWER_UP_RETRY_NUM) {
-		dev_err(&client->dev, "power up failed, gave up\n");
+	idx = get_resolution_index(fmt->width, fmt->height);
+	if (idx == -1) {
+		dev_err(&client->dev, "get resolution fail\n");
+		ret = -EINVAL;
 		goto mutex_unlock;
 	}
 
-	/*
-	 * After sensor settings are set to HW, sometimes stream is started.
-	 * This would cause ISP timeout because ISP is not ready to receive
-	 * data yet. So add stop streaming here.
-	 */
-	ret = ov5693_write_reg(client, OV5693_8BIT, OV5693_SW_STREAM,
-			       OV5693_STOP_STREAMING);
-	if (ret)
-		dev_warn(&client->dev, "ov5693 stream off err\n");
+	/* The sensor is programmed by s_stream(1), only if the mode changed */
+	dev->fmt_idx = idx;
 
 mutex_unlock:
 	mutex_unlock(&dev->input_lock);
@@ -1321,84 +1183,125 @@ static int ov5693_s_stream(struct v4l2_subdev *sd, int enable)
 {
 	struct ov5693_device *dev = to_ov5693_sensor(sd);
 	struct i2c_client *client = v4l2_get_subdevdata(sd);
-	int ret;
+	ktime_t stream_start = ktime_get();
+	ktime_t start;
+	int ret = 0;
 
 	mutex_lock(&dev->input_lock);
 
-	/* power_on() here before streaming for regular PCs. */
-	if (enable) {
-		ret = power_up(sd);
-		if (ret) {
-			dev_err(&client->dev, "sensor power-up error\n");
-			power_down(sd);
-			goto out;
-		}
+	if (dev->streaming == !!enable)
+		goto out;
+
+	if (!enable) {
+		ret = ov5693_write_reg(client, OV5693_8BIT, OV5693_SW_STREAM,
+				       OV5693_STOP_STREAMING);
+		/* Keep the sensor powered for a quick restart */
+		pm_runtime_mark_last_busy(&client->dev);
+		pm_runtime_put_autosuspend(&client->dev);
+		dev->streaming = false;
+		goto out;
+	}
+
+	ret = pm_runtime_get_sync(&client->dev);
+	if (ret < 0) {
+		dev_err(&client->dev, "sensor power-up error\n");
+		pm_runtime_put_noidle(&client->dev);
+		goto out;
 	}
 
+	/*
+	 * Nothing to load if the sensor is still powered from a previous
+	 * stream with the same mode.
+	 */
+	if (dev->programmed_idx != dev->fmt_idx) {
+		ret = ov5693_program_mode(sd);
+		if (ret)
+			goto err_rpm_put;
+	}
+
+	/* embedded_data was changed while the mode stayed loaded */
+	if (dev->embedded_data != READ_ONCE(embedded_data)) {
+		ret = ov5693_set_embedded_data(sd, embedded_data);
+		if (ret)
+			goto err_rpm_put;
+	}
+
+	start = ktime_get();
 	ret = ov5693_write_reg(client, OV5693_8BIT, OV5693_SW_STREAM,
-			       enable ? OV5693_START_STREAMING :
-			       OV5693_STOP_STREAMING);
+			       OV5693_START_STREAMING);
+	if (ret)
+		goto err_rpm_put;
 
-	/* power_off() here after streaming for regular PCs. */
-	if (!enable)
-		power_down(sd);
+	sensor_stats_phase(&dev->stats, SENSOR_STATS_STREAM_ON, start);
+	sensor_stats_phase(&dev->stats, SENSOR_STATS_STREAM_START,
+			   stream_start);
+	dev->streaming = true;
+	goto out;
 
+err_rpm_put:
+	pm_runtime_put(&client->dev);
 out:
 	mutex_unlock(&dev->input_lock);
 
 	return ret;
 }
 
-static int ov5693_s_config(struct v4l2_subdev *sd, int irq)
+/* Must be called with the sensor powered up */
+static int ov5693_identify(struct v4l2_subdev *sd)
 {
 	struct ov5693_device *dev = to_ov5693_sensor(sd);
 	struct i2c_client *client = v4l2_get_subdevdata(sd);
-	int ret = 0;
+	int ret;
 
-	mutex_lock(&dev->input_lock);
-	/* power off the module, then power on it in future
-	 * as first power on by board may not fulfill the
-	 * power on sequqence needed by the module
-	 */
-	ret = power_down(sd);
+	if (dev->identified)
+		return 0;
+
+	/* config & detect sensor */
+	ret = ov5693_detect(client);
 	if (ret) {
-		dev_err(&client->dev, "ov5693 power-off err.\n");
-		goto fail_power_off;
+		dev_err(&client->dev, "ov5693_detect err.\n");
+		return ret;
 	}
 
-	ret = power_up(sd);
-	if (ret) {
-		dev_err(&client->dev, "ov5693 power-up err.\n");
-		goto fail_power_on;
+	/*
+	 * OTP contents never change, keep them across power cycles. Modules
+	 * with the calibration data in an EEPROM leave the OTP empty.
+	 */
+	if (!dev->has_ssdb || dev->rom_type == SENSOR_SSDB_ROM_OTP) {
+		dev->otp_data = ov5693_otp_read(sd);
+		if (IS_ERR(dev->otp_data)) {
+			dev->otp_data = NULL;
+			dev->otp_size = 0;
+		}
 	}
 
-	if (!dev->vcm)
-		dev->vcm = vcm_detect(client);
+	dev->identified = true;
 
-	/* config & detect sensor */
-	ret = ov5693_detect(client);
-	if (ret) {
-		dev_err(&client->dev, "ov5693_detect err s_config.\n");
-		goto fail_power_on;
-	}
+	return 0;
+}
 
-	dev->otp_data = ov5693_otp_read(sd);
+static int __maybe_unused ov5693_runtime_suspend(struct device *dev)
+{
+	struct v4l2_subdev *sd = i2c_get_clientdata(to_i2c_client(dev));
 
-	/* turn off sensor, after probed */
-	ret = power_down(sd);
-	if (ret) {
-		dev_err(&client->dev, "ov5693 power-off err.\n");
-		goto fail_power_on;
-	}
-	mutex_unlock(&dev->input_lock);
+	to_ov5693_sensor(sd)->programmed_idx = -1;
 
-	return ret;
+	return power_down(sd);
+}
+
+static int __maybe_unused ov5693_runtime_resume(struct device *dev)
+{
+	struct v4l2_subdev *sd = i2c_get_clientdata(to_i2c_client(dev));
+	int ret;
+
+	ret = power_up(sd);
+	if (ret)
+		return ret;
+
+	ret = ov5693_identify(sd);
+	if (ret)
+		power_down(sd);
 
-fail_power_on:
-	power_down(sd);
-	dev_err(&client->dev, "sensor power-gating failed\n");
-fail_power_off:
-	mutex_unlock(&dev->input_lock);
 	return ret;
 }
 
@@ -1441,6 +1344,51 @@ static int ov5693_enum_frame_size(struct v4l2_subdev *sd,
 	return 0;
 }
 
+/*
+ * The image on virtual channel 0 and, when enabled, the embedded line on
+ * OV5693_EMBEDDED_VC. A receiver capturing the embedded line gets the
+ * exposure and gain of each frame without reading them back over I2C.
+ */
+static int ov5693_get_frame_desc(struct v4l2_subdev *sd, unsigned int pad,
+				 struct v4l2_mbus_frame_desc *fd)
+{
+	struct ov5693_device *dev = to_ov5693_sensor(sd);
+	const struct ov5693_resolution *res;
+	struct v4l2_mbus_frame_desc_entry *entry;
+
+	if (pad)
+		return -EINVAL;
+
+	memset(fd, 0, sizeof(*fd));
+	fd->type = V4L2_MBUS_FRAME_DESC_TYPE_CSI2;
+
+	mutex_lock(&dev->input_lock);
+	res = &ov5693_res[dev->fmt_idx];
+
+	entry = &fd->entry[fd->num_entries++];
+	entry->flags = V4L2_MBUS_FRAME_DESC_FL_LEN_MAX;
+	entry->pixelcode = MEDIA_BUS_FMT_SBGGR10_1X10;
+	entry->length = res->width * res->height * 10 / 8;
+	entry->bus.csi2.vc = OV5693_IMAGE_VC;
+	entry->bus.csi2.dt = OV5693_IMAGE_DT;
+
+	/* What the next stream start will send */
+	if (READ_ONCE(embedded_data)) {
+		entry = &fd->entry[fd->num_entries++];
+		entry->flags = V4L2_MBUS_FRAME_DESC_FL_LEN_MAX;
+		entry->pixelcode = MEDIA_BUS_FMT_METADATA_FIXED;
+		/* one line, the registers are in its first bytes */
+		entry->length = max_t(u32, res->width * 10 / 8,
+				      ov5693_embedded_effective_size);
+		entry->bus.csi2.vc = OV5693_EMBEDDED_VC;
+		entry->bus.csi2.dt = OV5693_EMBEDDED_DT;
+	}
+
+	mutex_unlock(&dev->input_lock);
+
+	return 0;
+}
+
 static const struct v4l2_subdev_video_ops ov5693_video_ops = {
 	.s_stream = ov5693_s_stream,
 	.g_frame_interval = ov5693_g_frame_interval,
@@ -1455,6 +1403,7 @@ static const struct v4l2_subdev_pad_ops ov5693_pad_ops = {
 	.enum_frame_size = ov5693_enum_frame_size,
 	.get_fmt = ov5693_get_fmt,
 	.set_fmt = ov5693_set_fmt,
+	.get_frame_desc = ov5693_get_frame_desc,
 };
 
 static const struct v4l2_subdev_ops ov5693_ops = {
@@ -1470,10 +1419,22 @@ static int ov5693_remove(struct i2c_client *client)
 
 	dev_info(&client->dev, "%s...\n", __func__);
 
-	gpio_crs_put(ov5693);
+	pm_runtime_disable(&client->dev);
+	if (!pm_runtime_status_suspended(&client->dev))
+		power_down(sd);
+	pm_runtime_set_suspended(&client->dev);
+	pm_runtime_dont_use_autosuspend(&client->dev);
+
+	int3472_dep_put(ov5693->dep);
 
 	v4l2_async_unregister_subdev(sd);
 
+	v4l2_async_notifier_unregister(&ov5693->notifier);
+	v4l2_async_notifier_cleanup(&ov5693->notifier);
+	if (ov5693->vcm_client)
+		i2c_unregister_device(ov5693->vcm_client);
+
+	sensor_stats_exit(&ov5693->stats);
 	media_entity_cleanup(&ov5693->sd.entity);
 	v4l2_ctrl_handler_free(&ov5693->ctrl_handler);
 	kfree(ov5693);
@@ -1483,17 +1444,14 @@ static int ov5693_remove(struct i2c_client *client)
 
 static int ov5693_init_controls(struct ov5693_device *ov5693)
 {
-	struct i2c_client *client = v4l2_get_subdevdata(&ov5693->sd);
 	struct v4l2_ctrl *ctrl;
 	unsigned int i;
 	int ret;
 
 	ret = v4l2_ctrl_handler_init(&ov5693->ctrl_handler,
 				     ARRAY_SIZE(ov5693_controls));
-	if (ret) {
-		ov5693_remove(client);
+	if (ret)
 		return ret;
-	}
 
 	for (i = 0; i < ARRAY_SIZE(ov5693_controls); i++)
 		v4l2_ctrl_new_custom(&ov5693->ctrl_handler,
@@ -1512,8 +1470,9 @@ static int ov5693_init_controls(struct ov5693_device *ov5693)
 			  0, OV5693_PIXEL_RATE, 1, OV5693_PIXEL_RATE);
 
 	if (ov5693->ctrl_handler.error) {
-		ov5693_remove(client);
-		return ov5693->ctrl_handler.error;
+		ret = ov5693->ctrl_handler.error;
+		v4l2_ctrl_handler_free(&ov5693->ctrl_handler);
+		return ret;
 	}
 
 	/* Use same lock for controls as for everything else. */
@@ -1523,119 +1482,86 @@ static int ov5693_init_controls(struct ov5693_device *ov5693)
 	return 0;
 }
 
-/* Get acpi_device of dependent INT3472 device */
-static struct acpi_device *get_dep_adev(struct device *dev)
+static int ov5693_parse_ssdb(struct ov5693_device *dev,
+			     struct i2c_client *client,
+			     const struct sensor_ssdb *ssdb)
 {
-	struct acpi_handle *dev_handle;
-	struct acpi_device *sensor_adev;
-	struct acpi_handle_list dep_devices;
-	struct acpi_device *dep_adev;
-	acpi_status status;
-	const char *dep_hid = "INT3472";
-	int i;
-
-	sensor_adev = acpi_dev_get_first_match_dev(OV5693_HID, NULL, -1);
-	if (!sensor_adev) {
-		dev_err(dev, "Couldn't get sensor ACPI device\n");
-		return ERR_PTR(-ENODEV);
+	if (ssdb->lanes_used != OV5693_DATA_LANES) {
+		dev_err(&client->dev, "%u data lanes are not supported\n",
+			ssdb->lanes_used);
+		return -EINVAL;
 	}
-	dev_handle = sensor_adev->handle;
-	acpi_dev_put(sensor_adev);
 
-	if (!acpi_has_method(dev_handle, "_DEP")) {
-		dev_err(dev, "No _DEP entry found\n");
-		return ERR_PTR(-ENODEV);
-	}
+	if (ssdb->mclk_speed && ssdb->mclk_speed != OV5693_MCLK_FREQ)
+		dev_warn(&client->dev, "unexpected %u Hz external clock\n",
+			 ssdb->mclk_speed);
 
-	status = acpi_evaluate_reference(dev_handle, "_DEP", NULL, &dep_devices);
-	if (ACPI_FAILURE(status)) {
-		dev_err(dev, "Failed to evaluate _DEP.\n");
-		return ERR_PTR(-ENODEV);
+	if (ssdb->vcm_type != SENSOR_SSDB_VCM_NONE) {
+		dev->vcm_name = sensor_vcm_name(ssdb->vcm_type);
+		if (!dev->vcm_name)
+			dev_warn(&client->dev, "VCM type %u is not supported, no focus control\n",
+				 ssdb->vcm_type);
 	}
 
-	for (i = 0; i < dep_devices.count; i++) {
-		struct acpi_device_info *info;
-		int match;
+	dev->rom_type = ssdb->rom_type;
+	dev->has_ssdb = true;
 
-		status = acpi_get_object_info(dep_devices.handles[i], &info);
-		if (ACPI_FAILURE(status)) {
-			dev_dbg(dev,
-				"Error reading _DEP device info, continue next\n");
-			continue;
-		}
-
-		match = info->valid & ACPI_VALID_HID &&
-			!strcmp(info->hardware_id.string, dep_hid);
-
-		kfree(info);
+	dev_info(&client->dev, "SSDB: VCM type %u, NVM type %u, CSI-2 port %u\n",
+		 ssdb->vcm_type, ssdb->rom_type, ssdb->link_used);
 
-		if (!match)
-			continue;
-
-		if (acpi_bus_get_device(dep_devices.handles[i], &dep_adev)) {
-			dev_err(dev, "Error getting dependent ACPI device\n");
-			return ERR_PTR(-ENODEV);
-		}
-
-		/* found acpi_device of dependent device */
-		break;
-	}
-
-	if (!dep_adev) {
-		dev_err(dev, "Dependent ACPI device not found\n");
-		return ERR_PTR(-ENODEV);
-	}
-
-	dev_info(dev, "Dependent ACPI device found: %s\n",
-		 dev_name(&dep_adev->dev));
-
-	return dep_adev;
+	return 0;
 }
 
-/* Get dependent INT3472 device */
-static struct device *get_dep_dev(struct device *dev)
+/*
+ * The VCM gets a lens sub-device of its own, bound through the
+ * sub-notifier of the sensor. It is only added there once its driver is
+ * bound, anything else would keep the notifier, and so the whole camera
+ * graph, from completing. Without it the sensor has no focus control.
+ */
+static int ov5693_register_subdev(struct ov5693_device *ov5693,
+				  struct i2c_client *client)
 {
-	struct acpi_device *dep_adev;
-	struct acpi_device_physical_node *dep_phys;
+	struct i2c_client *vcm;
+	int ret;
 
-	dep_adev = get_dep_adev(dev);
-	if (!dep_adev) {
-		dev_err(dev, "get_dep_adev() failed\n");
-		return ERR_PTR(-ENODEV);
+	if (ov5693->vcm_name) {
+		vcm = sensor_vcm_new(client, ov5693->vcm_name);
+		if (IS_ERR(vcm)) {
+			dev_warn(&client->dev, "VCM not bound, no focus control: %ld\n",
+				 PTR_ERR(vcm));
+		} else {
+			ov5693->vcm_client = vcm;
+			ret = sensor_vcm_notifier_add(&ov5693->notifier, vcm);
+			if (ret)
+				goto err_cleanup;
+		}
 	}
 
-	/*
-	 * HACK: We know that the PMIC is a "discrete" PMIC, an ACPI device
-	 * that just serves as a container to list system GPIOs.
-	 *
-	 * The ACPI device has no fwnode, nor does it have a platform device.
-	 * This prevents fetching GPIOs. It however seems to be backed by the
-	 * PCI root complex (pci0000:00/0000:00:00.0) as its physical device,
-	 * and that device has its fwnode set to \_SB.PCI0.DSC1. Whether this
-	 * is correct or not is unknown, let's just get the physical device and
-	 * move on for now.
-	 *
-	 * (@kitakar5525)This is observed on Microsoft Surface Go series
-	 * and Acer Switch Alpha 12.
-	 */
-	dep_phys = list_first_entry_or_null(&dep_adev->physical_node_list,
-					    struct acpi_device_physical_node,
-					    node);
-	if (!dep_phys) {
-		dev_info(dev,
-			 "Error getting physical node of dependent device\n");
-		return ERR_PTR(-ENODEV);
+	ret = v4l2_async_subdev_notifier_register(&ov5693->sd,
+						  &ov5693->notifier);
+	if (ret)
+		goto err_cleanup;
+
+	ret = v4l2_async_register_subdev(&ov5693->sd);
+	if (ret) {
+		v4l2_async_notifier_unregister(&ov5693->notifier);
+		goto err_cleanup;
 	}
 
-	dev_info(dev, "Dependent device found: %s\n", dev_name(dep_phys->dev));
+	return 0;
 
-	return dep_phys->dev;
+err_cleanup:
+	v4l2_async_notifier_cleanup(&ov5693->notifier);
+	if (ov5693->vcm_client)
+		i2c_unregister_device(ov5693->vcm_client);
+	ov5693->vcm_client = NULL;
+	return ret;
 }
 
 static int ov5693_probe(struct i2c_client *client)
 {
 	struct ov5693_device *ov5693;
-	struct device *dep_dev;
+	struct sensor_ssdb ssdb;
 	int ret = 0;
 
 	dev_info(&client->dev, "%s() called", __func__);
@@ -1644,31 +1570,48 @@ static int ov5693_probe(struct i2c_client *client)
 	if (!ov5693)
 		return -ENOMEM;
 
-	/* check if VCM device exists */
-	/* TODO: read from SSDB */
-	ov5693->has_vcm = false;
+	/* Without SSDB, the VCM type is unknown and there is no lens */
+	if (!sensor_ssdb_read(&client->dev, &ssdb)) {
+		ret = ov5693_parse_ssdb(ov5693, client, &ssdb);
+		if (ret) {
+			kfree(ov5693);
+			return ret;
+		}
+	}
 
 	mutex_init(&ov5693->input_lock);
+	v4l2_async_notifier_init(&ov5693->notifier);
+	ov5693->programmed_idx = -1;
 
 	v4l2_i2c_subdev_init(&ov5693->sd, client, &ov5693_ops);
+	sensor_stats_init(&ov5693->stats, &client->dev, &ov5693->settle);
 
-	ov5693->dep_dev = get_dep_dev(&client->dev);
-	if (IS_ERR(ov5693->dep_dev)) {
-		ret = PTR_ERR(ov5693->dep_dev);
-		dev_err(&client->dev, "cannot get dep_dev: ret %d\n", ret);
-		return ret;
-	}
-	dep_dev = ov5693->dep_dev;
+	ret = sensor_regcache_init(&client->dev, &ov5693->regcache,
+				   OV5693_REGCACHE_MAX_REG,
+				   ov5693_volatile_regs,
+				   ARRAY_SIZE(ov5693_volatile_regs));
+	if (ret)
+		goto out_free;
 
-	ret = gpio_crs_get(ov5693, dep_dev);
-	if (ret) {
-		dev_err(dep_dev, "Failed to get _CRS GPIOs\n");
-		return ret;
+	ov5693->dep = int3472_dep_get(&client->dev);
+	if (IS_ERR(ov5693->dep)) {
+		ret = PTR_ERR(ov5693->dep);
+		dev_err(&client->dev, "cannot get dependent device: ret %d\n",
+			ret);
+		goto out_free;
 	}
 
-	ret = ov5693_s_config(&ov5693->sd, client->irq);
-	if (ret)
-		goto out_free;
+	/*
+	 * Only put the module into a known off state, the power up by the
+	 * firmware may not have followed the sequence it needs. The sensor
+	 * is identified on the first power up.
+	 */
+	power_down(&ov5693->sd);
+
+	pm_runtime_set_autosuspend_delay(&client->dev,
+					 OV5693_AUTOSUSPEND_DELAY_MS);
+	pm_runtime_use_autosuspend(&client->dev);
+	pm_runtime_enable(&client->dev);
 
 	ov5693->sd.flags |= V4L2_SUBDEV_FL_HAS_DEVNODE;
 	ov5693->pad.flags = MEDIA_PAD_FL_SOURCE;
@@ -1677,13 +1620,13 @@ static int ov5693_probe(struct i2c_client *client)
 
 	ret = ov5693_init_controls(ov5693);
 	if (ret)
-		ov5693_remove(client);
+		goto err_pm_disable;
 
 	ret = media_entity_pads_init(&ov5693->sd.entity, 1, &ov5693->pad);
 	if (ret)
-		ov5693_remove(client);
+		goto err_free_ctrls;
 
-	ret = v4l2_async_register_subdev_sensor_common(&ov5693->sd);
+	ret = ov5693_register_subdev(ov5693, client);
 	if (ret) {
 		dev_err(&client->dev, "failed to register V4L2 subdev: %d", ret);
 		goto media_entity_cleanup;
@@ -1693,8 +1636,14 @@ static int ov5693_probe(struct i2c_client *client)
 
 media_entity_cleanup:
 	media_entity_cleanup(&ov5693->sd.entity);
+err_free_ctrls:
+	v4l2_ctrl_handler_free(&ov5693->ctrl_handler);
+err_pm_disable:
+	pm_runtime_disable(&client->dev);
+	pm_runtime_dont_use_autosuspend(&client->dev);
+	int3472_dep_put(ov5693->dep);
 out_free:
-	v4l2_async_unregister_subdev(&ov5693->sd);
+	sensor_stats_exit(&ov5693->stats);
 	kfree(ov5693);
 	return ret;
 }
@@ -1705,9 +1654,16 @@ static const struct acpi_device_id ov5693_acpi_match[] = {
 };
 MODULE_DEVICE_TABLE(acpi, ov5693_acpi_match);
 
+static const struct dev_pm_ops ov5693_pm_ops = {
+	SET_RUNTIME_PM_OPS(ov5693_runtime_suspend, ov5693_runtime_resume, NULL)
+};
+
 static struct i2c_driver ov5693_driver = {
 	.driver = {
 		.name = "ov5693",
+		.pm = &ov5693_pm_ops,
+		.dev_groups = ov5693_attr_groups,
+		.probe_type = PROBE_PREFER_ASYNCHRONOUS,
 		.acpi_match_table = ov5693_acpi_match,
 	},
 	.probe_new = ov5693_probe,
@@ -1717,3 +1673,5 @@ module_i2c_driver(ov5693_driver);
 
 MODULE_DESCRIPTION("A low-level driver for OmniVision 5693 sensors");
 MODULE_LICENSE("GPL");
+/* the lens driver must be bound before probe instantiates the VCM */
+MODULE_SOFTDEP("pre: sensor_vcm");
@@ -30,6 +30,14 @@
 #include <linux/v4l2-mediabus.h>
 #include <media/media-entity.h>
 
+#include "int3472_dep.h"
+#include "sensor_regcache.h"
+#include "sensor_settle.h"
+#include "sensor_ssdb.h"
+#include "sensor_stats.h"
+#include "sensor_vcm.h"
+#include "ov5693_regs_packed.h"
+
 #define OV5693_HID "INT33BE"
 
 /*
@@ -39,6 +47,9 @@
 
 #define OV5693_POWER_UP_RETRY_NUM 5
 
+/* Default runtime PM autosuspend delay, see power/autosuspend_delay_ms */
+#define OV5693_AUTOSUSPEND_DELAY_MS	1000
+
 /* Defines for register writes and register array processing */
 #define I2C_MSG_LENGTH		0x2
 #define I2C_RETRY_COUNT		5
@@ -99,6 +110,9 @@
 #define OV5693_SC_CMMN_SUB_ID			0x302A /* process, version*/
 /*Bit[7:4] Group control, Bit[3:0] Group ID*/
 #define OV5693_GROUP_ACCESS			0x3208
+
+/* Highest register address kept in the register cache */
+#define OV5693_REGCACHE_MAX_REG			0x5fff
 /*
 *Bit[3:0] Bit[19:16] of exposure,
 *remaining 16 bits lies in Reg0x3501&Reg0x3502
@@ -131,6 +145,19 @@
 /*High 8-bit, and low 8-bit HTS address is 0x380f*/
 #define OV5693_TIMING_VTS_L			0x380f
 
+/*
+ * Embedded data, a line sent ahead of the image on its own virtual channel
+ * with the exposure, gain and frame counter the frame was captured with.
+ */
+#define OV5693_EMBEDDED_CTRL			0x4307
+#define OV5693_EMBEDDED_EN			BIT(0)
+/*Bit[7:6] virtual channel, Bit[5:0] data type of the embedded line*/
+#define OV5693_MIPI_EMBEDDED_DT			0x4816
+#define OV5693_EMBEDDED_VC			1
+#define OV5693_EMBEDDED_DT			0x12
+#define OV5693_IMAGE_VC				0
+#define OV5693_IMAGE_DT				0x2b /* RAW10 */
+
 #define OV5693_MWB_RED_GAIN_H			0x3400
 #define OV5693_MWB_GREEN_GAIN_H			0x3402
 #define OV5693_MWB_BLUE_GAIN_H			0x3404
@@ -139,9 +166,6 @@
 #define OV5693_START_STREAMING			0x01
 #define OV5693_STOP_STREAMING			0x00
 
-#define VCM_ADDR           0x0c
-#define VCM_CODE_MSB       0x04
-
 #define OV5693_INVALID_CONFIG	0xffffffff
 
 #define OV5693_VCM_SLEW_STEP			0x30F0
@@ -152,21 +176,6 @@
 #define OV5693_VCM_SLEW_TIME_MAX		0xffff
 #define OV5693_VCM_ENABLE			0x8000
 
-#define OV5693_VCM_MAX_FOCUS_NEG       -1023
-#define OV5693_VCM_MAX_FOCUS_POS       1023
-
-#define DLC_ENABLE 1
-#define DLC_DISABLE 0
-#define VCM_PROTECTION_OFF     0xeca3
-#define VCM_PROTECTION_ON      0xdc51
-#define VCM_DEFAULT_S 0x0
-#define vcm_step_s(a) (u8)(a & 0xf)
-#define vcm_step_mclk(a) (u8)((a >> 4) & 0x3)
-#define vcm_dlc_mclk(dlc, mclk) (u16)((dlc << 3) | mclk | 0xa104)
-#define vcm_tsrc(tsrc) (u16)(tsrc << 3 | 0xf200)
-#define vcm_val(data, s) (u16)(data << 4 | s)
-#define DIRECT_VCM vcm_dlc_mclk(0, 0)
-
 /* Defines for OTP Data Registers */
 #define OV5693_FRAME_OFF_NUM		0x4202
 #define OV5693_OTP_BYTE_MAX		32	//change to 32 as needed by otpdata
@@ -183,9 +192,14 @@
 #define OV5693_OTP_READ_ONETIME		16
 #define OV5693_OTP_MODE_READ		1
 
+/* the register tables are made for a 2 lane link and a 19.2MHz clock */
+#define OV5693_DATA_LANES 2
+#define OV5693_MCLK_FREQ 19200000
+
 /* link freq and pixel rate required for IPU3 */
 #define OV5693_LINK_FREQ_19MHZ 19200000
-#define OV5693_PIXEL_RATE ((OV5693_LINK_FREQ_19MHZ * 2 * 2) / 10)
+#define OV5693_PIXEL_RATE \
+	((OV5693_LINK_FREQ_19MHZ * 2 * OV5693_DATA_LANES) / 10)
 static const s64 link_freq_menu_items[] = {
 	OV5693_LINK_FREQ_19MHZ
 };
@@ -198,6 +212,8 @@ struct regval_list {
 struct ov5693_resolution {
 	u8 *desc;
 	const struct ov5693_reg *regs;
+	/* regs pre-coalesced by misc/pack_sensor_regs, if available */
+	struct sensor_burst_table packed;
 	int res;
 	int width;
 	int height;
@@ -217,12 +233,6 @@ struct ov5693_format {
 	struct ov5693_reg *regs;
 };
 
-enum vcm_type {
-	VCM_UNKNOWN,
-	VCM_AD5823,
-	VCM_DW9714,
-};
-
 /*
  * ov5693 device structure.
  */
@@ -234,30 +244,45 @@ struct ov5693_device {
 	struct v4l2_ctrl_handler ctrl_handler;
 
 	struct camera_sensor_platform_data *platform_data;
-	ktime_t timestamp_t_focus_abs;
 	int vt_pix_clk_freq_mhz;
 	int fmt_idx;
 	int run_mode;
 	int otp_size;
 	u8 *otp_data;
-	u32 focus;
-	s16 number_of_steps;
 	u8 res;
 	u8 type;
-	bool vcm_update;
-	enum vcm_type vcm;
-
-	/* dependent device (PMIC) */
-	struct device *dep_dev;
 
-	/* GPIOs defined in dep_dev _CRS. The last "led_gpio" may not exist
-	 * depending on devices.
+	/* I2C device name of the VCM from SSDB, NULL without one */
+	const char *vcm_name;
+	/* the VCM, driven by its own lens sub-device */
+	struct i2c_client *vcm_client;
+	/* binds the lens sub-device */
+	struct v4l2_async_notifier notifier;
+
+	bool streaming;
+	/* ov5693_res index loaded in the sensor, -1 after power off */
+	int programmed_idx;
+	/* embedded data line enabled in the sensor */
+	bool embedded_data;
+
+	/* shadow of the sensor registers, protected by input_lock */
+	struct sensor_regcache regcache;
+	/* time the sensor took to answer after power-on */
+	struct sensor_settle settle;
+	/* I2C and stream start statistics, in debugfs */
+	struct sensor_stats stats;
+
+	/* dependent device (PMIC) holding the power GPIOs */
+	struct int3472_dep *dep;
+
+	/*
+	 * Chip ID checked and OTP read. Done on the first power up instead
+	 * of at probe, so probing doesn't need to power the sensor.
 	 */
-	struct gpio_desc *xshutdn;
-	struct gpio_desc *pwdnb;
-	struct gpio_desc *led_gpio;
-
-	bool has_vcm;
+	bool identified;
+	/* NVM type came from SSDB, don't probe for it */
+	bool has_ssdb;
+	u8 rom_type;
 };
 
 enum ov5693_tok_type {
@@ -1133,6 +1158,7 @@ static struct ov5693_resolution ov5693_res_preview[] = {
 		.bin_factor_y = 1,
 		.bin_mode = 0,
 		.regs = ov5693_736x496_30fps,
+		.packed = SENSOR_BURST_TABLE(ov5693_736x496_30fps_packed),
 	},
 	{
 		.desc = "ov5693_1616x1216_30fps",
@@ -1147,6 +1173,7 @@ static struct ov5693_resolution ov5693_res_preview[] = {
 		.bin_factor_y = 1,
 		.bin_mode = 0,
 		.regs = ov5693_1616x1216_30fps,
+		.packed = SENSOR_BURST_TABLE(ov5693_1616x1216_30fps_packed),
 	},
 	{
 		.desc = "ov5693_5M_30fps",
@@ -1161,6 +1188,7 @@ static struct ov5693_resolution ov5693_res_preview[] = {
 		.bin_factor_y = 1,
 		.bin_mode = 0,
 		.regs = ov5693_2576x1456_30fps,
+		.packed = SENSOR_BURST_TABLE(ov5693_2576x1456_30fps_packed),
 	},
 	{
 		.desc = "ov5693_5M_30fps",
@@ -1175,6 +1203,7 @@ static struct ov5693_resolution ov5693_res_preview[] = {
 		.bin_factor_y = 1,
 		.bin_mode = 0,
 		.regs = ov5693_2576x1936_30fps,
+		.packed = SENSOR_BURST_TABLE(ov5693_2576x1936_30fps_packed),
 	},
 };
 
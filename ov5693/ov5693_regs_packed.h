@@ -0,0 +1,293 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+/*
+ * Generated by misc/pack_sensor_regs/pack_sensor_regs.py from ov5693.h.
+ * Do not edit, regenerate after changing the register tables.
+ */
+
+#ifndef __OV5693_REGS_PACKED_H__
+#define __OV5693_REGS_PACKED_H__
+
+#include "sensor_burst.h"
+
+/* 227 entries, 97 messages */
+static const u8 ov5693_global_setting_packed[] = {
+	3, 0x01, 0x03,
+		0x01,
+	4, 0x30, 0x01,
+		0x0a, 0x80,
+	3, 0x30, 0x06,
+		0x00,
+	10, 0x30, 0x11,
+		0x21, 0x09, 0x10, 0x00, 0x08, 0xf0, 0xf0, 0xf0,
+	3, 0x30, 0x1b,
+		0xb4,
+	3, 0x30, 0x1d,
+		0x02,
+	4, 0x30, 0x21,
+		0x00, 0x01,
+	3, 0x30, 0x28,
+		0x44,
+	7, 0x30, 0x98,
+		0x02, 0x19, 0x02, 0x01, 0x00,
+	3, 0x30, 0xa0,
+		0xd2,
+	3, 0x30, 0xa2,
+		0x01,
+	7, 0x30, 0xb2,
+		0x00, 0x7d, 0x03, 0x04, 0x01,
+	3, 0x31, 0x04,
+		0x21,
+	3, 0x31, 0x06,
+		0x00,
+	9, 0x34, 0x00,
+		0x04, 0x00, 0x04, 0x00, 0x04, 0x00, 0x01,
+	3, 0x35, 0x00,
+		0x00,
+	11, 0x35, 0x03,
+		0x07, 0x00, 0x00, 0x00, 0x02, 0x00, 0x10, 0x00,
+		0x40,
+	4, 0x36, 0x01,
+		0x0a, 0x38,
+	3, 0x36, 0x12,
+		0x80,
+	5, 0x36, 0x20,
+		0x54, 0xc7, 0x0f,
+	3, 0x36, 0x25,
+		0x10,
+	7, 0x36, 0x30,
+		0x55, 0xf4, 0x00, 0x34, 0x02,
+	3, 0x36, 0x4d,
+		0x0d,
+	3, 0x36, 0x4f,
+		0xdd,
+	3, 0x36, 0x60,
+		0x04,
+	4, 0x36, 0x62,
+		0x10, 0xf1,
+	5, 0x36, 0x65,
+		0x00, 0x20, 0x00,
+	3, 0x36, 0x6a,
+		0x80,
+	4, 0x36, 0x80,
+		0xe0, 0x00,
+	8, 0x37, 0x00,
+		0x42, 0x14, 0xa0, 0xd8, 0x78, 0x02,
+	9, 0x37, 0x0a,
+		0x00, 0x20, 0x0c, 0x11, 0x00, 0x40, 0x00,
+	5, 0x37, 0x1a,
+		0x1c, 0x05, 0x01,
+	4, 0x37, 0x1e,
+		0xa1, 0x0c,
+	3, 0x37, 0x21,
+		0x00,
+	3, 0x37, 0x24,
+		0x10,
+	3, 0x37, 0x26,
+		0x00,
+	3, 0x37, 0x2a,
+		0x01,
+	3, 0x37, 0x30,
+		0x10,
+	7, 0x37, 0x38,
+		0x22, 0xe5, 0x50, 0x02, 0x41,
+	8, 0x37, 0x3f,
+		0x02, 0x42, 0x02, 0x18, 0x01, 0x02,
+	3, 0x37, 0x47,
+		0x10,
+	3, 0x37, 0x4c,
+		0x04,
+	8, 0x37, 0x51,
+		0xf0, 0x00, 0x00, 0xc0, 0x00, 0x1a,
+	4, 0x37, 0x58,
+		0x00, 0x0f,
+	3, 0x37, 0x5c,
+		0x04,
+	3, 0x37, 0x6b,
+		0x44,
+	3, 0x37, 0x74,
+		0x10,
+	3, 0x37, 0x76,
+		0x00,
+	5, 0x37, 0x7f,
+		0x08, 0x22, 0x0c,
+	4, 0x37, 0x84,
+		0x2c, 0x1e,
+	3, 0x37, 0x8f,
+		0xf5,
+	3, 0x37, 0x91,
+		0xb0,
+	10, 0x37, 0x95,
+		0x00, 0x64, 0x11, 0x30, 0x41, 0x07, 0xb0, 0x0c,
+	5, 0x37, 0xc5,
+		0x00, 0x00, 0x00,
+	5, 0x37, 0xc9,
+		0x00, 0x00, 0x00,
+	4, 0x37, 0xde,
+		0x00, 0x00,
+	5, 0x38, 0x00,
+		0x00, 0x00, 0x00,
+	4, 0x38, 0x04,
+		0x0a, 0x3f,
+	3, 0x38, 0x10,
+		0x00,
+	3, 0x38, 0x12,
+		0x00,
+	7, 0x38, 0x23,
+		0x00, 0x00, 0x00, 0x00, 0x00,
+	3, 0x38, 0x2a,
+		0x04,
+	6, 0x3a, 0x04,
+		0x06, 0x14, 0x00, 0xfe,
+	3, 0x3b, 0x00,
+		0x00,
+	6, 0x3b, 0x02,
+		0x00, 0x00, 0x00, 0x00,
+	3, 0x3e, 0x07,
+		0x20,
+	5, 0x40, 0x00,
+		0x08, 0x04, 0x45,
+	5, 0x40, 0x04,
+		0x08, 0x18, 0x20,
+	4, 0x40, 0x08,
+		0x24, 0x10,
+	4, 0x40, 0x0c,
+		0x00, 0x00,
+	4, 0x40, 0x4e,
+		0x37, 0x8f,
+	3, 0x40, 0x58,
+		0x00,
+	3, 0x41, 0x01,
+		0xb2,
+	4, 0x43, 0x03,
+		0x00, 0x08,
+	3, 0x43, 0x07,
+		0x31,
+	3, 0x43, 0x11,
+		0x04,
+	3, 0x43, 0x15,
+		0x01,
+	4, 0x45, 0x11,
+		0x05, 0x01,
+	3, 0x48, 0x06,
+		0x00,
+	3, 0x48, 0x16,
+		0x52,
+	3, 0x48, 0x1f,
+		0x30,
+	3, 0x48, 0x26,
+		0x2c,
+	3, 0x48, 0x31,
+		0x64,
+	3, 0x48, 0x37,
+		0x0a,
+	8, 0x4d, 0x00,
+		0x04, 0x71, 0xfd, 0xf5, 0x0c, 0xcc,
+	4, 0x50, 0x00,
+		0x06, 0x01,
+	3, 0x50, 0x03,
+		0x20,
+	3, 0x50, 0x13,
+		0x00,
+	3, 0x50, 0x46,
+		0x0a,
+	3, 0x57, 0x80,
+		0x1c,
+	5, 0x57, 0x86,
+		0x20, 0x10, 0x18,
+	5, 0x57, 0x8a,
+		0x04, 0x02, 0x02,
+	6, 0x57, 0x8e,
+		0x06, 0x02, 0x02, 0xff,
+	10, 0x58, 0x42,
+		0x01, 0x2b, 0x01, 0x92, 0x01, 0x8f, 0x01, 0x0c,
+	3, 0x5e, 0x00,
+		0x00,
+	3, 0x5e, 0x10,
+		0x0c,
+	3, 0x01, 0x00,
+		0x00,
+};
+
+/* 31 entries, 7 messages */
+static const u8 ov5693_736x496_30fps_packed[] = {
+	4, 0x35, 0x01,
+		0x3b, 0x80,
+	4, 0x37, 0x08,
+		0xe2, 0xc3,
+	24, 0x38, 0x00,
+		0x00, 0x02, 0x00, 0x62, 0x0a, 0x3b, 0x07, 0x43,
+		0x02, 0xe0, 0x01, 0xf0, 0x0a, 0x80, 0x07, 0xc0,
+		0x00, 0x02, 0x00, 0x00, 0x11, 0x11,
+	4, 0x38, 0x20,
+		0x00, 0x1e,
+	3, 0x50, 0x02,
+		0x00,
+	3, 0x50, 0x41,
+		0x84,
+	3, 0x01, 0x00,
+		0x01,
+};
+
+/* 31 entries, 7 messages */
+static const u8 ov5693_1616x1216_30fps_packed[] = {
+	4, 0x35, 0x01,
+		0x7b, 0x80,
+	4, 0x37, 0x08,
+		0xe2, 0xc3,
+	24, 0x38, 0x00,
+		0x00, 0x08, 0x00, 0x04, 0x0a, 0x37, 0x07, 0x9f,
+		0x06, 0x50, 0x04, 0xc0, 0x0a, 0x80, 0x07, 0xc0,
+		0x00, 0x10, 0x00, 0x06, 0x11, 0x11,
+	4, 0x38, 0x20,
+		0x00, 0x1e,
+	3, 0x50, 0x02,
+		0x00,
+	3, 0x50, 0x41,
+		0x84,
+	3, 0x01, 0x00,
+		0x01,
+};
+
+/* 27 entries, 7 messages */
+static const u8 ov5693_2576x1456_30fps_packed[] = {
+	4, 0x35, 0x01,
+		0x7b, 0x00,
+	4, 0x37, 0x08,
+		0xe2, 0xc3,
+	18, 0x38, 0x00,
+		0x00, 0x00, 0x00, 0xf0, 0x0a, 0x3f, 0x06, 0xa4,
+		0x0a, 0x10, 0x05, 0xb0, 0x0a, 0x80, 0x07, 0xc0,
+	3, 0x38, 0x11,
+		0x18,
+	5, 0x38, 0x13,
+		0x00, 0x11, 0x11,
+	4, 0x38, 0x20,
+		0x00, 0x1e,
+	3, 0x50, 0x02,
+		0x00,
+};
+
+/* 23 entries, 9 messages */
+static const u8 ov5693_2576x1936_30fps_packed[] = {
+	4, 0x35, 0x01,
+		0x7b, 0x00,
+	4, 0x37, 0x08,
+		0xe2, 0xc3,
+	3, 0x38, 0x03,
+		0x00,
+	12, 0x38, 0x06,
+		0x07, 0xa3, 0x0a, 0x10, 0x07, 0x90, 0x0a, 0x80,
+		0x07, 0xc0,
+	3, 0x38, 0x11,
+		0x18,
+	5, 0x38, 0x13,
+		0x00, 0x11, 0x11,
+	4, 0x38, 0x20,
+		0x00, 0x1e,
+	3, 0x50, 0x02,
+		0x00,
+	3, 0x01, 0x00,
+		0x01,
+};
+
+#endif /* __OV5693_REGS_PACKED_H__ */
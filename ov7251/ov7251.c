@@ -11,33 +11,61 @@
 #include <linux/clk.h>
 #include <linux/delay.h>
 #include <linux/device.h>
+#include <linux/gcd.h>
 #include <linux/gpio/consumer.h>
 #include <linux/i2c.h>
 #include <linux/init.h>
 #include <linux/module.h>
+#include <linux/pm_runtime.h>
 #include <linux/regulator/consumer.h>
 #include <linux/slab.h>
 #include <linux/types.h>
+#include <linux/workqueue.h>
 #include <media/v4l2-ctrls.h>
 #include <media/v4l2-fwnode.h>
 #include <media/v4l2-subdev.h>
 
+#include "int3472_dep.h"
+#include "sensor_regcache.h"
+#include "sensor_settle.h"
+#include "sensor_ssdb.h"
+#include "sensor_stats.h"
+#include "ov7251_regs_packed.h"
+
 #define OV7251_ACPI_HID "INT347E"
+#define OV7251_ACPI_XCLK_FREQ 19200000
+#define OV7251_DATA_LANES 1
+/* upper bound of the wait for the sensor to answer after power-on */
+#define OV7251_SETTLE_TIMEOUT_US 50000
 
 #define OV7251_SC_MODE_SELECT		0x0100
 #define OV7251_SC_MODE_SELECT_SW_STANDBY	0x0
 #define OV7251_SC_MODE_SELECT_STREAMING		0x1
+#define OV7251_SC_SOFTWARE_RESET	0x0103
+#define OV7251_SC_SOFTWARE_RESET_BIT	BIT(0)
 
 #define OV7251_CHIP_ID_HIGH		0x300a
 #define OV7251_CHIP_ID_HIGH_BYTE	0x77
 #define OV7251_CHIP_ID_LOW		0x300b
 #define OV7251_CHIP_ID_LOW_BYTE		0x50
 #define OV7251_SC_GP_IO_IN1		0x3029
+#define OV7251_GROUP_ACCESS		0x3208
+#define OV7251_GROUP_ACCESS_START	0x00
+#define OV7251_GROUP_ACCESS_END		0x10
+#define OV7251_GROUP_ACCESS_LAUNCH	0xa0
 #define OV7251_AEC_EXPO_0		0x3500
 #define OV7251_AEC_EXPO_1		0x3501
 #define OV7251_AEC_EXPO_2		0x3502
 #define OV7251_AEC_AGC_ADJ_0		0x350a
 #define OV7251_AEC_AGC_ADJ_1		0x350b
+#define OV7251_TIMING_VTS		0x380e
+#define OV7251_TIMING_VTS_MAX		0xffff
+/* shortest frame of the mode tables, the 90 fps one */
+#define OV7251_TIMING_VTS_MIN		572
+/* line length of all the mode tables */
+#define OV7251_TIMING_HTS		928
+/* lines of a frame the exposure can't cover */
+#define OV7251_EXPOSURE_MARGIN		20
 #define OV7251_TIMING_FORMAT1		0x3820
 #define OV7251_TIMING_FORMAT1_VFLIP	BIT(2)
 #define OV7251_TIMING_FORMAT2		0x3821
@@ -45,6 +73,12 @@
 #define OV7251_PRE_ISP_00		0x5e00
 #define OV7251_PRE_ISP_00_TEST_PATTERN	BIT(7)
 
+/* Highest register address kept in the register cache */
+#define OV7251_REGCACHE_MAX_REG		0x5fff
+
+/* Default runtime PM autosuspend delay, see power/autosuspend_delay_ms */
+#define OV7251_AUTOSUSPEND_DELAY_MS	1000
+
 struct reg_value {
 	u16 reg;
 	u8 val;
@@ -55,9 +89,11 @@ struct ov7251_mode_info {
 	u32 height;
 	const struct reg_value *data;
 	u32 data_size;
+	struct sensor_burst_table data_packed;
 	u32 pixel_clock;
 	u32 link_freq;
-	u16 exposure_max;
+	/* default frame length, VTS can be changed through VBLANK */
+	u16 vts;
 	u16 exposure_def;
 	struct v4l2_fract timeperframe;
 };
@@ -79,34 +115,40 @@ struct ov7251 {
 	struct regulator *analog_regulator;
 
 	const struct ov7251_mode_info *current_mode;
+	/* mode loaded in the sensor, NULL after power off */
+	const struct ov7251_mode_info *programmed_mode;
 
 	struct v4l2_ctrl_handler ctrls;
 	struct v4l2_ctrl *pixel_clock;
 	struct v4l2_ctrl *link_freq;
+	/* exposure and gain are clustered, one s_ctrl writes both */
 	struct v4l2_ctrl *exposure;
 	struct v4l2_ctrl *gain;
+	/* VTS is height + vblank, the exposure range follows it */
+	struct v4l2_ctrl *vblank;
+	struct v4l2_ctrl *hblank;
 
-	/* Cached register values */
-	u8 aec_pk_manual;
-	u8 pre_isp_00;
-	u8 timing_format1;
-	u8 timing_format2;
+	/* Cached register values, protected by lock */
+	struct sensor_regcache regcache;
 
 	struct mutex lock; /* lock to protect power state, ctrls and mode */
 	bool power_on;
+	bool streaming;
+	/* control writes go to a group hold, launched by group_work */
+	bool group_open;
+	struct work_struct group_work;
+	/* chip ID checked, done on the first power up instead of at probe */
+	bool identified;
+	/* time the sensor took to answer after power-on */
+	struct sensor_settle settle;
+	/* I2C and stream start statistics, in debugfs */
+	struct sensor_stats stats;
 
 	/* For DT-based systems */
 	struct gpio_desc *enable_gpio;
 
-	/* dependent device (PMIC) */
-	struct device *dep_dev;
-
-	/* GPIOs defined in dep_dev _CRS. The last "led_gpio" may not exist
-	 * depending on devices.
-	 */
-	struct gpio_desc *xshutdn;
-	struct gpio_desc *pwdnb;
-	struct gpio_desc *led_gpio;
+	/* dependent device (PMIC) holding the power GPIOs */
+	struct int3472_dep *dep;
 
 	bool is_acpi_based;
 };
@@ -116,6 +158,13 @@ static inline struct ov7251 *to_ov7251(struct v4l2_subdev *sd)
 	return container_of(sd, struct ov7251, sd);
 }
 
+static const struct sensor_reg_range ov7251_volatile_regs[] = {
+	SENSOR_REG_RANGE(OV7251_SC_SOFTWARE_RESET, OV7251_SC_SOFTWARE_RESET),
+	SENSOR_REG_RANGE(OV7251_CHIP_ID_HIGH, OV7251_CHIP_ID_LOW),
+	SENSOR_REG_RANGE(OV7251_SC_GP_IO_IN1, OV7251_SC_GP_IO_IN1),
+	SENSOR_REG_RANGE(OV7251_GROUP_ACCESS, OV7251_GROUP_ACCESS),
+};
+
 static const struct reg_value ov7251_global_init_setting[] = {
 	{ 0x0103, 0x01 },
 	{ 0x303b, 0x02 },
@@ -539,15 +588,19 @@ static const s64 link_freq[] = {
 	240000000,
 };
 
+static const struct sensor_burst_table ov7251_global_init_packed =
+	SENSOR_BURST_TABLE(ov7251_global_init_setting_packed);
+
 static const struct ov7251_mode_info ov7251_mode_info_data[] = {
 	{
 		.width = 640,
 		.height = 480,
 		.data = ov7251_setting_vga_30fps,
 		.data_size = ARRAY_SIZE(ov7251_setting_vga_30fps),
+		.data_packed = SENSOR_BURST_TABLE(ov7251_setting_vga_30fps_packed),
 		.pixel_clock = 48000000,
 		.link_freq = 0, /* an index in link_freq[] */
-		.exposure_max = 1704,
+		.vts = 1724,
 		.exposure_def = 504,
 		.timeperframe = {
 			.numerator = 100,
@@ -559,9 +612,10 @@ static const struct ov7251_mode_info ov7251_mode_info_data[] = {
 		.height = 480,
 		.data = ov7251_setting_vga_60fps,
 		.data_size = ARRAY_SIZE(ov7251_setting_vga_60fps),
+		.data_packed = SENSOR_BURST_TABLE(ov7251_setting_vga_60fps_packed),
 		.pixel_clock = 48000000,
 		.link_freq = 0, /* an index in link_freq[] */
-		.exposure_max = 840,
+		.vts = 860,
 		.exposure_def = 504,
 		.timeperframe = {
 			.numerator = 100,
@@ -573,9 +627,10 @@ static const struct ov7251_mode_info ov7251_mode_info_data[] = {
 		.height = 480,
 		.data = ov7251_setting_vga_90fps,
 		.data_size = ARRAY_SIZE(ov7251_setting_vga_90fps),
+		.data_packed = SENSOR_BURST_TABLE(ov7251_setting_vga_90fps_packed),
 		.pixel_clock = 48000000,
 		.link_freq = 0, /* an index in link_freq[] */
-		.exposure_max = 552,
+		.vts = 572,
 		.exposure_def = 504,
 		.timeperframe = {
 			.numerator = 100,
@@ -587,9 +642,10 @@ static const struct ov7251_mode_info ov7251_mode_info_data[] = {
 		.height = 540,
 		.data = ov7251_setting_vga_90fps,
 		.data_size = ARRAY_SIZE(ov7251_setting_vga_90fps),
+		.data_packed = SENSOR_BURST_TABLE(ov7251_setting_vga_90fps_packed),
 		.pixel_clock = 48000000,
 		.link_freq = 0, /* an index in link_freq[] */
-		.exposure_max = 552,
+		.vts = 572,
 		.exposure_def = 504,
 		.timeperframe = {
 			.numerator = 100,
@@ -654,6 +710,7 @@ static void ov7251_regulators_disable(struct ov7251 *ov7251)
 
 static int ov7251_write_reg(struct ov7251 *ov7251, u16 reg, u8 val)
 {
+	ktime_t start;
 	u8 regbuf[3];
 	int ret;
 
@@ -661,13 +718,23 @@ static int ov7251_write_reg(struct ov7251 *ov7251, u16 reg, u8 val)
 	regbuf[1] = reg & 0xff;
 	regbuf[2] = val;
 
+	start = ktime_get();
 	ret = i2c_master_send(ov7251->i2c_client, regbuf, 3);
+	sensor_stats_xfer(&ov7251->stats, SENSOR_STATS_WRITE, reg, 1, start,
+			  ret);
 	if (ret < 0) {
 		dev_err(ov7251->dev, "%s: write reg error %d: reg=%x, val=%x\n",
 			__func__, ret, reg, val);
 		return ret;
 	}
 
+	/* A software reset brings every register back to its default */
+	if (reg == OV7251_SC_SOFTWARE_RESET &&
+	    (val & OV7251_SC_SOFTWARE_RESET_BIT))
+		sensor_regcache_invalidate(&ov7251->regcache);
+	else
+		sensor_regcache_write(&ov7251->regcache, reg, val);
+
 	return 0;
 }
 
@@ -676,6 +743,7 @@ static int ov7251_write_seq_regs(struct ov7251 *ov7251, u16 reg, u8 *val,
 {
 	u8 regbuf[5];
 	u8 nregbuf = sizeof(reg) + num * sizeof(*val);
+	ktime_t start;
 	int ret = 0;
 
 	if (nregbuf > sizeof(regbuf))
@@ -686,7 +754,10 @@ static int ov7251_write_seq_regs(struct ov7251 *ov7251, u16 reg, u8 *val,
 
 	memcpy(regbuf + 2, val, num);
 
+	start = ktime_get();
 	ret = i2c_master_send(ov7251->i2c_client, regbuf, nregbuf);
+	sensor_stats_xfer(&ov7251->stats, SENSOR_STATS_WRITE, reg, num, start,
+			  ret);
 	if (ret < 0) {
 		dev_err(ov7251->dev,
 			"%s: write seq regs error %d: first reg=%x\n",
@@ -694,34 +765,63 @@ static int ov7251_write_seq_regs(struct ov7251 *ov7251, u16 reg, u8 *val,
 		return ret;
 	}
 
+	sensor_regcache_write_burst(&ov7251->regcache, reg, val, num);
+
 	return 0;
 }
 
 static int ov7251_read_reg(struct ov7251 *ov7251, u16 reg, u8 *val)
 {
+	ktime_t start;
 	u8 regbuf[2];
 	int ret;
 
+	if (sensor_regcache_read(&ov7251->regcache, reg, val))
+		return 0;
+
 	regbuf[0] = reg >> 8;
 	regbuf[1] = reg & 0xff;
 
+	start = ktime_get();
 	ret = i2c_master_send(ov7251->i2c_client, regbuf, 2);
 	if (ret < 0) {
+		sensor_stats_xfer(&ov7251->stats, SENSOR_STATS_READ, reg, 1,
+				  start, ret);
 		dev_err(ov7251->dev, "%s: write reg error %d: reg=%x\n",
 			__func__, ret, reg);
 		return ret;
 	}
 
 	ret = i2c_master_recv(ov7251->i2c_client, val, 1);
+	sensor_stats_xfer(&ov7251->stats, SENSOR_STATS_READ, reg, 1, start,
+			  ret);
 	if (ret < 0) {
 		dev_err(ov7251->dev, "%s: read reg error %d: reg=%x\n",
 			__func__, ret, reg);
 		return ret;
 	}
 
+	sensor_regcache_write(&ov7251->regcache, reg, *val);
+
 	return 0;
 }
 
+static int ov7251_mod_reg(struct ov7251 *ov7251, u16 reg, u8 mask, u8 val)
+{
+	u8 old;
+	int ret;
+
+	ret = ov7251_read_reg(ov7251, reg, &old);
+	if (ret < 0)
+		return ret;
+
+	val = (old & ~mask) | (val & mask);
+	if (val == old)
+		return 0;
+
+	return ov7251_write_reg(ov7251, reg, val);
+}
+
 static int ov7251_set_exposure(struct ov7251 *ov7251, s32 exposure)
 {
 	u16 reg;
@@ -747,69 +847,97 @@ static int ov7251_set_gain(struct ov7251 *ov7251, s32 gain)
 	return ov7251_write_seq_regs(ov7251, reg, val, 2);
 }
 
-static int ov7251_set_register_array(struct ov7251 *ov7251,
-				     const struct reg_value *settings,
-				     unsigned int num_settings)
+static int ov7251_set_vts(struct ov7251 *ov7251, u16 vts)
 {
-	unsigned int i;
-	int ret;
+	u8 val[2] = { vts >> 8, vts & 0xff };
 
-	for (i = 0; i < num_settings; ++i, ++settings) {
-		ret = ov7251_write_reg(ov7251, settings->reg, settings->val);
-		if (ret < 0)
-			return ret;
-	}
+	return ov7251_write_seq_regs(ov7251, OV7251_TIMING_VTS, val, 2);
+}
 
-	return 0;
+/* Exposure and gain form a control cluster, written by one s_ctrl */
+static int ov7251_set_exposure_gain(struct ov7251 *ov7251)
+{
+	int ret = 0;
+
+	if (ov7251->exposure->is_new)
+		ret = ov7251_set_exposure(ov7251, ov7251->exposure->val);
+
+	if (!ret && ov7251->gain->is_new)
+		ret = ov7251_set_gain(ov7251, ov7251->gain->val);
+
+	return ret;
 }
 
-/* Get GPIOs defined in dep_dev _CRS */
-static int gpio_crs_get(struct ov7251 *sensor, struct device *dep_dev)
+/*
+ * While streaming, control writes go into a group hold, so that all the
+ * controls set by one VIDIOC_S_EXT_CTRLS land in the same frame instead of
+ * tearing across a frame boundary. The first write opens the group and
+ * queues group_work, which needs ov7251->lock and so only launches the
+ * group once the control handler is done with the whole batch.
+ */
+static int ov7251_group_hold(struct ov7251 *ov7251)
 {
-	sensor->xshutdn = devm_gpiod_get_index(dep_dev, NULL, 0, GPIOD_ASIS);
-	if (IS_ERR(sensor->xshutdn)) {
-		dev_err(dep_dev, "Couldn't get GPIO XSHUTDN\n");
-		return -EINVAL;
-	}
+	int ret;
 
-	sensor->pwdnb = devm_gpiod_get_index(dep_dev, NULL, 1, GPIOD_ASIS);
-	if (IS_ERR(sensor->pwdnb)) {
-		dev_err(dep_dev, "Couldn't get GPIO PWDNB\n");
-		return -EINVAL;
-	}
+	if (ov7251->group_open)
+		return 0;
 
-	sensor->led_gpio = devm_gpiod_get_index(dep_dev, NULL, 2, GPIOD_ASIS);
-	if (IS_ERR(sensor->led_gpio))
-		dev_info(dep_dev,
-			 "Couldn't get GPIO LED. Maybe not exist, continue anyway.\n");
+	ret = ov7251_write_reg(ov7251, OV7251_GROUP_ACCESS,
+			       OV7251_GROUP_ACCESS_START);
+	if (ret < 0)
+		return ret;
+
+	ov7251->group_open = true;
+	schedule_work(&ov7251->group_work);
 
 	return 0;
 }
 
-/* Put GPIOs defined in dep_dev _CRS */
-static void gpio_crs_put(struct ov7251 *sensor)
+/* Close and launch an open group, with ov7251->lock held */
+static int ov7251_group_launch(struct ov7251 *ov7251)
 {
-	gpiod_put(sensor->xshutdn);
-	gpiod_put(sensor->pwdnb);
-	if (!IS_ERR(sensor->led_gpio))
-		gpiod_put(sensor->led_gpio);
+	int ret;
+
+	if (!ov7251->group_open)
+		return 0;
+
+	ov7251->group_open = false;
+
+	ret = ov7251_write_reg(ov7251, OV7251_GROUP_ACCESS,
+			       OV7251_GROUP_ACCESS_END);
+	if (!ret)
+		ret = ov7251_write_reg(ov7251, OV7251_GROUP_ACCESS,
+				       OV7251_GROUP_ACCESS_LAUNCH);
+	if (ret < 0)
+		dev_err(ov7251->dev, "group launch failed: %d\n", ret);
+
+	return ret;
 }
 
-/* Control GPIOs defined in dep_dev _CRS */
-static int gpio_crs_ctrl(struct v4l2_subdev *sd, bool flag)
+static void ov7251_group_work(struct work_struct *work)
 {
-	struct ov7251 *sensor = to_ov7251(sd);
+	struct ov7251 *ov7251 = container_of(work, struct ov7251,
+					     group_work);
 
-	gpiod_set_value_cansleep(sensor->xshutdn, flag);
-	gpiod_set_value_cansleep(sensor->pwdnb, flag);
-	if (!IS_ERR(sensor->led_gpio))
-		gpiod_set_value_cansleep(sensor->led_gpio, flag);
+	mutex_lock(&ov7251->lock);
+	ov7251_group_launch(ov7251);
+	mutex_unlock(&ov7251->lock);
+}
 
-	return 0;
+/*
+ * The register tables are written from their packed versions, generated
+ * by misc/pack_sensor_regs from the flat tables above.
+ */
+static int ov7251_set_register_array(struct ov7251 *ov7251,
+				     const struct sensor_burst_table *table)
+{
+	return sensor_burst_write(ov7251->i2c_client, table,
+				  &ov7251->regcache, &ov7251->stats);
 }
 
 static int ov7251_set_power_on(struct ov7251 *ov7251)
 {
+	ktime_t start = ktime_get();
 	int ret;
 	u32 wait_us;
 
@@ -830,13 +958,28 @@ static int ov7251_set_power_on(struct ov7251 *ov7251)
 	}
 
 	/* For ACPI-based systems */
-	if (ov7251->is_acpi_based)
-		gpio_crs_ctrl(&ov7251->sd, true);
+	if (ov7251->is_acpi_based) {
+		int3472_dep_set_power(ov7251->dep, true);
+
+		/* poll the chip ID rather than waiting for the worst case */
+		ret = sensor_settle_wait(ov7251->i2c_client,
+					 OV7251_CHIP_ID_HIGH,
+					 OV7251_CHIP_ID_HIGH_BYTE,
+					 OV7251_SETTLE_TIMEOUT_US,
+					 &ov7251->settle, &ov7251->stats);
+		if (ret) {
+			int3472_dep_set_power(ov7251->dep, false);
+			return ret;
+		}
+	} else {
+		/* wait at least 65536 external clock cycles */
+		wait_us = DIV_ROUND_UP(65536 * 1000,
+				       DIV_ROUND_UP(ov7251->xclk_freq, 1000));
+		usleep_range(wait_us, wait_us + 1000);
+	}
 
-	/* wait at least 65536 external clock cycles */
-	wait_us = DIV_ROUND_UP(65536 * 1000,
-			       DIV_ROUND_UP(ov7251->xclk_freq, 1000));
-	usleep_range(wait_us, wait_us + 1000);
+	sensor_stats_power(&ov7251->stats, true);
+	sensor_stats_phase(&ov7251->stats, SENSOR_STATS_POWER_ON, start);
 
 	return 0;
 }
@@ -852,12 +995,17 @@ static void ov7251_set_power_off(struct ov7251 *ov7251)
 
 	/* For ACPI-based systems */
 	if (ov7251->is_acpi_based)
-		gpio_crs_ctrl(&ov7251->sd, false);
+		int3472_dep_set_power(ov7251->dep, false);
+
+	sensor_stats_power(&ov7251->stats, false);
+	sensor_regcache_invalidate(&ov7251->regcache);
+	ov7251->programmed_mode = NULL;
 }
 
 static int ov7251_s_power(struct v4l2_subdev *sd, int on)
 {
 	struct ov7251 *ov7251 = to_ov7251(sd);
+	ktime_t start;
 	int ret = 0;
 
 	mutex_lock(&ov7251->lock);
@@ -867,22 +1015,28 @@ static int ov7251_s_power(struct v4l2_subdev *sd, int on)
 		goto exit;
 
 	if (on) {
-		ret = ov7251_set_power_on(ov7251);
-		if (ret < 0)
+		ret = pm_runtime_get_sync(ov7251->dev);
+		if (ret < 0) {
+			pm_runtime_put_noidle(ov7251->dev);
 			goto exit;
+		}
 
+		start = ktime_get();
 		ret = ov7251_set_register_array(ov7251,
-					ov7251_global_init_setting,
-					ARRAY_SIZE(ov7251_global_init_setting));
+						&ov7251_global_init_packed);
+		ov7251->programmed_mode = NULL;
 		if (ret < 0) {
 			dev_err(ov7251->dev, "could not set init registers\n");
-			ov7251_set_power_off(ov7251);
+			pm_runtime_put(ov7251->dev);
 			goto exit;
 		}
+		sensor_stats_phase(&ov7251->stats, SENSOR_STATS_GLOBAL_REGS,
+				   start);
 
 		ov7251->power_on = true;
 	} else {
-		ov7251_set_power_off(ov7251);
+		pm_runtime_mark_last_busy(ov7251->dev);
+		pm_runtime_put_autosuspend(ov7251->dev);
 		ov7251->power_on = false;
 	}
 
@@ -894,59 +1048,84 @@ exit:
 
 static int ov7251_set_hflip(struct ov7251 *ov7251, s32 value)
 {
-	u8 val = ov7251->timing_format2;
-	int ret;
-
-	if (value)
-		val |= OV7251_TIMING_FORMAT2_MIRROR;
-	else
-		val &= ~OV7251_TIMING_FORMAT2_MIRROR;
-
-	ret = ov7251_write_reg(ov7251, OV7251_TIMING_FORMAT2, val);
-	if (!ret)
-		ov7251->timing_format2 = val;
-
-	return ret;
+	return ov7251_mod_reg(ov7251, OV7251_TIMING_FORMAT2,
+			      OV7251_TIMING_FORMAT2_MIRROR,
+			      value ? OV7251_TIMING_FORMAT2_MIRROR : 0);
 }
 
 static int ov7251_set_vflip(struct ov7251 *ov7251, s32 value)
 {
-	u8 val = ov7251->timing_format1;
-	int ret;
+	return ov7251_mod_reg(ov7251, OV7251_TIMING_FORMAT1,
+			      OV7251_TIMING_FORMAT1_VFLIP,
+			      value ? OV7251_TIMING_FORMAT1_VFLIP : 0);
+}
 
-	if (value)
-		val |= OV7251_TIMING_FORMAT1_VFLIP;
-	else
-		val &= ~OV7251_TIMING_FORMAT1_VFLIP;
+static int ov7251_set_test_pattern(struct ov7251 *ov7251, s32 value)
+{
+	return ov7251_mod_reg(ov7251, OV7251_PRE_ISP_00,
+			      OV7251_PRE_ISP_00_TEST_PATTERN,
+			      value ? OV7251_PRE_ISP_00_TEST_PATTERN : 0);
+}
 
-	ret = ov7251_write_reg(ov7251, OV7251_TIMING_FORMAT1, val);
-	if (!ret)
-		ov7251->timing_format1 = val;
+static const char * const ov7251_test_pattern_menu[] = {
+	"Disabled",
+	"Vertical Pattern Bars",
+};
 
-	return ret;
+/* Keep the exposure within the frame, with ov7251->lock held */
+static void ov7251_update_exposure_range(struct ov7251 *ov7251, s32 vblank)
+{
+	const struct ov7251_mode_info *mode = ov7251->current_mode;
+	s64 max = mode->height + vblank - OV7251_EXPOSURE_MARGIN;
+
+	__v4l2_ctrl_modify_range(ov7251->exposure, 1, max, 1,
+				 min_t(s64, mode->exposure_def, max));
 }
 
-static int ov7251_set_test_pattern(struct ov7251 *ov7251, s32 value)
+/*
+ * Blanking of the current mode, with ov7251->lock held. The frame length
+ * goes back to the one of the mode table.
+ */
+static int ov7251_reset_blanking(struct ov7251 *ov7251)
 {
-	u8 val = ov7251->pre_isp_00;
+	const struct ov7251_mode_info *mode = ov7251->current_mode;
+	s64 hblank = OV7251_TIMING_HTS - mode->width;
+	s64 vblank = mode->vts - mode->height;
 	int ret;
 
-	if (value)
-		val |= OV7251_PRE_ISP_00_TEST_PATTERN;
-	else
-		val &= ~OV7251_PRE_ISP_00_TEST_PATTERN;
+	ret = __v4l2_ctrl_modify_range(ov7251->hblank, hblank, hblank, 1,
+				       hblank);
+	if (ret < 0)
+		return ret;
 
-	ret = ov7251_write_reg(ov7251, OV7251_PRE_ISP_00, val);
-	if (!ret)
-		ov7251->pre_isp_00 = val;
+	ret = __v4l2_ctrl_modify_range(ov7251->vblank,
+				       OV7251_TIMING_VTS_MIN - mode->height,
+				       OV7251_TIMING_VTS_MAX - mode->height,
+				       1, vblank);
+	if (ret < 0)
+		return ret;
 
-	return ret;
+	ret = __v4l2_ctrl_s_ctrl(ov7251->vblank, vblank);
+	if (ret < 0)
+		return ret;
+
+	ov7251_update_exposure_range(ov7251, vblank);
+
+	return 0;
 }
 
-static const char * const ov7251_test_pattern_menu[] = {
-	"Disabled",
-	"Vertical Pattern Bars",
-};
+/* Frame interval from the frame length, with ov7251->lock held */
+static void ov7251_get_interval(struct ov7251 *ov7251,
+				struct v4l2_fract *interval)
+{
+	const struct ov7251_mode_info *mode = ov7251->current_mode;
+	u32 num = OV7251_TIMING_HTS * (mode->height + ov7251->vblank->val);
+	u32 den = mode->pixel_clock;
+	unsigned long div = gcd(num, den);
+
+	interval->numerator = num / div;
+	interval->denominator = den / div;
+}
 
 static int ov7251_s_ctrl(struct v4l2_ctrl *ctrl)
 {
@@ -956,15 +1135,30 @@ static int ov7251_s_ctrl(struct v4l2_ctrl *ctrl)
 
 	/* v4l2_ctrl_lock() locks our mutex */
 
-	if (!ov7251->power_on)
+	if (ctrl->id == V4L2_CID_VBLANK)
+		ov7251_update_exposure_range(ov7251, ctrl->val);
+
+	/* Applied by __v4l2_ctrl_handler_setup() on the next stream on */
+	if (!pm_runtime_get_if_in_use(ov7251->dev))
 		return 0;
 
+	if (ov7251->streaming && ctrl->id != V4L2_CID_HBLANK) {
+		ret = ov7251_group_hold(ov7251);
+		if (ret < 0)
+			goto out;
+	}
+
 	switch (ctrl->id) {
 	case V4L2_CID_EXPOSURE:
-		ret = ov7251_set_exposure(ov7251, ctrl->val);
+		ret = ov7251_set_exposure_gain(ov7251);
+		break;
+	case V4L2_CID_VBLANK:
+		ret = ov7251_set_vts(ov7251,
+				     ov7251->current_mode->height + ctrl->val);
 		break;
-	case V4L2_CID_GAIN:
-		ret = ov7251_set_gain(ov7251, ctrl->val);
+	case V4L2_CID_HBLANK:
+		/* read-only, only changes along with the mode */
+		ret = 0;
 		break;
 	case V4L2_CID_TEST_PATTERN:
 		ret = ov7251_set_test_pattern(ov7251, ctrl->val);
@@ -980,6 +1174,9 @@ static int ov7251_s_ctrl(struct v4l2_ctrl *ctrl)
 		break;
 	}
 
+out:
+	pm_runtime_put(ov7251->dev);
+
 	return ret;
 }
 
@@ -1082,40 +1279,6 @@ __ov7251_get_pad_crop(struct ov7251 *ov7251, struct v4l2_subdev_pad_config *cfg,
 	}
 }
 
-static inline u32 avg_fps(const struct v4l2_fract *t)
-{
-	return (t->denominator + (t->numerator >> 1)) / t->numerator;
-}
-
-static const struct ov7251_mode_info *
-ov7251_find_mode_by_ival(struct ov7251 *ov7251, struct v4l2_fract *timeperframe)
-{
-	const struct ov7251_mode_info *mode = ov7251->current_mode;
-	unsigned int fps_req = avg_fps(timeperframe);
-	unsigned int max_dist_match = (unsigned int) -1;
-	unsigned int i, n = 0;
-
-	for (i = 0; i < ARRAY_SIZE(ov7251_mode_info_data); i++) {
-		unsigned int dist;
-		unsigned int fps_tmp;
-
-		if (mode->width != ov7251_mode_info_data[i].width ||
-		    mode->height != ov7251_mode_info_data[i].height)
-			continue;
-
-		fps_tmp = avg_fps(&ov7251_mode_info_data[i].timeperframe);
-
-		dist = abs(fps_req - fps_tmp);
-
-		if (dist < max_dist_match) {
-			n = i;
-			max_dist_match = dist;
-		}
-	}
-
-	return &ov7251_mode_info_data[n];
-}
-
 static int ov7251_set_format(struct v4l2_subdev *sd,
 			     struct v4l2_subdev_pad_config *cfg,
 			     struct v4l2_subdev_format *format)
@@ -1149,9 +1312,9 @@ static int ov7251_set_format(struct v4l2_subdev *sd,
 		if (ret < 0)
 			goto exit;
 
-		ret = __v4l2_ctrl_modify_range(ov7251->exposure,
-					       1, new_mode->exposure_max,
-					       1, new_mode->exposure_def);
+		ov7251->current_mode = new_mode;
+
+		ret = ov7251_reset_blanking(ov7251);
 		if (ret < 0)
 			goto exit;
 
@@ -1163,8 +1326,6 @@ static int ov7251_set_format(struct v4l2_subdev *sd,
 		ret = __v4l2_ctrl_s_ctrl(ov7251->gain, 16);
 		if (ret < 0)
 			goto exit;
-
-		ov7251->current_mode = new_mode;
 	}
 
 	__format = __ov7251_get_pad_format(ov7251, cfg, format->pad,
@@ -1224,106 +1385,228 @@ static int ov7251_get_selection(struct v4l2_subdev *sd,
 static int ov7251_s_stream(struct v4l2_subdev *subdev, int enable)
 {
 	struct ov7251 *ov7251 = to_ov7251(subdev);
+	ktime_t stream_start = ktime_get();
+	ktime_t start;
 	int ret;
 
 	mutex_lock(&ov7251->lock);
 
-	/* power_on() here before streaming for regular PCs. */
-	if (enable) {
-		ret = ov7251_set_power_on(ov7251);
-		if (ret) {
-			dev_err(ov7251->dev, "sensor power-up error\n");
-			ov7251_set_power_off(ov7251);
-			goto exit;
-		}
+	if (ov7251->streaming == !!enable) {
+		ret = 0;
+		goto exit;
 	}
 
-	if (enable) {
+	if (!enable) {
+		/* the last controls are applied before stopping */
+		ov7251_group_launch(ov7251);
+		ret = ov7251_write_reg(ov7251, OV7251_SC_MODE_SELECT,
+				       OV7251_SC_MODE_SELECT_SW_STANDBY);
+		ov7251->streaming = false;
+
+		/* Keep the sensor powered for a quick restart */
+		pm_runtime_mark_last_busy(ov7251->dev);
+		pm_runtime_put_autosuspend(ov7251->dev);
+		goto exit;
+	}
+
+	ret = pm_runtime_get_sync(ov7251->dev);
+	if (ret < 0) {
+		dev_err(ov7251->dev, "sensor power-up error\n");
+		pm_runtime_put_noidle(ov7251->dev);
+		goto exit;
+	}
+
+	/* A warm sensor still holds the mode */
+	if (ov7251->programmed_mode != ov7251->current_mode) {
+		start = ktime_get();
 		ret = ov7251_set_register_array(ov7251,
-					ov7251->current_mode->data,
-					ov7251->current_mode->data_size);
+					&ov7251->current_mode->data_packed);
 		if (ret < 0) {
 			dev_err(ov7251->dev, "could not set mode %dx%d\n",
 				ov7251->current_mode->width,
 				ov7251->current_mode->height);
-			goto exit;
+			goto err_rpm_put;
 		}
-		ret = __v4l2_ctrl_handler_setup(&ov7251->ctrls);
-		if (ret < 0) {
-			dev_err(ov7251->dev, "could not sync v4l2 controls\n");
-			goto exit;
-		}
-		ret = ov7251_write_reg(ov7251, OV7251_SC_MODE_SELECT,
-				       OV7251_SC_MODE_SELECT_STREAMING);
-	} else {
-		ret = ov7251_write_reg(ov7251, OV7251_SC_MODE_SELECT,
-				       OV7251_SC_MODE_SELECT_SW_STANDBY);
+		ov7251->programmed_mode = ov7251->current_mode;
+		sensor_stats_phase(&ov7251->stats, SENSOR_STATS_MODE_REGS,
+				   start);
 	}
 
-	/* power_off() here after streaming for regular PCs. */
-	if (!enable)
-		ov7251_set_power_off(ov7251);
+	/* Mostly answered from the register cache when the sensor is warm */
+	start = ktime_get();
+	ret = __v4l2_ctrl_handler_setup(&ov7251->ctrls);
+	if (ret < 0) {
+		dev_err(ov7251->dev, "could not sync v4l2 controls\n");
+		goto err_rpm_put;
+	}
+	sensor_stats_phase(&ov7251->stats, SENSOR_STATS_CTRL_SETUP, start);
 
+	start = ktime_get();
+	ret = ov7251_write_reg(ov7251, OV7251_SC_MODE_SELECT,
+			       OV7251_SC_MODE_SELECT_STREAMING);
+	if (ret < 0)
+		goto err_rpm_put;
+
+	sensor_stats_phase(&ov7251->stats, SENSOR_STATS_STREAM_ON, start);
+	sensor_stats_phase(&ov7251->stats, SENSOR_STATS_STREAM_START,
+			   stream_start);
+	ov7251->streaming = true;
+	goto exit;
+
+err_rpm_put:
+	pm_runtime_put(ov7251->dev);
 exit:
 	mutex_unlock(&ov7251->lock);
 
 	return ret;
 }
 
+/* Must be called with the sensor powered up */
+static int ov7251_identify(struct ov7251 *ov7251)
+{
+	struct device *dev = ov7251->dev;
+	u8 chip_id_high, chip_id_low, chip_rev;
+	int ret;
+
+	if (ov7251->identified)
+		return 0;
+
+	ret = ov7251_read_reg(ov7251, OV7251_CHIP_ID_HIGH, &chip_id_high);
+	if (ret < 0 || chip_id_high != OV7251_CHIP_ID_HIGH_BYTE) {
+		dev_err(dev, "could not read ID high\n");
+		return -ENODEV;
+	}
+	ret = ov7251_read_reg(ov7251, OV7251_CHIP_ID_LOW, &chip_id_low);
+	if (ret < 0 || chip_id_low != OV7251_CHIP_ID_LOW_BYTE) {
+		dev_err(dev, "could not read ID low\n");
+		return -ENODEV;
+	}
+
+	ret = ov7251_read_reg(ov7251, OV7251_SC_GP_IO_IN1, &chip_rev);
+	if (ret < 0) {
+		dev_err(dev, "could not read revision\n");
+		return -ENODEV;
+	}
+	chip_rev >>= 4;
+
+	dev_info(dev, "OV7251 revision %x (%s) detected at address 0x%02x\n",
+		 chip_rev,
+		 chip_rev == 0x4 ? "1A / 1B" :
+		 chip_rev == 0x5 ? "1C / 1D" :
+		 chip_rev == 0x6 ? "1E" :
+		 chip_rev == 0x7 ? "1F" : "unknown",
+		 ov7251->i2c_client->addr);
+
+	ov7251->identified = true;
+
+	return 0;
+}
+
+static int __maybe_unused ov7251_runtime_suspend(struct device *dev)
+{
+	struct v4l2_subdev *sd = i2c_get_clientdata(to_i2c_client(dev));
+
+	ov7251_set_power_off(to_ov7251(sd));
+
+	return 0;
+}
+
+static int __maybe_unused ov7251_runtime_resume(struct device *dev)
+{
+	struct v4l2_subdev *sd = i2c_get_clientdata(to_i2c_client(dev));
+	struct ov7251 *ov7251 = to_ov7251(sd);
+	int ret;
+
+	ret = ov7251_set_power_on(ov7251);
+	if (ret < 0)
+		return ret;
+
+	ret = ov7251_identify(ov7251);
+	if (ret < 0)
+		ov7251_set_power_off(ov7251);
+
+	return ret;
+}
+
 static int ov7251_get_frame_interval(struct v4l2_subdev *subdev,
 				     struct v4l2_subdev_frame_interval *fi)
 {
 	struct ov7251 *ov7251 = to_ov7251(subdev);
 
 	mutex_lock(&ov7251->lock);
-	fi->interval = ov7251->current_mode->timeperframe;
+	ov7251_get_interval(ov7251, &fi->interval);
 	mutex_unlock(&ov7251->lock);
 
 	return 0;
 }
 
+/*
+ * Table of the size of @cur whose own frame length is the nearest to @vts.
+ * Beyond VTS, the 30 fps VGA table differs from the 60 and 90 fps ones in
+ * the 0x3016-0x301c clock registers, so slow and fast frame rates each
+ * keep the registers they were tuned with.
+ */
+static const struct ov7251_mode_info *
+ov7251_find_mode_by_vts(const struct ov7251_mode_info *cur, u32 vts)
+{
+	const struct ov7251_mode_info *mode, *best = cur;
+	unsigned int i;
+
+	for (i = 0; i < ARRAY_SIZE(ov7251_mode_info_data); i++) {
+		mode = &ov7251_mode_info_data[i];
+		if (mode->width != cur->width || mode->height != cur->height)
+			continue;
+
+		if (abs((int)mode->vts - (int)vts) <
+		    abs((int)best->vts - (int)vts))
+			best = mode;
+	}
+
+	return best;
+}
+
+/*
+ * The frame interval is set through VBLANK, on the table tuned for the
+ * nearest frame rate. Within a table that is a single VTS write, which also
+ * works while streaming. Switching tables needs a reload, so not while
+ * streaming.
+ */
 static int ov7251_set_frame_interval(struct v4l2_subdev *subdev,
 				     struct v4l2_subdev_frame_interval *fi)
 {
 	struct ov7251 *ov7251 = to_ov7251(subdev);
-	const struct ov7251_mode_info *new_mode;
+	const struct ov7251_mode_info *mode;
+	struct v4l2_fract *ival = &fi->interval;
+	u64 vts;
 	int ret = 0;
 
 	mutex_lock(&ov7251->lock);
-	new_mode = ov7251_find_mode_by_ival(ov7251, &fi->interval);
 
-	if (new_mode != ov7251->current_mode) {
-		ret = __v4l2_ctrl_s_ctrl_int64(ov7251->pixel_clock,
-					       new_mode->pixel_clock);
-		if (ret < 0)
-			goto exit;
+	mode = ov7251->current_mode;
 
-		ret = __v4l2_ctrl_s_ctrl(ov7251->link_freq,
-					 new_mode->link_freq);
-		if (ret < 0)
-			goto exit;
-
-		ret = __v4l2_ctrl_modify_range(ov7251->exposure,
-					       1, new_mode->exposure_max,
-					       1, new_mode->exposure_def);
-		if (ret < 0)
-			goto exit;
-
-		ret = __v4l2_ctrl_s_ctrl(ov7251->exposure,
-					 new_mode->exposure_def);
-		if (ret < 0)
-			goto exit;
+	/* interval = HTS * VTS / pixel clock, as fast as possible for 0 */
+	if (ival->numerator && ival->denominator)
+		vts = div_u64((u64)mode->pixel_clock * ival->numerator,
+			      (u64)OV7251_TIMING_HTS * ival->denominator);
+	else
+		vts = 0;
 
-		ret = __v4l2_ctrl_s_ctrl(ov7251->gain, 16);
-		if (ret < 0)
-			goto exit;
+	vts = clamp_t(u64, vts, mode->height + ov7251->vblank->minimum,
+		      mode->height + ov7251->vblank->maximum);
 
-		ov7251->current_mode = new_mode;
+	mode = ov7251_find_mode_by_vts(mode, vts);
+	if (mode != ov7251->current_mode) {
+		if (ov7251->streaming) {
+			ret = -EBUSY;
+			goto out;
+		}
+		ov7251->current_mode = mode;
 	}
 
-	fi->interval = ov7251->current_mode->timeperframe;
+	ret = __v4l2_ctrl_s_ctrl(ov7251->vblank, vts - mode->height);
 
-exit:
+out:
+	ov7251_get_interval(ov7251, ival);
 	mutex_unlock(&ov7251->lock);
 
 	return ret;
@@ -1355,122 +1638,12 @@ static const struct v4l2_subdev_ops ov7251_subdev_ops = {
 	.pad = &ov7251_subdev_pad_ops,
 };
 
-/* Get acpi_device of dependent INT3472 device */
-static struct acpi_device *get_dep_adev(struct device *dev)
-{
-	struct acpi_handle *dev_handle;
-	struct acpi_device *sensor_adev;
-	struct acpi_handle_list dep_devices;
-	struct acpi_device *dep_adev;
-	acpi_status status;
-	const char *dep_hid = "INT3472";
-	int i;
-
-	sensor_adev = acpi_dev_get_first_match_dev(OV7251_ACPI_HID, NULL, -1);
-	if (!sensor_adev) {
-		dev_err(dev, "Couldn't get sensor ACPI device\n");
-		return ERR_PTR(-ENODEV);
-	}
-	dev_handle = sensor_adev->handle;
-	acpi_dev_put(sensor_adev);
-
-	if (!acpi_has_method(dev_handle, "_DEP")) {
-		dev_err(dev, "No _DEP entry found\n");
-		return ERR_PTR(-ENODEV);
-	}
-
-	status = acpi_evaluate_reference(dev_handle, "_DEP", NULL, &dep_devices);
-	if (ACPI_FAILURE(status)) {
-		dev_err(dev, "Failed to evaluate _DEP.\n");
-		return ERR_PTR(-ENODEV);
-	}
-
-	for (i = 0; i < dep_devices.count; i++) {
-		struct acpi_device_info *info;
-		int match;
-
-		status = acpi_get_object_info(dep_devices.handles[i], &info);
-		if (ACPI_FAILURE(status)) {
-			dev_dbg(dev,
-				"Error reading _DEP device info, continue next\n");
-			continue;
-		}
-
-		match = info->valid & ACPI_VALID_HID &&
-			!strcmp(info->hardware_id.string, dep_hid);
-
-		kfree(info);
-
-		if (!match)
-			continue;
-
-		if (acpi_bus_get_device(dep_devices.handles[i], &dep_adev)) {
-			dev_err(dev, "Error getting dependent ACPI device\n");
-			return ERR_PTR(-ENODEV);
-		}
-
-		/* found acpi_device of dependent device */
-		break;
-	}
-
-	if (!dep_adev) {
-		dev_err(dev, "Dependent ACPI device not found\n");
-		return ERR_PTR(-ENODEV);
-	}
-
-	dev_info(dev, "Dependent ACPI device found: %s\n",
-		 dev_name(&dep_adev->dev));
-
-	return dep_adev;
-}
-
-/* Get dependent INT3472 device */
-static struct device *get_dep_dev(struct device *dev)
-{
-	struct acpi_device *dep_adev;
-	struct acpi_device_physical_node *dep_phys;
-
-	dep_adev = get_dep_adev(dev);
-	if (!dep_adev) {
-		dev_err(dev, "get_dep_adev() failed\n");
-		return ERR_PTR(-ENODEV);
-	}
-
-	/*
-	 * HACK: We know that the PMIC is a "discrete" PMIC, an ACPI device
-	 * that just serves as a container to list system GPIOs.
-	 *
-	 * The ACPI device has no fwnode, nor does it have a platform device.
-	 * This prevents fetching GPIOs. It however seems to be backed by the
-	 * PCI root complex (pci0000:00/0000:00:00.0) as its physical device,
-	 * and that device has its fwnode set to \_SB.PCI0.DSC1. Whether this
-	 * is correct or not is unknown, let's just get the physical device and
-	 * move on for now.
-	 *
-	 * (@kitakar5525)This is observed on Microsoft Surface Go series
-	 * and Acer Switch Alpha 12.
-	 */
-	dep_phys = list_first_entry_or_null(&dep_adev->physical_node_list,
-					    struct acpi_device_physical_node,
-					    node);
-	if (!dep_phys) {
-		dev_info(dev,
-			 "Error getting physical node of dependent device\n");
-		return ERR_PTR(-ENODEV);
-	}
-
-	dev_info(dev, "Dependent device found: %s\n", dev_name(dep_phys->dev));
-
-	return dep_phys->dev;
-}
-
 static int ov7251_probe(struct i2c_client *client)
 {
 	struct device *dev = &client->dev;
 	struct fwnode_handle *endpoint;
 	struct ov7251 *ov7251;
-	struct device *dep_dev;
-	u8 chip_id_high, chip_id_low, chip_rev;
+	struct sensor_ssdb ssdb;
 	int ret;
 
 	dev_info(dev, "%s() called\n", __func__);
@@ -1482,7 +1655,7 @@ static int ov7251_probe(struct i2c_client *client)
 	ov7251->i2c_client = client;
 	ov7251->dev = dev;
 
-	if (acpi_dev_present(OV7251_ACPI_HID, NULL, -1)) {
+	if (has_acpi_companion(&client->dev)) {
 		dev_info(dev, "system is acpi-based\n");
 		ov7251->is_acpi_based = true;
 	} else
@@ -1533,12 +1706,22 @@ static int ov7251_probe(struct i2c_client *client)
 				ov7251->xclk_freq);
 			return -EINVAL;
 		}
-	} else {
+	} else if (!sensor_ssdb_read(dev, &ssdb)) {
 		/* Can't read clock-frequency from fwnode with surface_camera
 		 * because currently surface_camera needs to be loaded before
-		 * sensor drivers. Hard-code for ACPI for now.
+		 * sensor drivers. The SSDB has it too.
 		 */
-		ov7251->xclk_freq = 19200000;
+		if (ssdb.lanes_used != OV7251_DATA_LANES) {
+			dev_err(dev, "%u data lanes are not supported\n",
+				ssdb.lanes_used);
+			return -EINVAL;
+		}
+
+		ov7251->xclk_freq = ssdb.mclk_speed ?: OV7251_ACPI_XCLK_FREQ;
+		dev_info(dev, "SSDB: %u Hz clock, CSI-2 port %u\n",
+			 ov7251->xclk_freq, ssdb.link_used);
+	} else {
+		ov7251->xclk_freq = OV7251_ACPI_XCLK_FREQ;
 	}
 
 	/* For DT-based systems */
@@ -1576,24 +1759,28 @@ static int ov7251_probe(struct i2c_client *client)
 
 	/* For ACPI-based systems */
 	if (ov7251->is_acpi_based) {
-		ov7251->dep_dev = get_dep_dev(&client->dev);
-		if (IS_ERR(ov7251->dep_dev)) {
-			ret = PTR_ERR(ov7251->dep_dev);
-			dev_err(&client->dev, "cannot get dep_dev: ret %d\n", ret);
+		ov7251->dep = int3472_dep_get(&client->dev);
+		if (IS_ERR(ov7251->dep)) {
+			ret = PTR_ERR(ov7251->dep);
+			dev_err(&client->dev, "cannot get dependent device: ret %d\n",
+				ret);
 			return ret;
 		}
-		dep_dev = ov7251->dep_dev;
+	}
 
-		ret = gpio_crs_get(ov7251, dep_dev);
-		if (ret) {
-			dev_err(dep_dev, "Failed to get _CRS GPIOs\n");
-			return ret;
-		}
+	ret = sensor_regcache_init(dev, &ov7251->regcache,
+				   OV7251_REGCACHE_MAX_REG,
+				   ov7251_volatile_regs,
+				   ARRAY_SIZE(ov7251_volatile_regs));
+	if (ret < 0) {
+		int3472_dep_put(ov7251->dep);
+		return ret;
 	}
 
 	mutex_init(&ov7251->lock);
+	INIT_WORK(&ov7251->group_work, ov7251_group_work);
 
-	v4l2_ctrl_handler_init(&ov7251->ctrls, 7);
+	v4l2_ctrl_handler_init(&ov7251->ctrls, 9);
 	ov7251->ctrls.lock = &ov7251->lock;
 
 	v4l2_ctrl_new_std(&ov7251->ctrls, &ov7251_ctrl_ops,
@@ -1604,6 +1791,15 @@ static int ov7251_probe(struct i2c_client *client)
 					     V4L2_CID_EXPOSURE, 1, 32, 1, 32);
 	ov7251->gain = v4l2_ctrl_new_std(&ov7251->ctrls, &ov7251_ctrl_ops,
 					 V4L2_CID_GAIN, 16, 1023, 1, 16);
+	/* the ranges are set along the mode, by ov7251_reset_blanking() */
+	ov7251->vblank = v4l2_ctrl_new_std(&ov7251->ctrls, &ov7251_ctrl_ops,
+					   V4L2_CID_VBLANK, 1,
+					   OV7251_TIMING_VTS_MAX, 1, 1);
+	ov7251->hblank = v4l2_ctrl_new_std(&ov7251->ctrls, &ov7251_ctrl_ops,
+					   V4L2_CID_HBLANK, 0,
+					   OV7251_TIMING_HTS, 1, 0);
+	if (ov7251->hblank)
+		ov7251->hblank->flags |= V4L2_CTRL_FLAG_READ_ONLY;
 	v4l2_ctrl_new_std_menu_items(&ov7251->ctrls, &ov7251_ctrl_ops,
 				     V4L2_CID_TEST_PATTERN,
 				     ARRAY_SIZE(ov7251_test_pattern_menu) - 1,
@@ -1629,6 +1825,8 @@ static int ov7251_probe(struct i2c_client *client)
 		goto free_ctrl;
 	}
 
+	v4l2_ctrl_cluster(2, &ov7251->exposure);
+
 	v4l2_i2c_subdev_init(&ov7251->sd, client, &ov7251_subdev_ops);
 	ov7251->sd.flags |= V4L2_SUBDEV_FL_HAS_DEVNODE;
 	ov7251->pad.flags = MEDIA_PAD_FL_SOURCE;
@@ -1641,66 +1839,15 @@ static int ov7251_probe(struct i2c_client *client)
 		goto free_ctrl;
 	}
 
-	ret = ov7251_s_power(&ov7251->sd, true);
-	if (ret < 0) {
-		dev_err(dev, "could not power up OV7251\n");
-		goto free_entity;
-	}
+	sensor_stats_init(&ov7251->stats, dev, &ov7251->settle);
 
-	ret = ov7251_read_reg(ov7251, OV7251_CHIP_ID_HIGH, &chip_id_high);
-	if (ret < 0 || chip_id_high != OV7251_CHIP_ID_HIGH_BYTE) {
-		dev_err(dev, "could not read ID high\n");
-		ret = -ENODEV;
-		goto power_down;
-	}
-	ret = ov7251_read_reg(ov7251, OV7251_CHIP_ID_LOW, &chip_id_low);
-	if (ret < 0 || chip_id_low != OV7251_CHIP_ID_LOW_BYTE) {
-		dev_err(dev, "could not read ID low\n");
-		ret = -ENODEV;
-		goto power_down;
-	}
-
-	ret = ov7251_read_reg(ov7251, OV7251_SC_GP_IO_IN1, &chip_rev);
-	if (ret < 0) {
-		dev_err(dev, "could not read revision\n");
-		ret = -ENODEV;
-		goto power_down;
-	}
-	chip_rev >>= 4;
-
-	dev_info(dev, "OV7251 revision %x (%s) detected at address 0x%02x\n",
-		 chip_rev,
-		 chip_rev == 0x4 ? "1A / 1B" :
-		 chip_rev == 0x5 ? "1C / 1D" :
-		 chip_rev == 0x6 ? "1E" :
-		 chip_rev == 0x7 ? "1F" : "unknown",
-		 client->addr);
-
-	ret = ov7251_read_reg(ov7251, OV7251_PRE_ISP_00,
-			      &ov7251->pre_isp_00);
-	if (ret < 0) {
-		dev_err(dev, "could not read test pattern value\n");
-		ret = -ENODEV;
-		goto power_down;
-	}
-
-	ret = ov7251_read_reg(ov7251, OV7251_TIMING_FORMAT1,
-			      &ov7251->timing_format1);
-	if (ret < 0) {
-		dev_err(dev, "could not read vflip value\n");
-		ret = -ENODEV;
-		goto power_down;
-	}
-
-	ret = ov7251_read_reg(ov7251, OV7251_TIMING_FORMAT2,
-			      &ov7251->timing_format2);
-	if (ret < 0) {
-		dev_err(dev, "could not read hflip value\n");
-		ret = -ENODEV;
-		goto power_down;
-	}
-
-	ov7251_s_power(&ov7251->sd, false);
+	/*
+	 * The sensor is not touched at probe. It is identified on the first
+	 * power up.
+	 */
+	pm_runtime_set_autosuspend_delay(dev, OV7251_AUTOSUSPEND_DELAY_MS);
+	pm_runtime_use_autosuspend(dev);
+	pm_runtime_enable(dev);
 
 	ret = v4l2_async_register_subdev(&ov7251->sd);
 	if (ret < 0) {
@@ -1712,13 +1859,18 @@ static int ov7251_probe(struct i2c_client *client)
 
 	return 0;
 
-power_down:
-	ov7251_s_power(&ov7251->sd, false);
 free_entity:
+	pm_runtime_disable(dev);
+	if (!pm_runtime_status_suspended(dev))
+		ov7251_set_power_off(ov7251);
+	pm_runtime_set_suspended(dev);
+	pm_runtime_dont_use_autosuspend(dev);
+	sensor_stats_exit(&ov7251->stats);
 	media_entity_cleanup(&ov7251->sd.entity);
 free_ctrl:
 	v4l2_ctrl_handler_free(&ov7251->ctrls);
 	mutex_destroy(&ov7251->lock);
+	int3472_dep_put(ov7251->dep);
 
 	return ret;
 }
@@ -1730,11 +1882,20 @@ static int ov7251_remove(struct i2c_client *client)
 
 	dev_info(&client->dev, "%s() called\n", __func__);
 
+	v4l2_async_unregister_subdev(&ov7251->sd);
+	cancel_work_sync(&ov7251->group_work);
+
+	pm_runtime_disable(&client->dev);
+	if (!pm_runtime_status_suspended(&client->dev))
+		ov7251_set_power_off(ov7251);
+	pm_runtime_set_suspended(&client->dev);
+	pm_runtime_dont_use_autosuspend(&client->dev);
+
 	/* For ACPI-based systems */
 	if (ov7251->is_acpi_based)
-		gpio_crs_put(ov7251);
+		int3472_dep_put(ov7251->dep);
 
-	v4l2_async_unregister_subdev(&ov7251->sd);
+	sensor_stats_exit(&ov7251->stats);
 	media_entity_cleanup(&ov7251->sd.entity);
 	v4l2_ctrl_handler_free(&ov7251->ctrls);
 	mutex_destroy(&ov7251->lock);
@@ -1756,8 +1917,14 @@ static const struct acpi_device_id ov7251_acpi_ids[] = {
 MODULE_DEVICE_TABLE(acpi, ov7251_acpi_ids);
 #endif
 
+static const struct dev_pm_ops ov7251_pm_ops = {
+	SET_RUNTIME_PM_OPS(ov7251_runtime_suspend, ov7251_runtime_resume, NULL)
+};
+
 static struct i2c_driver ov7251_i2c_driver = {
 	.driver = {
+		.pm = &ov7251_pm_ops,
+		.probe_type = PROBE_PREFER_ASYNCHRONOUS,
 		.of_match_table = ov7251_of_match,
 		.acpi_match_table = ACPI_PTR(ov7251_acpi_ids),
 		.name  = "ov7251",
@@ -0,0 +1,389 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+/*
+ * Generated by misc/pack_sensor_regs/pack_sensor_regs.py from ov7251.c.
+ * Do not edit, regenerate after changing the register tables.
+ */
+
+#ifndef __OV7251_REGS_PACKED_H__
+#define __OV7251_REGS_PACKED_H__
+
+#include "sensor_burst.h"
+
+/* 2 entries, 2 messages */
+static const u8 ov7251_global_init_setting_packed[] = {
+	3, 0x01, 0x03,
+		0x01,
+	3, 0x30, 0x3b,
+		0x02,
+};
+
+/* 135 entries, 58 messages */
+static const u8 ov7251_setting_vga_30fps_packed[] = {
+	3, 0x30, 0x05,
+		0x00,
+	5, 0x30, 0x12,
+		0xc0, 0xd2, 0x04,
+	5, 0x30, 0x16,
+		0xf0, 0xf0, 0xf0,
+	5, 0x30, 0x1a,
+		0xf0, 0xf0, 0xf0,
+	3, 0x30, 0x23,
+		0x05,
+	3, 0x30, 0x37,
+		0xf0,
+	6, 0x30, 0x98,
+		0x04, 0x28, 0x05, 0x04,
+	3, 0x30, 0x9d,
+		0x00,
+	4, 0x30, 0xb0,
+		0x0a, 0x01,
+	5, 0x30, 0xb3,
+		0x64, 0x03, 0x05,
+	3, 0x31, 0x06,
+		0xda,
+	3, 0x35, 0x03,
+		0x07,
+	3, 0x35, 0x09,
+		0x10,
+	3, 0x36, 0x00,
+		0x1c,
+	3, 0x36, 0x02,
+		0x62,
+	3, 0x36, 0x20,
+		0xb7,
+	3, 0x36, 0x22,
+		0x04,
+	4, 0x36, 0x26,
+		0x21, 0x30,
+	4, 0x36, 0x30,
+		0x44, 0x35,
+	3, 0x36, 0x34,
+		0x60,
+	3, 0x36, 0x36,
+		0x00,
+	5, 0x36, 0x62,
+		0x01, 0x70, 0x50,
+	3, 0x36, 0x66,
+		0x0a,
+	5, 0x36, 0x69,
+		0x1a, 0x00, 0x50,
+	5, 0x36, 0x73,
+		0x01, 0xff, 0x03,
+	3, 0x37, 0x05,
+		0xc1,
+	3, 0x37, 0x09,
+		0x40,
+	3, 0x37, 0x3c,
+		0x08,
+	3, 0x37, 0x42,
+		0x00,
+	3, 0x37, 0x57,
+		0xb3,
+	3, 0x37, 0x88,
+		0x00,
+	4, 0x37, 0xa8,
+		0x01, 0xc0,
+	24, 0x38, 0x00,
+		0x00, 0x04, 0x00, 0x04, 0x02, 0x8b, 0x01, 0xeb,
+		0x02, 0x80, 0x01, 0xe0, 0x03, 0xa0, 0x06, 0xbc,
+		0x00, 0x04, 0x00, 0x05, 0x11, 0x11,
+	4, 0x38, 0x20,
+		0x40, 0x00,
+	3, 0x38, 0x2f,
+		0x0e,
+	6, 0x38, 0x32,
+		0x00, 0x05, 0x00, 0x0c,
+	3, 0x38, 0x37,
+		0x00,
+	18, 0x3b, 0x80,
+		0x00, 0xa5, 0x10, 0x00, 0x08, 0x00, 0x01, 0x00,
+		0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x1a,
+	5, 0x3b, 0x94,
+		0x05, 0xf2, 0x40,
+	10, 0x3c, 0x00,
+		0x89, 0x63, 0x01, 0x00, 0x00, 0x03, 0x00, 0x06,
+	6, 0x3c, 0x0c,
+		0x01, 0xd0, 0x02, 0x0a,
+	3, 0x40, 0x01,
+		0x42,
+	4, 0x40, 0x04,
+		0x04, 0x00,
+	3, 0x40, 0x4e,
+		0x01,
+	4, 0x43, 0x00,
+		0xff, 0x00,
+	3, 0x43, 0x15,
+		0x00,
+	3, 0x45, 0x01,
+		0x48,
+	4, 0x46, 0x00,
+		0x00, 0x4e,
+	3, 0x48, 0x01,
+		0x0f,
+	3, 0x48, 0x06,
+		0x0f,
+	3, 0x48, 0x19,
+		0xaa,
+	3, 0x48, 0x23,
+		0x3e,
+	3, 0x48, 0x37,
+		0x19,
+	3, 0x4a, 0x0d,
+		0x00,
+	3, 0x4a, 0x47,
+		0x7f,
+	3, 0x4a, 0x49,
+		0xf0,
+	3, 0x4a, 0x4b,
+		0x30,
+	4, 0x50, 0x00,
+		0x85, 0x80,
+};
+
+/* 135 entries, 58 messages */
+static const u8 ov7251_setting_vga_60fps_packed[] = {
+	3, 0x30, 0x05,
+		0x00,
+	5, 0x30, 0x12,
+		0xc0, 0xd2, 0x04,
+	5, 0x30, 0x16,
+		0x10, 0x00, 0x00,
+	5, 0x30, 0x1a,
+		0x00, 0x00, 0x00,
+	3, 0x30, 0x23,
+		0x05,
+	3, 0x30, 0x37,
+		0xf0,
+	6, 0x30, 0x98,
+		0x04, 0x28, 0x05, 0x04,
+	3, 0x30, 0x9d,
+		0x00,
+	4, 0x30, 0xb0,
+		0x0a, 0x01,
+	5, 0x30, 0xb3,
+		0x64, 0x03, 0x05,
+	3, 0x31, 0x06,
+		0xda,
+	3, 0x35, 0x03,
+		0x07,
+	3, 0x35, 0x09,
+		0x10,
+	3, 0x36, 0x00,
+		0x1c,
+	3, 0x36, 0x02,
+		0x62,
+	3, 0x36, 0x20,
+		0xb7,
+	3, 0x36, 0x22,
+		0x04,
+	4, 0x36, 0x26,
+		0x21, 0x30,
+	4, 0x36, 0x30,
+		0x44, 0x35,
+	3, 0x36, 0x34,
+		0x60,
+	3, 0x36, 0x36,
+		0x00,
+	5, 0x36, 0x62,
+		0x01, 0x70, 0x50,
+	3, 0x36, 0x66,
+		0x0a,
+	5, 0x36, 0x69,
+		0x1a, 0x00, 0x50,
+	5, 0x36, 0x73,
+		0x01, 0xff, 0x03,
+	3, 0x37, 0x05,
+		0xc1,
+	3, 0x37, 0x09,
+		0x40,
+	3, 0x37, 0x3c,
+		0x08,
+	3, 0x37, 0x42,
+		0x00,
+	3, 0x37, 0x57,
+		0xb3,
+	3, 0x37, 0x88,
+		0x00,
+	4, 0x37, 0xa8,
+		0x01, 0xc0,
+	24, 0x38, 0x00,
+		0x00, 0x04, 0x00, 0x04, 0x02, 0x8b, 0x01, 0xeb,
+		0x02, 0x80, 0x01, 0xe0, 0x03, 0xa0, 0x03, 0x5c,
+		0x00, 0x04, 0x00, 0x05, 0x11, 0x11,
+	4, 0x38, 0x20,
+		0x40, 0x00,
+	3, 0x38, 0x2f,
+		0x0e,
+	6, 0x38, 0x32,
+		0x00, 0x05, 0x00, 0x0c,
+	3, 0x38, 0x37,
+		0x00,
+	18, 0x3b, 0x80,
+		0x00, 0xa5, 0x10, 0x00, 0x08, 0x00, 0x01, 0x00,
+		0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x1a,
+	5, 0x3b, 0x94,
+		0x05, 0xf2, 0x40,
+	10, 0x3c, 0x00,
+		0x89, 0x63, 0x01, 0x00, 0x00, 0x03, 0x00, 0x06,
+	6, 0x3c, 0x0c,
+		0x01, 0xd0, 0x02, 0x0a,
+	3, 0x40, 0x01,
+		0x42,
+	4, 0x40, 0x04,
+		0x04, 0x00,
+	3, 0x40, 0x4e,
+		0x01,
+	4, 0x43, 0x00,
+		0xff, 0x00,
+	3, 0x43, 0x15,
+		0x00,
+	3, 0x45, 0x01,
+		0x48,
+	4, 0x46, 0x00,
+		0x00, 0x4e,
+	3, 0x48, 0x01,
+		0x0f,
+	3, 0x48, 0x06,
+		0x0f,
+	3, 0x48, 0x19,
+		0xaa,
+	3, 0x48, 0x23,
+		0x3e,
+	3, 0x48, 0x37,
+		0x19,
+	3, 0x4a, 0x0d,
+		0x00,
+	3, 0x4a, 0x47,
+		0x7f,
+	3, 0x4a, 0x49,
+		0xf0,
+	3, 0x4a, 0x4b,
+		0x30,
+	4, 0x50, 0x00,
+		0x85, 0x80,
+};
+
+/* 135 entries, 58 messages */
+static const u8 ov7251_setting_vga_90fps_packed[] = {
+	3, 0x30, 0x05,
+		0x00,
+	5, 0x30, 0x12,
+		0xc0, 0xd2, 0x04,
+	5, 0x30, 0x16,
+		0x10, 0x00, 0x00,
+	5, 0x30, 0x1a,
+		0x00, 0x00, 0x00,
+	3, 0x30, 0x23,
+		0x05,
+	3, 0x30, 0x37,
+		0xf0,
+	6, 0x30, 0x98,
+		0x04, 0x28, 0x05, 0x04,
+	3, 0x30, 0x9d,
+		0x00,
+	4, 0x30, 0xb0,
+		0x0a, 0x01,
+	5, 0x30, 0xb3,
+		0x64, 0x03, 0x05,
+	3, 0x31, 0x06,
+		0xda,
+	3, 0x35, 0x03,
+		0x07,
+	3, 0x35, 0x09,
+		0x10,
+	3, 0x36, 0x00,
+		0x1c,
+	3, 0x36, 0x02,
+		0x62,
+	3, 0x36, 0x20,
+		0xb7,
+	3, 0x36, 0x22,
+		0x04,
+	4, 0x36, 0x26,
+		0x21, 0x30,
+	4, 0x36, 0x30,
+		0x44, 0x35,
+	3, 0x36, 0x34,
+		0x60,
+	3, 0x36, 0x36,
+		0x00,
+	5, 0x36, 0x62,
+		0x01, 0x70, 0x50,
+	3, 0x36, 0x66,
+		0x0a,
+	5, 0x36, 0x69,
+		0x1a, 0x00, 0x50,
+	5, 0x36, 0x73,
+		0x01, 0xff, 0x03,
+	3, 0x37, 0x05,
+		0xc1,
+	3, 0x37, 0x09,
+		0x40,
+	3, 0x37, 0x3c,
+		0x08,
+	3, 0x37, 0x42,
+		0x00,
+	3, 0x37, 0x57,
+		0xb3,
+	3, 0x37, 0x88,
+		0x00,
+	4, 0x37, 0xa8,
+		0x01, 0xc0,
+	24, 0x38, 0x00,
+		0x00, 0x04, 0x00, 0x04, 0x02, 0x8b, 0x01, 0xeb,
+		0x02, 0x80, 0x01, 0xe0, 0x03, 0xa0, 0x02, 0x3c,
+		0x00, 0x04, 0x00, 0x05, 0x11, 0x11,
+	4, 0x38, 0x20,
+		0x40, 0x00,
+	3, 0x38, 0x2f,
+		0x0e,
+	6, 0x38, 0x32,
+		0x00, 0x05, 0x00, 0x0c,
+	3, 0x38, 0x37,
+		0x00,
+	18, 0x3b, 0x80,
+		0x00, 0xa5, 0x10, 0x00, 0x08, 0x00, 0x01, 0x00,
+		0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x1a,
+	5, 0x3b, 0x94,
+		0x05, 0xf2, 0x40,
+	10, 0x3c, 0x00,
+		0x89, 0x63, 0x01, 0x00, 0x00, 0x03, 0x00, 0x06,
+	6, 0x3c, 0x0c,
+		0x01, 0xd0, 0x02, 0x0a,
+	3, 0x40, 0x01,
+		0x42,
+	4, 0x40, 0x04,
+		0x04, 0x00,
+	3, 0x40, 0x4e,
+		0x01,
+	4, 0x43, 0x00,
+		0xff, 0x00,
+	3, 0x43, 0x15,
+		0x00,
+	3, 0x45, 0x01,
+		0x48,
+	4, 0x46, 0x00,
+		0x00, 0x4e,
+	3, 0x48, 0x01,
+		0x0f,
+	3, 0x48, 0x06,
+		0x0f,
+	3, 0x48, 0x19,
+		0xaa,
+	3, 0x48, 0x23,
+		0x3e,
+	3, 0x48, 0x37,
+		0x19,
+	3, 0x4a, 0x0d,
+		0x00,
+	3, 0x4a, 0x47,
+		0x7f,
+	3, 0x4a, 0x49,
+		0xf0,
+	3, 0x4a, 0x4b,
+		0x30,
+	4, 0x50, 0x00,
+		0x85, 0x80,
+};
+
+#endif /* __OV7251_REGS_PACKED_H__ */
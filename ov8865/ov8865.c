@@ -8,12 +8,15 @@
 #include <linux/acpi.h>
 #include <linux/clk.h>
 #include <linux/delay.h>
+#include <linux/gcd.h>
 #include <linux/gpio/consumer.h>
 #include <linux/i2c.h>
 #include <linux/init.h>
 #include <linux/module.h>
 #include <linux/platform_device.h>
+#include <linux/pm_runtime.h>
 #include <linux/regulator/consumer.h>
+#include <linux/workqueue.h>
 #include <media/v4l2-async.h>
 #include <media/v4l2-ctrls.h>
 #include <media/v4l2-device.h>
@@ -21,10 +24,20 @@
 #include <media/v4l2-fwnode.h>
 #include <media/v4l2-subdev.h>
 
+#include "int3472_dep.h"
+#include "sensor_regcache.h"
+#include "sensor_settle.h"
+#include "sensor_ssdb.h"
+#include "sensor_stats.h"
+#include "ov8865_regs_packed.h"
+
 #define OV8865_ACPI_HID "INT347A"
 
 #define OV8865_XCLK_FREQ		24000000
 
+/* Default runtime PM autosuspend delay, see power/autosuspend_delay_ms */
+#define OV8865_AUTOSUSPEND_DELAY_MS	1000
+
 /* System */
 
 #define OV8865_SW_STANDBY_REG		0x0100
@@ -51,6 +64,13 @@
 
 #define OV8865_CHIP_ID_REG		0x300a
 #define OV8865_CHIP_ID			0x008865
+/* upper bound of the wait for the sensor to answer after power-on */
+#define OV8865_SETTLE_TIMEOUT_US	50000
+
+#define OV8865_GROUP_ACCESS_REG		0x3208
+#define OV8865_GROUP_ACCESS_START	0x00
+#define OV8865_GROUP_ACCESS_END		0x10
+#define OV8865_GROUP_ACCESS_LAUNCH	0xa0
 
 /* Exposure/gain/banding */
 
@@ -67,18 +87,35 @@
 #define OV8865_ASP_CTRL50_REG		0x364a
 
 /* Timing control */
-#define OV8865_X_ADDR_START_H_REG	0x3800
-#define OV8865_X_ADDR_START_L_REG	0x3801
-#define OV8865_Y_ADDR_START_H_REG	0x3802
-#define OV8865_Y_ADDR_START_L_REG	0x3803
-#define OV8865_X_ADDR_END_H_REG		0x3804
-#define OV8865_X_ADDR_END_L_REG		0x3805
-#define OV8865_Y_ADDR_END_H_REG		0x3806
-#define OV8865_Y_ADDR_END_L_REG		0x3807
+#define OV8865_X_ADDR_START_REG		0x3800
+#define OV8865_Y_ADDR_START_REG		0x3802
+#define OV8865_X_ADDR_END_REG		0x3804
+#define OV8865_Y_ADDR_END_REG		0x3806
 #define OV8865_X_OUTPUT_SIZE_REG	0x3808
 #define OV8865_Y_OUTPUT_SIZE_REG	0x380a
 #define OV8865_HTS_REG			0x380c
 #define OV8865_VTS_REG			0x380e
+#define OV8865_VTS_MAX			0xffff
+/* shortest blanking of the mode tables, that of the full size modes */
+#define OV8865_VBLANK_MIN		22
+/* lines of a frame the exposure can't cover */
+#define OV8865_EXPOSURE_MARGIN		8
+/*
+ * Pixel array, in the addresses of the X/Y_ADDR registers. The array window
+ * is read with a few more pixels than the output around it, trimmed by the
+ * ISP window: 4 columns on either side, 2 lines above and 6 below.
+ */
+#define OV8865_NATIVE_WIDTH		3296
+#define OV8865_NATIVE_HEIGHT		2480
+#define OV8865_PIXEL_ARRAY_LEFT		16
+#define OV8865_PIXEL_ARRAY_TOP		14
+#define OV8865_PIXEL_ARRAY_WIDTH	3264
+#define OV8865_PIXEL_ARRAY_HEIGHT	2448
+#define OV8865_WIN_PAD_X		4
+#define OV8865_WIN_PAD_TOP		2
+#define OV8865_WIN_PAD_BOTTOM		6
+#define OV8865_CROP_MIN_WIDTH		64
+#define OV8865_CROP_MIN_HEIGHT		64
 #define OV8865_ISP_X_WIN_H_REG		0x3810
 #define OV8865_ISP_X_WIN_L_REG		0x3811
 #define OV8865_ISP_Y_WIN_L_REG		0x3813
@@ -100,10 +137,34 @@
 
 /* OTP */
 
+#define OV8865_OTP_PROGRAM_REG		0x3d80
+#define OV8865_OTP_LOAD_REG		0x3d81
+#define OV8865_OTP_LOAD_START		BIT(0)
+#define OV8865_OTP_MODE_CTRL_REG	0x3d84
+#define OV8865_OTP_MODE_MANUAL		0xc0
 #define OV8865_OTP_REG			0x3d85
+#define OV8865_OTP_START_ADDR_REG	0x3d88
+#define OV8865_OTP_END_ADDR_REG		0x3d8a
 #define OV8865_OTP_SETT_STT_ADDR_H_REG	0x3d8c
 #define OV8865_OTP_SETT_STT_ADDR_L_REG	0x3d8d
 
+/*
+ * OTP buffer layout. Each section starts with a flag byte holding the
+ * state of up to three groups, two bits per group starting from the MSBs,
+ * 01 meaning the group is valid. The groups follow the flag byte.
+ */
+#define OV8865_OTP_DATA_START		0x7010
+#define OV8865_OTP_DATA_END		0x70f4
+#define OV8865_OTP_DATA_SIZE		(OV8865_OTP_DATA_END - \
+					 OV8865_OTP_DATA_START + 1)
+#define OV8865_OTP_INFO_FLAG		0x7010
+#define OV8865_OTP_INFO_GROUP_SIZE	5
+#define OV8865_OTP_WB_FLAG		0x7020
+#define OV8865_OTP_WB_GROUP_SIZE	5
+#define OV8865_OTP_LSC_FLAG		0x703a
+#define OV8865_OTP_LSC_SIZE		62
+#define OV8865_OTP_NUM_GROUPS		3
+
 /* Black Level */
 
 #define OV8865_BLC_CTRL0_REG		0x4000
@@ -159,6 +220,7 @@
 #define OV8865_ISP_CTRL0_REG		0x5000
 #define OV8865_ISP_CTRL1_REG		0x5001
 #define OV8865_ISP_CTRL2_REG		0x5002
+#define OV8865_ISP_CTRL2_OTP_DPC_EN	BIT(3)
 
 #define OV8865_AVG_READOUT_REG		0x568a
 
@@ -282,6 +344,16 @@ static const char * const ov8865_supply_names[] = {
 
 #define OV8865_NUM_SUPPLIES ARRAY_SIZE(ov8865_supply_names)
 
+/* Highest register address kept in the register cache */
+#define OV8865_REGCACHE_MAX_REG		0x5fff
+
+static const struct sensor_reg_range ov8865_volatile_regs[] = {
+	SENSOR_REG_RANGE(OV8865_SW_RESET_REG, OV8865_SW_RESET_REG),
+	SENSOR_REG_RANGE(OV8865_CHIP_ID_REG, OV8865_CHIP_ID_REG + 2),
+	SENSOR_REG_RANGE(OV8865_GROUP_ACCESS_REG, OV8865_GROUP_ACCESS_REG),
+	SENSOR_REG_RANGE(OV8865_OTP_PROGRAM_REG, OV8865_OTP_LOAD_REG),
+};
+
 struct reg_value {
 	u16 reg_addr;
 	u8 val;
@@ -293,6 +365,18 @@ struct ov8865_reg_list {
 	const struct reg_value *regs;
 };
 
+#define OV8865_MAX_WRITE_BUF_SIZE	30
+
+struct ov8865_write_buffer {
+	u16 addr;
+	u8 data[OV8865_MAX_WRITE_BUF_SIZE];
+};
+
+struct ov8865_write_ctrl {
+	int index;
+	struct ov8865_write_buffer buffer;
+};
+
 struct ov8865_link_freq_config {
 	u32 pixel_rate;
 	const struct ov8865_reg_list reg_list;
@@ -316,6 +400,9 @@ static const struct reg_value mipi_data_rate_840mbps[] = {
 	{0x3031, 0x0a},
 };
 
+/* the sensor is set up for 4 lanes, see OV8865_MIPI_CTRL_REG */
+#define OV8865_DATA_LANES		4
+
 #define OV8865_LINK_FREQ_422MHZ			422400000
 #define OV8865_LINK_FREQ_422MHZ_INDEX	0
 
@@ -341,18 +428,46 @@ struct ov8865_mode_info {
 	u32 vtot;
 	const struct reg_value *reg_data;
 	u32 reg_data_size;
+	/* reg_data pre-coalesced by misc/pack_sensor_regs */
+	struct sensor_burst_table packed;
 };
 
 struct ov8865_ctrls {
 	struct v4l2_ctrl_handler handler;
 	struct v4l2_ctrl *pixel_rate;
+	/* exposure and gain are clustered, one s_ctrl writes both */
 	struct v4l2_ctrl *exposure;
 	struct v4l2_ctrl *gain;
 	struct v4l2_ctrl *hflip;
 	struct v4l2_ctrl *vflip;
 	struct v4l2_ctrl *link_freq;
+	/* VTS is vact + vblank, the exposure range follows it */
+	struct v4l2_ctrl *vblank;
 };
 
+/*
+ * Module calibration parsed from the OTP, exposed as is through the "otp"
+ * sysfs attribute. The 10-bit white balance ratios are little endian, with
+ * 512 meaning 1.0.
+ */
+#define OV8865_OTP_VALID_INFO		BIT(0)
+#define OV8865_OTP_VALID_WB		BIT(1)
+#define OV8865_OTP_VALID_LSC		BIT(2)
+
+struct ov8865_otp {
+	u8 valid;
+	u8 module_id;
+	u8 lens_id;
+	u8 year;
+	u8 month;
+	u8 day;
+	__le16 rg_ratio;
+	__le16 bg_ratio;
+	__le16 light_rg;
+	__le16 light_bg;
+	u8 lsc[OV8865_OTP_LSC_SIZE];
+} __packed;
+
 struct ov8865_dev {
 	struct i2c_client *i2c_client;
 	struct v4l2_subdev sd;
@@ -374,22 +489,52 @@ struct ov8865_dev {
 	struct v4l2_mbus_framefmt fmt;
 
 	const struct ov8865_mode_info *current_mode;
+	/*
+	 * Analog crop, in the full size readout only. The other modes read
+	 * the whole array. When set, current_mode points to crop_mode, the
+	 * full size mode with the output and frame length of the crop.
+	 */
+	struct v4l2_rect crop;
+	struct ov8865_mode_info crop_mode;
+	/* mode loaded in the sensor, NULL after power off */
 	const struct ov8865_mode_info *last_mode;
 	enum ov8865_frame_rate current_fr;
 	struct v4l2_fract frame_interval;
 	struct ov8865_ctrls ctrls;
 
-	bool streaming;
+	/* shadow of the sensor registers, protected by lock */
+	struct sensor_regcache regcache;
+
+	/*
+	 * Derived from the programmed PLL and mode, so that the exposure
+	 * controls don't need to read them back.
+	 */
+	int pclk;		/* MHz */
+	u32 hts;
+	u32 line_time;		/* hts / pclk, in us */
 
-	/* dependent device (PMIC) */
-	struct device *dep_dev;
+	/* read once, on the first power up */
+	struct ov8865_otp otp;
+	bool has_otp;
 
-	/* GPIOs defined in dep_dev _CRS. The last "led_gpio" may not exist
-	 * depending on devices.
+	/*
+	 * The chip ID and the OTP are checked on the first power up instead
+	 * of at probe, so probing doesn't need to power the sensor.
 	 */
-	struct gpio_desc *xshutdn;
-	struct gpio_desc *pwdnb;
-	struct gpio_desc *led_gpio;
+	bool identified;
+
+	bool streaming;
+	/* control writes go to a group hold, launched by group_work */
+	bool group_open;
+	struct work_struct group_work;
+
+	/* time the sensor took to answer after power-on */
+	struct sensor_settle settle;
+	/* I2C and stream start statistics, in debugfs */
+	struct sensor_stats stats;
+
+	/* dependent device (PMIC) holding the power GPIOs */
+	struct int3472_dep *dep;
 
 	bool is_acpi_based;
 };
@@ -981,6 +1126,7 @@ static const struct ov8865_mode_info ov8865_mode_init_data = {
 	.vtot = 2470,
 	.reg_data = ov8865_init_setting_QUXGA,
 	.reg_data_size = ARRAY_SIZE(ov8865_init_setting_QUXGA),
+	.packed = SENSOR_BURST_TABLE(ov8865_init_setting_QUXGA_packed),
 };
 
 static const struct ov8865_mode_info ov8865_mode_data[OV8865_NUM_MODES] = {
@@ -991,7 +1137,8 @@ static const struct ov8865_mode_info ov8865_mode_data[OV8865_NUM_MODES] = {
 		.vact = 2448,
 		.vtot = 2470,
 		.reg_data = ov8865_setting_QUXGA,
-		.reg_data_size = ARRAY_SIZE(ov8865_setting_QUXGA)
+		.reg_data_size = ARRAY_SIZE(ov8865_setting_QUXGA),
+		.packed = SENSOR_BURST_TABLE(ov8865_setting_QUXGA_packed),
 	},
 	{
 		.id = OV8865_MODE_6M_3264_1836,
@@ -1000,7 +1147,8 @@ static const struct ov8865_mode_info ov8865_mode_data[OV8865_NUM_MODES] = {
 		.vact = 1836,
 		.vtot = 1858,
 		.reg_data = ov8865_setting_6M,
-		.reg_data_size = ARRAY_SIZE(ov8865_setting_6M)
+		.reg_data_size = ARRAY_SIZE(ov8865_setting_6M),
+		.packed = SENSOR_BURST_TABLE(ov8865_setting_6M_packed),
 	},
 	{
 		.id = OV8865_MODE_1080P_1920_1080,
@@ -1009,7 +1157,8 @@ static const struct ov8865_mode_info ov8865_mode_data[OV8865_NUM_MODES] = {
 		.vact = 1080,
 		.vtot = 1858,
 		.reg_data = ov8865_setting_6M,
-		.reg_data_size = ARRAY_SIZE(ov8865_setting_6M)
+		.reg_data_size = ARRAY_SIZE(ov8865_setting_6M),
+		.packed = SENSOR_BURST_TABLE(ov8865_setting_6M_packed),
 	},
 	{
 		.id = OV8865_MODE_720P_1280_720,
@@ -1018,7 +1167,8 @@ static const struct ov8865_mode_info ov8865_mode_data[OV8865_NUM_MODES] = {
 		.vact = 720,
 		.vtot = 1248,
 		.reg_data = ov8865_setting_UXGA,
-		.reg_data_size = ARRAY_SIZE(ov8865_setting_UXGA)
+		.reg_data_size = ARRAY_SIZE(ov8865_setting_UXGA),
+		.packed = SENSOR_BURST_TABLE(ov8865_setting_UXGA_packed),
 	},
 	{
 		.id = OV8865_MODE_UXGA_1600_1200,
@@ -1027,7 +1177,8 @@ static const struct ov8865_mode_info ov8865_mode_data[OV8865_NUM_MODES] = {
 		.vact = 1200,
 		.vtot = 1248,
 		.reg_data = ov8865_setting_UXGA,
-		.reg_data_size = ARRAY_SIZE(ov8865_setting_UXGA)
+		.reg_data_size = ARRAY_SIZE(ov8865_setting_UXGA),
+		.packed = SENSOR_BURST_TABLE(ov8865_setting_UXGA_packed),
 	},
 	{
 		.id = OV8865_MODE_SVGA_800_600,
@@ -1036,7 +1187,8 @@ static const struct ov8865_mode_info ov8865_mode_data[OV8865_NUM_MODES] = {
 		.vact = 600,
 		.vtot = 640,
 		.reg_data = ov8865_setting_SVGA,
-		.reg_data_size = ARRAY_SIZE(ov8865_setting_SVGA)
+		.reg_data_size = ARRAY_SIZE(ov8865_setting_SVGA),
+		.packed = SENSOR_BURST_TABLE(ov8865_setting_SVGA_packed),
 	},
 	{
 		.id = OV8865_MODE_VGA_640_480,
@@ -1045,14 +1197,45 @@ static const struct ov8865_mode_info ov8865_mode_data[OV8865_NUM_MODES] = {
 		.vact = 480,
 		.vtot = 1858,
 		.reg_data = ov8865_setting_6M,
-		.reg_data_size = ARRAY_SIZE(ov8865_setting_6M)
+		.reg_data_size = ARRAY_SIZE(ov8865_setting_6M),
+		.packed = SENSOR_BURST_TABLE(ov8865_setting_6M_packed),
 	},
 };
 
+static const struct v4l2_rect ov8865_default_crop = {
+	.left = OV8865_PIXEL_ARRAY_LEFT,
+	.top = OV8865_PIXEL_ARRAY_TOP,
+	.width = OV8865_PIXEL_ARRAY_WIDTH,
+	.height = OV8865_PIXEL_ARRAY_HEIGHT,
+};
+
+static void ov8865_regcache_update(struct ov8865_dev *sensor, u16 reg,
+				   const u8 *vals, unsigned int len)
+{
+	unsigned int skip;
+
+	/*
+	 * A software reset brings every register back to its default, so
+	 * only what is written after it is known.
+	 */
+	if (reg <= OV8865_SW_RESET_REG && reg + len > OV8865_SW_RESET_REG &&
+	    (vals[OV8865_SW_RESET_REG - reg] & BIT(0))) {
+		sensor_regcache_invalidate(&sensor->regcache);
+
+		skip = OV8865_SW_RESET_REG - reg + 1;
+		reg += skip;
+		vals += skip;
+		len -= skip;
+	}
+
+	sensor_regcache_write_burst(&sensor->regcache, reg, vals, len);
+}
+
 static int ov8865_write_reg(struct ov8865_dev *sensor, u16 reg, u8 val)
 {
 	struct i2c_client *client = sensor->i2c_client;
 	struct i2c_msg msg = { 0 };
+	ktime_t start;
 	u8 buf[3];
 	int ret;
 
@@ -1065,38 +1248,72 @@ static int ov8865_write_reg(struct ov8865_dev *sensor, u16 reg, u8 val)
 	msg.buf = buf;
 	msg.len = sizeof(buf);
 
+	start = ktime_get();
 	ret = i2c_transfer(client->adapter, &msg, 1);
+	sensor_stats_xfer(&sensor->stats, SENSOR_STATS_WRITE, reg, 1, start,
+			  ret);
 	if (ret < 0) {
 		dev_err(&client->dev, "%s: error: reg=%x, val=%x\n",
 			__func__, reg, val);
 		return ret;
 	}
 
+	ov8865_regcache_update(sensor, reg, &val, 1);
+
 	return 0;
 }
 
-static int ov8865_write_reg16(struct ov8865_dev *sensor, u16 reg, u16 val)
+static int ov8865_i2c_write(struct ov8865_dev *sensor, u16 len, u8 *data)
 {
+	struct i2c_client *client = sensor->i2c_client;
+	struct i2c_msg msg = { 0 };
+	ktime_t start;
 	int ret;
 
-	ret = ov8865_write_reg(sensor, reg, val >> 8);
-	if (ret)
-		return ret;
+	msg.addr = client->addr;
+	msg.flags = client->flags;
+	msg.buf = data;
+	msg.len = len;
 
-	ret = ov8865_write_reg(sensor, reg + 1, val & 0xff);
-	if (ret)
+	start = ktime_get();
+	ret = i2c_transfer(client->adapter, &msg, 1);
+	sensor_stats_xfer(&sensor->stats, SENSOR_STATS_WRITE,
+			  (data[0] << 8) | data[1], len - 2, start, ret);
+	if (ret < 0) {
+		dev_err(&client->dev, "%s: error: reg=%x, len=%u\n",
+			__func__, (data[0] << 8) | data[1], len - 2);
 		return ret;
+	}
+
+	ov8865_regcache_update(sensor, (data[0] << 8) | data[1], data + 2,
+			       len - 2);
 
 	return 0;
 }
 
+static int ov8865_write_reg16(struct ov8865_dev *sensor, u16 reg, u16 val)
+{
+	u8 buf[4];
+
+	buf[0] = reg >> 8;
+	buf[1] = reg & 0xff;
+	buf[2] = val >> 8;
+	buf[3] = val & 0xff;
+
+	return ov8865_i2c_write(sensor, sizeof(buf), buf);
+}
+
 static int ov8865_read_reg(struct ov8865_dev *sensor, u16 reg, u8 *val)
 {
 	struct i2c_client *client = sensor->i2c_client;
 	struct i2c_msg msg[2]  = { 0 };
+	ktime_t start;
 	u8 buf[2];
 	int ret = 0;
 
+	if (sensor_regcache_read(&sensor->regcache, reg, val))
+		return 0;
+
 	buf[0] = reg >> 8;
 	buf[1] = reg & 0xff;
 
@@ -1111,13 +1328,17 @@ static int ov8865_read_reg(struct ov8865_dev *sensor, u16 reg, u8 *val)
 	msg[1].buf = buf;
 	msg[1].len = 1;
 
+	start = ktime_get();
 	ret = i2c_transfer(client->adapter, msg, 2);
+	sensor_stats_xfer(&sensor->stats, SENSOR_STATS_READ, reg, 1, start,
+			  ret);
 	if (ret < 0) {
 		dev_err(&client->dev, "%s: error: reg=%x\n", __func__, reg);
 		return ret;
 	}
 
 	*val = buf[0];
+	sensor_regcache_write(&sensor->regcache, reg, *val);
 
 	return 0;
 }
@@ -1140,6 +1361,42 @@ static int ov8865_read_reg16(struct ov8865_dev *sensor, u16 reg, u16 *val)
 	return 0;
 }
 
+/* Sequential read of @len registers, bypassing the register cache. */
+static int ov8865_read_burst(struct ov8865_dev *sensor, u16 reg, u8 *val,
+			     u16 len)
+{
+	struct i2c_client *client = sensor->i2c_client;
+	struct i2c_msg msg[2]  = { 0 };
+	ktime_t start;
+	u8 buf[2];
+	int ret;
+
+	buf[0] = reg >> 8;
+	buf[1] = reg & 0xff;
+
+	msg[0].addr = client->addr;
+	msg[0].flags = client->flags;
+	msg[0].buf = buf;
+	msg[0].len = sizeof(buf);
+
+	msg[1].addr = client->addr;
+	msg[1].flags =  I2C_M_RD;
+	msg[1].buf = val;
+	msg[1].len = len;
+
+	start = ktime_get();
+	ret = i2c_transfer(client->adapter, msg, 2);
+	sensor_stats_xfer(&sensor->stats, SENSOR_STATS_READ, reg, len, start,
+			  ret);
+	if (ret < 0) {
+		dev_err(&client->dev, "%s: error: reg=%x, len=%u\n",
+			__func__, reg, len);
+		return ret;
+	}
+
+	return 0;
+}
+
 static int ov8865_mod_reg(struct ov8865_dev *sensor, u16 reg, u8 mask, u8 val)
 {
 	u8 readval;
@@ -1149,9 +1406,10 @@ static int ov8865_mod_reg(struct ov8865_dev *sensor, u16 reg, u8 mask, u8 val)
 	if (ret)
 		return ret;
 
-	readval &= ~mask;
-	val &= mask;
-	val |= readval;
+	val = (readval & ~mask) | (val & mask);
+	if (val == readval &&
+	    !sensor_regcache_is_volatile(&sensor->regcache, reg))
+		return 0;
 
 	ret = ov8865_write_reg(sensor, reg, val);
 	if (ret)
@@ -1163,40 +1421,31 @@ static int ov8865_mod_reg(struct ov8865_dev *sensor, u16 reg, u8 mask, u8 val)
 static int ov8865_set_timings(struct ov8865_dev *sensor,
 			      const struct ov8865_mode_info *mode)
 {
+	const struct v4l2_rect *crop = &sensor->crop;
 	int ret;
 	u8 isp_y_win_l, x_inc_odd, format2, y_inc_odd,
 	   y_inc_even, blc_num_option, zline_num_option,
 	   boundary_pix_num;
 
-	ret = ov8865_write_reg(sensor, OV8865_X_ADDR_START_H_REG, 0x00);
-	if (ret)
-		return ret;
-
-	ret = ov8865_write_reg(sensor, OV8865_X_ADDR_START_L_REG, 0x0c);
-	if (ret)
-		return ret;
-
-	ret = ov8865_write_reg(sensor, OV8865_Y_ADDR_START_H_REG, 0x00);
+	ret = ov8865_write_reg16(sensor, OV8865_X_ADDR_START_REG,
+				 crop->left - OV8865_WIN_PAD_X);
 	if (ret)
 		return ret;
 
-	ret = ov8865_write_reg(sensor, OV8865_Y_ADDR_START_L_REG, 0x0c);
+	ret = ov8865_write_reg16(sensor, OV8865_Y_ADDR_START_REG,
+				 crop->top - OV8865_WIN_PAD_TOP);
 	if (ret)
 		return ret;
 
-	ret = ov8865_write_reg(sensor, OV8865_X_ADDR_END_H_REG, 0x0c);
+	ret = ov8865_write_reg16(sensor, OV8865_X_ADDR_END_REG,
+				 crop->left + crop->width +
+				 OV8865_WIN_PAD_X - 1);
 	if (ret)
 		return ret;
 
-	ret = ov8865_write_reg(sensor, OV8865_X_ADDR_END_L_REG, 0xd3);
-	if (ret)
-		return ret;
-
-	ret = ov8865_write_reg(sensor, OV8865_Y_ADDR_END_H_REG, 0x09);
-	if (ret)
-		return ret;
-
-	ret = ov8865_write_reg(sensor, OV8865_Y_ADDR_END_L_REG, 0xa3);
+	ret = ov8865_write_reg16(sensor, OV8865_Y_ADDR_END_REG,
+				 crop->top + crop->height +
+				 OV8865_WIN_PAD_BOTTOM - 1);
 	if (ret)
 		return ret;
 
@@ -1212,6 +1461,8 @@ static int ov8865_set_timings(struct ov8865_dev *sensor,
 	if (ret)
 		return ret;
 
+	sensor->hts = mode->htot;
+
 	ret = ov8865_write_reg16(sensor, OV8865_VTS_REG, mode->vtot);
 	if (ret)
 		return ret;
@@ -1310,41 +1561,102 @@ static int ov8865_set_timings(struct ov8865_dev *sensor,
 	return 0;
 }
 
-static int ov8865_get_hts(struct ov8865_dev *sensor)
+/*
+ * ov8865_load_regs - Write the register list of a mode
+ *
+ * Runs of consecutive register addresses are coalesced into a single
+ * i2c_transfer(), in the same way as ov5693_write_reg_array(). An entry
+ * carrying a delay_ms is a flush point: everything buffered up to and
+ * including it is sent before sleeping. Tables that have a packed version
+ * generated by misc/pack_sensor_regs are sent as is instead.
+ *
+ * __ov8865_flush_reg_array(), __ov8865_buf_reg_array() and
+ * __ov8865_write_reg_is_consecutive() are internal functions to
+ * ov8865_load_regs() and should not be used anywhere else.
+ */
+
+static int __ov8865_flush_reg_array(struct ov8865_dev *sensor,
+				    struct ov8865_write_ctrl *ctrl)
 {
-	u16 hts;
-	int ret;
+	u16 size;
+	__be16 *reg = (void *)&ctrl->buffer.addr;
 
-	ret = ov8865_read_reg16(sensor, OV8865_HTS_REG, &hts);
-	if (ret)
-		return ret;
-	return hts;
+	if (ctrl->index == 0)
+		return 0;
+
+	size = sizeof(u16) + ctrl->index; /* 16-bit address + data */
+
+	*reg = cpu_to_be16(ctrl->buffer.addr);
+	ctrl->index = 0;
+
+	return ov8865_i2c_write(sensor, size, (u8 *)reg);
+}
+
+static int __ov8865_buf_reg_array(struct ov8865_dev *sensor,
+				  struct ov8865_write_ctrl *ctrl,
+				  const struct reg_value *next)
+{
+	/* When first item is added, we need to store its starting address */
+	if (ctrl->index == 0)
+		ctrl->buffer.addr = next->reg_addr;
+
+	ctrl->buffer.data[ctrl->index++] = next->val;
+
+	if (ctrl->index >= OV8865_MAX_WRITE_BUF_SIZE)
+		return __ov8865_flush_reg_array(sensor, ctrl);
+
+	return 0;
+}
+
+static bool __ov8865_write_reg_is_consecutive(struct ov8865_write_ctrl *ctrl,
+					      const struct reg_value *next)
+{
+	if (ctrl->index == 0)
+		return true;
+
+	return ctrl->buffer.addr + ctrl->index == next->reg_addr;
 }
 
 static int ov8865_load_regs(struct ov8865_dev *sensor,
 			     const struct ov8865_mode_info *mode)
 {
 	const struct reg_value *regs = mode->reg_data;
+	struct ov8865_write_ctrl ctrl;
 	unsigned int i;
-	u32 delay_ms = 0;
-	u16 reg_addr;
-	u8 val;
-	int ret = 0;
+	u32 delay_ms;
+	int ret;
+
+	if (mode->packed.data)
+		return sensor_burst_write(sensor->i2c_client, &mode->packed,
+					  &sensor->regcache, &sensor->stats);
 
+	ctrl.index = 0;
 	for (i = 0; i < mode->reg_data_size; i++, regs++) {
-		delay_ms = regs->delay_ms;
-		reg_addr = regs->reg_addr;
-		val = regs->val;
+		/*
+		 * If next address is not consecutive, data needs to be
+		 * flushed before proceed.
+		 */
+		if (!__ov8865_write_reg_is_consecutive(&ctrl, regs)) {
+			ret = __ov8865_flush_reg_array(sensor, &ctrl);
+			if (ret)
+				return ret;
+		}
 
-		ret = ov8865_write_reg(sensor, reg_addr, val);
+		ret = __ov8865_buf_reg_array(sensor, &ctrl, regs);
 		if (ret)
 			return ret;
 
-		if (delay_ms)
+		delay_ms = regs->delay_ms;
+		if (delay_ms) {
+			ret = __ov8865_flush_reg_array(sensor, &ctrl);
+			if (ret)
+				return ret;
+
 			usleep_range(1000 * delay_ms, 1000 * delay_ms + 100);
+		}
 	}
 
-	return 0;
+	return __ov8865_flush_reg_array(sensor, &ctrl);
 }
 
 static const struct ov8865_mode_info *
@@ -1564,29 +1876,6 @@ static int ov8865_set_black_level(struct ov8865_dev *sensor)
 	return 0;
 }
 
-static int ov8865_set_pclk(struct ov8865_dev *sensor)
-{
-	int ret;
-
-	ret = ov8865_write_reg(sensor, OV8865_PLL_CTRL2_REG, 0x1e);
-	if (ret)
-		return ret;
-
-	ret = ov8865_write_reg(sensor, OV8865_PLL_CTRL3_REG, 0x00);
-	if (ret)
-		return ret;
-
-	ret = ov8865_write_reg(sensor, OV8865_PLL_CTRL4_REG, 0x03);
-	if (ret)
-		return ret;
-
-	ret = ov8865_write_reg(sensor, OV8865_CLOCK_SEL_REG, 0x93);
-	if (ret)
-		return ret;
-
-	return 0;
-}
-
 static int ov8865_get_pclk(struct ov8865_dev *sensor)
 {
 	int ret;
@@ -1635,6 +1924,36 @@ static int ov8865_get_pclk(struct ov8865_dev *sensor)
 	return ref_clk * pll1_mult / (1 + m_div) / mipi_div / pclk_div;
 }
 
+static int ov8865_set_pclk(struct ov8865_dev *sensor)
+{
+	int ret;
+
+	ret = ov8865_write_reg(sensor, OV8865_PLL_CTRL2_REG, 0x1e);
+	if (ret)
+		return ret;
+
+	ret = ov8865_write_reg(sensor, OV8865_PLL_CTRL3_REG, 0x00);
+	if (ret)
+		return ret;
+
+	ret = ov8865_write_reg(sensor, OV8865_PLL_CTRL4_REG, 0x03);
+	if (ret)
+		return ret;
+
+	ret = ov8865_write_reg(sensor, OV8865_CLOCK_SEL_REG, 0x93);
+	if (ret)
+		return ret;
+
+	/* Answered from the register cache, the PLL was just written */
+	ret = ov8865_get_pclk(sensor);
+	if (ret <= 0)
+		return ret ? ret : -EINVAL;
+
+	sensor->pclk = ret;
+
+	return 0;
+}
+
 static int ov8865_set_sclk(struct ov8865_dev *sensor)
 {
 	const struct ov8865_mode_info *mode = sensor->current_mode;
@@ -1684,6 +2003,59 @@ static int ov8865_set_virtual_channel(struct ov8865_dev *sensor, u8 channel)
 	return 0;
 }
 
+/*
+ * Longest exposure the frame length allows, in the 100us units of
+ * V4L2_CID_EXPOSURE. Unknown until a mode is programmed, as the line time
+ * comes from the PLL. With sensor->lock held.
+ */
+static void ov8865_update_exposure_range(struct ov8865_dev *sensor)
+{
+	const struct ov8865_mode_info *mode = sensor->current_mode;
+	struct v4l2_ctrl *exposure = sensor->ctrls.exposure;
+	s64 max;
+
+	if (!sensor->line_time)
+		return;
+
+	max = mode->vact + sensor->ctrls.vblank->val - OV8865_EXPOSURE_MARGIN;
+	max = max_t(s64, max * sensor->line_time / 100, exposure->minimum);
+
+	__v4l2_ctrl_modify_range(exposure, exposure->minimum, max,
+				 exposure->step,
+				 min(exposure->default_value, max));
+}
+
+/* Blanking of a new mode, with sensor->lock held */
+static void ov8865_update_blanking(struct ov8865_dev *sensor)
+{
+	const struct ov8865_mode_info *mode = sensor->current_mode;
+	struct ov8865_ctrls *ctrls = &sensor->ctrls;
+	s64 vblank_def = mode->vtot - mode->vact;
+
+	__v4l2_ctrl_modify_range(ctrls->vblank, OV8865_VBLANK_MIN,
+				 OV8865_VTS_MAX - mode->vact, 1, vblank_def);
+	__v4l2_ctrl_s_ctrl(ctrls->vblank, vblank_def);
+}
+
+/*
+ * HTS * (vact + vblank) over the sensor clock, with sensor->lock held. The
+ * clock is the one the table mode runs at its nominal frame rate, a crop
+ * keeps the clocks of the full size mode it was made from.
+ */
+static void ov8865_get_interval(struct ov8865_dev *sensor,
+				struct v4l2_fract *interval)
+{
+	const struct ov8865_mode_info *mode = sensor->current_mode;
+	const struct ov8865_mode_info *table = &ov8865_mode_data[mode->id];
+	u32 num = mode->htot * (mode->vact + sensor->ctrls.vblank->val);
+	u32 den = table->htot * table->vtot *
+		  ov8865_framerates[sensor->current_fr];
+	unsigned long div = gcd(num, den);
+
+	interval->numerator = num / div;
+	interval->denominator = den / div;
+}
+
 static int ov8865_set_mode(struct ov8865_dev *sensor)
 {
 	const struct ov8865_mode_info *mode = sensor->current_mode;
@@ -1713,12 +2085,15 @@ static int ov8865_set_mode(struct ov8865_dev *sensor)
 	if (ret < 0)
 		return ret;
 
+	sensor->line_time = sensor->hts / sensor->pclk;
 	sensor->last_mode = mode;
+	ov8865_update_exposure_range(sensor);
 	return 0;
 }
 
 static int ov8865_restore_mode(struct ov8865_dev *sensor)
 {
+	ktime_t start = ktime_get();
 	int ret;
 
 	ret = ov8865_load_regs(sensor, &ov8865_mode_init_data);
@@ -1726,11 +2101,15 @@ static int ov8865_restore_mode(struct ov8865_dev *sensor)
 		return ret;
 
 	sensor->last_mode = &ov8865_mode_init_data;
+	sensor_stats_phase(&sensor->stats, SENSOR_STATS_GLOBAL_REGS, start);
 
+	start = ktime_get();
 	ret = ov8865_set_mode(sensor);
 	if (ret)
 		return ret;
 
+	sensor_stats_phase(&sensor->stats, SENSOR_STATS_MODE_REGS, start);
+
 	return 0;
 }
 
@@ -1744,54 +2123,10 @@ static void ov8865_reset(struct ov8865_dev *sensor, bool enable)
 	gpiod_set_value_cansleep(sensor->reset_gpio, enable ? 0 : 1);
 }
 
-/* Get GPIOs defined in dep_dev _CRS */
-static int gpio_crs_get(struct ov8865_dev *sensor, struct device *dep_dev)
-{
-	sensor->xshutdn = devm_gpiod_get_index(dep_dev, NULL, 0, GPIOD_ASIS);
-	if (IS_ERR(sensor->xshutdn)) {
-		dev_err(dep_dev, "Couldn't get GPIO XSHUTDN\n");
-		return -EINVAL;
-	}
-
-	sensor->pwdnb = devm_gpiod_get_index(dep_dev, NULL, 1, GPIOD_ASIS);
-	if (IS_ERR(sensor->pwdnb)) {
-		dev_err(dep_dev, "Couldn't get GPIO PWDNB\n");
-		return -EINVAL;
-	}
-
-	sensor->led_gpio = devm_gpiod_get_index(dep_dev, NULL, 2, GPIOD_ASIS);
-	if (IS_ERR(sensor->led_gpio))
-		dev_info(dep_dev,
-			 "Couldn't get GPIO LED. Maybe not exist, continue anyway.\n");
-
-	return 0;
-}
-
-/* Put GPIOs defined in dep_dev _CRS */
-static void gpio_crs_put(struct ov8865_dev *sensor)
-{
-	gpiod_put(sensor->xshutdn);
-	gpiod_put(sensor->pwdnb);
-	if (!IS_ERR(sensor->led_gpio))
-		gpiod_put(sensor->led_gpio);
-}
-
-/* Control GPIOs defined in dep_dev _CRS */
-static int gpio_crs_ctrl(struct v4l2_subdev *sd, bool flag)
-{
-	struct ov8865_dev *sensor = to_ov8865_dev(sd);
-
-	gpiod_set_value_cansleep(sensor->xshutdn, flag);
-	gpiod_set_value_cansleep(sensor->pwdnb, flag);
-	if (!IS_ERR(sensor->led_gpio))
-		gpiod_set_value_cansleep(sensor->led_gpio, flag);
-
-	return 0;
-}
-
 static int ov8865_set_power_on(struct ov8865_dev *sensor)
 {
 	struct i2c_client *client = sensor->i2c_client;
+	ktime_t start = ktime_get();
 	int ret = 0;
 
 	/* For DT-based systems */
@@ -1821,12 +2156,22 @@ static int ov8865_set_power_on(struct ov8865_dev *sensor)
 
 	/* For ACPI-based systems */
 	if (sensor->is_acpi_based) {
-		gpio_crs_ctrl(&sensor->sd, true);
+		int3472_dep_set_power(sensor->dep, true);
 
-		/* Add some delay. This is required or check_chip_id() will fail. */
-		usleep_range(10000, 12000);
+		/* Wait until the sensor answers, or check_chip_id() will fail */
+		ret = sensor_settle_wait(client, OV8865_CHIP_ID_REG + 1,
+					 (OV8865_CHIP_ID >> 8) & 0xff,
+					 OV8865_SETTLE_TIMEOUT_US,
+					 &sensor->settle, &sensor->stats);
+		if (ret) {
+			int3472_dep_set_power(sensor->dep, false);
+			return ret;
+		}
 	}
 
+	sensor_stats_power(&sensor->stats, true);
+	sensor_stats_phase(&sensor->stats, SENSOR_STATS_POWER_ON, start);
+
 	return 0;
 
 err_power_off:
@@ -1849,29 +2194,35 @@ static void ov8865_set_power_off(struct ov8865_dev *sensor)
 
 	/* For ACPI-based systems */
 	if (sensor->is_acpi_based)
-		gpio_crs_ctrl(&sensor->sd, false);
+		int3472_dep_set_power(sensor->dep, false);
+
+	sensor_stats_power(&sensor->stats, false);
+	sensor_regcache_invalidate(&sensor->regcache);
+	sensor->last_mode = NULL;
 }
 
 static int ov8865_set_power(struct ov8865_dev *sensor, bool on)
 {
+	struct device *dev = &sensor->i2c_client->dev;
 	int ret = 0;
 
 	if (on) {
-		ret = ov8865_set_power_on(sensor);
-		if (ret)
-			return ret;
+		ret = pm_runtime_get_sync(dev);
+		if (ret < 0)
+			goto err_rpm_put;
 
 		ret = ov8865_restore_mode(sensor);
 		if (ret)
-			goto err_power_off;
+			goto err_rpm_put;
 	} else {
-		ov8865_set_power_off(sensor);
+		pm_runtime_mark_last_busy(dev);
+		pm_runtime_put_autosuspend(dev);
 	}
 
 	return 0;
 
-err_power_off:
-	ov8865_set_power_off(sensor);
+err_rpm_put:
+	pm_runtime_put_noidle(dev);
 	return ret;
 }
 
@@ -2037,8 +2388,17 @@ static int ov8865_set_fmt(struct v4l2_subdev *sd,
 	else
 		ret = -EINVAL;
 
-	if (new_mode != sensor->current_mode)
+	/* The modes read the whole array */
+	if (format->which == V4L2_SUBDEV_FORMAT_TRY)
+		*v4l2_subdev_get_try_crop(sd, cfg, 0) = ov8865_default_crop;
+	else
+		sensor->crop = ov8865_default_crop;
+
+	if (format->which == V4L2_SUBDEV_FORMAT_ACTIVE &&
+	    new_mode != sensor->current_mode) {
 		sensor->current_mode = new_mode;
+		ov8865_update_blanking(sensor);
+	}
 
 	__v4l2_ctrl_s_ctrl_int64(sensor->ctrls.pixel_rate,
 				 ov8865_calc_pixel_rate(sensor));
@@ -2048,19 +2408,120 @@ out:
 	return ret;
 }
 
-static int ov8865_set_ctrl_hflip(struct ov8865_dev *sensor, int value)
+static int ov8865_get_selection(struct v4l2_subdev *sd,
+				struct v4l2_subdev_pad_config *cfg,
+				struct v4l2_subdev_selection *sel)
 {
-	return ov8865_mod_reg(sensor, OV8865_FORMAT2_REG,
-			      OV8865_FORMAT2_MIRROR_DIG |
-			      OV8865_FORMAT2_MIRROR_ARR,
-			      (!(value ^ sensor->upside_down)) ?
-			      (OV8865_FORMAT2_MIRROR_DIG |
-			       OV8865_FORMAT2_MIRROR_ARR) : 0);
-}
+	struct ov8865_dev *sensor = to_ov8865_dev(sd);
 
-static int ov8865_set_ctrl_vflip(struct ov8865_dev *sensor, int value)
-{
-	return ov8865_mod_reg(sensor, OV8865_FORMAT1_REG,
+	if (sel->pad != 0)
+		return -EINVAL;
+
+	switch (sel->target) {
+	case V4L2_SEL_TGT_CROP:
+		mutex_lock(&sensor->lock);
+		if (sel->which == V4L2_SUBDEV_FORMAT_TRY)
+			sel->r = *v4l2_subdev_get_try_crop(sd, cfg, 0);
+		else
+			sel->r = sensor->crop;
+		mutex_unlock(&sensor->lock);
+		return 0;
+	case V4L2_SEL_TGT_NATIVE_SIZE:
+		sel->r.left = 0;
+		sel->r.top = 0;
+		sel->r.width = OV8865_NATIVE_WIDTH;
+		sel->r.height = OV8865_NATIVE_HEIGHT;
+		return 0;
+	case V4L2_SEL_TGT_CROP_DEFAULT:
+	case V4L2_SEL_TGT_CROP_BOUNDS:
+		sel->r = ov8865_default_crop;
+		return 0;
+	default:
+		return -EINVAL;
+	}
+}
+
+/*
+ * The crop is read out in full size and sent as is, so it also sets the
+ * format. Fewer lines make for a shorter frame, the frame length goes
+ * down to the crop height plus the minimum blanking.
+ */
+static int ov8865_set_selection(struct v4l2_subdev *sd,
+				struct v4l2_subdev_pad_config *cfg,
+				struct v4l2_subdev_selection *sel)
+{
+	struct ov8865_dev *sensor = to_ov8865_dev(sd);
+	const struct ov8865_mode_info *full;
+	struct v4l2_mbus_framefmt *fmt;
+	struct v4l2_rect *r = &sel->r;
+	int ret = 0;
+
+	if (sel->pad != 0 || sel->target != V4L2_SEL_TGT_CROP)
+		return -EINVAL;
+
+	/* Even sizes and offsets keep the Bayer order */
+	r->width = clamp_t(u32, ALIGN(r->width, 2), OV8865_CROP_MIN_WIDTH,
+			   OV8865_PIXEL_ARRAY_WIDTH);
+	r->height = clamp_t(u32, ALIGN(r->height, 2), OV8865_CROP_MIN_HEIGHT,
+			    OV8865_PIXEL_ARRAY_HEIGHT);
+	r->left = ALIGN_DOWN(clamp_t(s32, r->left, OV8865_PIXEL_ARRAY_LEFT,
+				     OV8865_PIXEL_ARRAY_LEFT +
+				     OV8865_PIXEL_ARRAY_WIDTH - r->width), 2);
+	r->top = ALIGN_DOWN(clamp_t(s32, r->top, OV8865_PIXEL_ARRAY_TOP,
+				    OV8865_PIXEL_ARRAY_TOP +
+				    OV8865_PIXEL_ARRAY_HEIGHT - r->height), 2);
+
+	mutex_lock(&sensor->lock);
+
+	if (sel->which == V4L2_SUBDEV_FORMAT_TRY) {
+		*v4l2_subdev_get_try_crop(sd, cfg, 0) = *r;
+		fmt = v4l2_subdev_get_try_format(sd, cfg, 0);
+		fmt->width = r->width;
+		fmt->height = r->height;
+		goto out;
+	}
+
+	if (sensor->streaming) {
+		ret = -EBUSY;
+		goto out;
+	}
+
+	full = &ov8865_mode_data[OV8865_MODE_QUXGA_3264_2448];
+
+	sensor->crop = *r;
+	sensor->crop_mode = *full;
+	sensor->crop_mode.hact = r->width;
+	sensor->crop_mode.vact = r->height;
+	sensor->crop_mode.vtot = r->height + full->vtot - full->vact;
+
+	sensor->current_mode = &sensor->crop_mode;
+	/* reprogram the window on the next stream on */
+	sensor->last_mode = NULL;
+	sensor->fmt.width = r->width;
+	sensor->fmt.height = r->height;
+	ov8865_update_blanking(sensor);
+
+	__v4l2_ctrl_s_ctrl_int64(sensor->ctrls.pixel_rate,
+				 ov8865_calc_pixel_rate(sensor));
+
+out:
+	mutex_unlock(&sensor->lock);
+	return ret;
+}
+
+static int ov8865_set_ctrl_hflip(struct ov8865_dev *sensor, int value)
+{
+	return ov8865_mod_reg(sensor, OV8865_FORMAT2_REG,
+			      OV8865_FORMAT2_MIRROR_DIG |
+			      OV8865_FORMAT2_MIRROR_ARR,
+			      (!(value ^ sensor->upside_down)) ?
+			      (OV8865_FORMAT2_MIRROR_DIG |
+			       OV8865_FORMAT2_MIRROR_ARR) : 0);
+}
+
+static int ov8865_set_ctrl_vflip(struct ov8865_dev *sensor, int value)
+{
+	return ov8865_mod_reg(sensor, OV8865_FORMAT1_REG,
 			      OV8865_FORMAT1_MIRROR_DIG |
 			      OV8865_FORMAT1_MIRROR_ARR,
 			      (value ^ sensor->upside_down) ?
@@ -2070,7 +2531,7 @@ static int ov8865_set_ctrl_vflip(struct ov8865_dev *sensor, int value)
 
 static int ov8865_get_exposure(struct ov8865_dev *sensor)
 {
-	int exp, ret, pclk, hts, line_time;
+	int exp, ret;
 	u8 temp;
 
 	ret = ov8865_read_reg(sensor, OV8865_EXPOSURE_CTRL_HH_REG, &temp);
@@ -2088,26 +2549,12 @@ static int ov8865_get_exposure(struct ov8865_dev *sensor)
 		return ret;
 	exp |= (int)temp;
 
-	ret = ov8865_get_pclk(sensor);
-	if (ret <= 0)
-		return ret;
-
-	pclk = ret;
-
-	ret = ov8865_get_hts(sensor);
-	if (ret <= 0)
-		return ret;
-
-	hts = ret;
-
-	line_time = hts / pclk;
-
 	/* The low 4 bits of exposure are the fractional part. And the unit is
 	 * 1/16 of a line lecture time. The pclk and HTS are used to calculate
 	 * this time. For V4L2, the value 1 of exposure stands for 100us of
 	 * capture.
 	 */
-	return (exp >> 4) * line_time / 16 / 100;
+	return (exp >> 4) * sensor->line_time / 16 / 100;
 }
 
 static int ov8865_get_gain(struct ov8865_dev *sensor)
@@ -2126,7 +2573,7 @@ static int ov8865_get_gain(struct ov8865_dev *sensor)
 static int ov8865_set_ctrl_exp(struct ov8865_dev *sensor)
 {
 	struct ov8865_ctrls *ctrls = &sensor->ctrls;
-	int ret = 0, hts, pclk, line_time;
+	int ret = 0;
 	int exposure = ctrls->exposure->val;
 	/* The low 4 bits of exposure are the fractional part. And the unit is
 	 * 1/16 of a line lecture time. The pclk and HTS are used to calculate
@@ -2134,34 +2581,24 @@ static int ov8865_set_ctrl_exp(struct ov8865_dev *sensor)
 	 * capture.
 	 */
 
-	ret = ov8865_get_pclk(sensor);
-	if (ret <= 0)
-		return ret;
-	pclk = ret;
-
-	ret = ov8865_get_hts(sensor);
-	if (ret <= 0)
-		return ret;
-	hts = ret;
-
-	line_time = hts / pclk;
+	/* No mode programmed yet */
+	if (!sensor->line_time)
+		return -EINVAL;
 
-	exposure = ctrls->exposure->val * 16 / line_time * 100;
+	exposure = ctrls->exposure->val * 16 / sensor->line_time * 100;
 	exposure = (exposure << 4);
 
 	if (ctrls->exposure->is_new) {
-		ret = ov8865_write_reg(sensor, OV8865_EXPOSURE_CTRL_L_REG,
-				       exposure & 0xff);
-		if (ret)
-			return ret;
+		u8 buf[5];
 
-		ret = ov8865_write_reg(sensor, OV8865_EXPOSURE_CTRL_H_REG,
-				       (exposure >> 8) & 0xff);
-		if (ret)
-			return ret;
+		/* HH, H and L are consecutive, write them in one message */
+		buf[0] = OV8865_EXPOSURE_CTRL_HH_REG >> 8;
+		buf[1] = OV8865_EXPOSURE_CTRL_HH_REG & 0xff;
+		buf[2] = (exposure >> 16) & 0x0f;
+		buf[3] = (exposure >> 8) & 0xff;
+		buf[4] = exposure & 0xff;
 
-		ret = ov8865_write_reg(sensor, OV8865_EXPOSURE_CTRL_HH_REG,
-				       (exposure >> 16) & 0x0f);
+		ret = ov8865_i2c_write(sensor, sizeof(buf), buf);
 	}
 
 	return ret;
@@ -2180,6 +2617,75 @@ static int ov8865_set_ctrl_gain(struct ov8865_dev *sensor)
 	return ret;
 }
 
+/* Exposure and gain form a control cluster, written by one s_ctrl */
+static int ov8865_set_ctrl_exp_gain(struct ov8865_dev *sensor)
+{
+	int ret;
+
+	ret = ov8865_set_ctrl_exp(sensor);
+	if (!ret)
+		ret = ov8865_set_ctrl_gain(sensor);
+
+	return ret;
+}
+
+/*
+ * While streaming, control writes go into a group hold, so that all the
+ * controls set by one VIDIOC_S_EXT_CTRLS land in the same frame. The first
+ * write opens the group and queues group_work, which needs sensor->lock
+ * and so only launches the group once the control handler is done with
+ * the whole batch.
+ */
+static int ov8865_group_hold(struct ov8865_dev *sensor)
+{
+	int ret;
+
+	if (sensor->group_open)
+		return 0;
+
+	ret = ov8865_write_reg(sensor, OV8865_GROUP_ACCESS_REG,
+			       OV8865_GROUP_ACCESS_START);
+	if (ret)
+		return ret;
+
+	sensor->group_open = true;
+	schedule_work(&sensor->group_work);
+
+	return 0;
+}
+
+/* Close and launch an open group, with sensor->lock held */
+static int ov8865_group_launch(struct ov8865_dev *sensor)
+{
+	int ret;
+
+	if (!sensor->group_open)
+		return 0;
+
+	sensor->group_open = false;
+
+	ret = ov8865_write_reg(sensor, OV8865_GROUP_ACCESS_REG,
+			       OV8865_GROUP_ACCESS_END);
+	if (!ret)
+		ret = ov8865_write_reg(sensor, OV8865_GROUP_ACCESS_REG,
+				       OV8865_GROUP_ACCESS_LAUNCH);
+	if (ret)
+		dev_err(&sensor->i2c_client->dev, "group launch failed: %d\n",
+			ret);
+
+	return ret;
+}
+
+static void ov8865_group_work(struct work_struct *work)
+{
+	struct ov8865_dev *sensor = container_of(work, struct ov8865_dev,
+						 group_work);
+
+	mutex_lock(&sensor->lock);
+	ov8865_group_launch(sensor);
+	mutex_unlock(&sensor->lock);
+}
+
 static int ov8865_g_volatile_ctrl(struct v4l2_ctrl *ctrl)
 {
 	struct v4l2_subdev *sd = ctrl_to_sd(ctrl);
@@ -2210,17 +2716,33 @@ static int ov8865_s_ctrl(struct v4l2_ctrl *ctrl)
 {
 	struct v4l2_subdev *sd = ctrl_to_sd(ctrl);
 	struct ov8865_dev *sensor = to_ov8865_dev(sd);
+	struct i2c_client *client = sensor->i2c_client;
 	int ret;
 
-	if (sensor->power_count == 0)
+	/* Keep the exposure within the new frame length */
+	if (ctrl->id == V4L2_CID_VBLANK)
+		ov8865_update_exposure_range(sensor);
+
+	/*
+	 * Applied by v4l2_ctrl_handler_setup() on the next power up. A sensor
+	 * waiting to autosuspend keeps its mode and skips that, so write to it.
+	 */
+	if (pm_runtime_get_if_active(&client->dev, true) <= 0)
 		return 0;
 
+	if (sensor->streaming) {
+		ret = ov8865_group_hold(sensor);
+		if (ret)
+			goto out;
+	}
+
 	switch (ctrl->id) {
-	case V4L2_CID_GAIN:
-		ret = ov8865_set_ctrl_gain(sensor);
-		break;
 	case V4L2_CID_EXPOSURE:
-		ret = ov8865_set_ctrl_exp(sensor);
+		ret = ov8865_set_ctrl_exp_gain(sensor);
+		break;
+	case V4L2_CID_VBLANK:
+		ret = ov8865_write_reg16(sensor, OV8865_VTS_REG,
+					 sensor->current_mode->vact + ctrl->val);
 		break;
 	case V4L2_CID_HFLIP:
 		ret = ov8865_set_ctrl_hflip(sensor, ctrl->val);
@@ -2233,6 +2755,9 @@ static int ov8865_s_ctrl(struct v4l2_ctrl *ctrl)
 		break;
 	}
 
+out:
+	pm_runtime_put(&client->dev);
+
 	return ret;
 }
 
@@ -2244,6 +2769,7 @@ static const struct v4l2_ctrl_ops ov8865_ctrl_ops = {
 static int ov8865_init_controls(struct ov8865_dev *sensor)
 {
 	const struct v4l2_ctrl_ops *ops = &ov8865_ctrl_ops;
+	const struct ov8865_mode_info *mode = sensor->current_mode;
 	struct ov8865_ctrls *ctrls = &sensor->ctrls;
 	struct v4l2_ctrl_handler *hdl = &ctrls->handler;
 	int ret;
@@ -2263,6 +2789,15 @@ static int ov8865_init_controls(struct ov8865_dev *sensor)
 					1, 1*16);
 	ctrls->hflip = v4l2_ctrl_new_std(hdl, ops, V4L2_CID_HFLIP, 0, 1, 1, 0);
 	ctrls->vflip = v4l2_ctrl_new_std(hdl, ops, V4L2_CID_VFLIP, 0, 1, 1, 0);
+	ctrls->vblank = v4l2_ctrl_new_std(hdl, ops, V4L2_CID_VBLANK,
+					  OV8865_VBLANK_MIN,
+					  OV8865_VTS_MAX - mode->vact, 1,
+					  mode->vtot - mode->vact);
+	/*
+	 * No HBLANK: HTS counts sensor clocks rather than output pixels and
+	 * is below the width of the full size modes, so there is no line
+	 * length in pixels to report. The frame rate is set through VBLANK.
+	 */
 	if (hdl->error) {
 		ret = hdl->error;
 		goto err_free_ctrls;
@@ -2270,6 +2805,8 @@ static int ov8865_init_controls(struct ov8865_dev *sensor)
 
 	ctrls->pixel_rate->flags |= V4L2_CTRL_FLAG_READ_ONLY;
 
+	v4l2_ctrl_cluster(2, &ctrls->exposure);
+
 	sensor->sd.ctrl_handler = hdl;
 
 	return 0;
@@ -2328,7 +2865,7 @@ static int ov8865_g_frame_interval(struct v4l2_subdev *sd,
 	struct ov8865_dev *sensor = to_ov8865_dev(sd);
 
 	mutex_lock(&sensor->lock);
-	fi->interval = sensor->frame_interval;
+	ov8865_get_interval(sensor, &fi->interval);
 	mutex_unlock(&sensor->lock);
 
 	return 0;
@@ -2353,10 +2890,16 @@ static int ov8865_s_frame_interval(struct v4l2_subdev *sd,
 
 	mode = sensor->current_mode;
 
+	/* A crop has no table mode to switch to, it keeps its timings */
+	if (mode == &sensor->crop_mode) {
+		ov8865_get_interval(sensor, &fi->interval);
+		goto out;
+	}
+
 	frame_rate = ov8865_try_frame_interval(sensor, &fi->interval,
 					       mode->hact, mode->vact);
 	if (frame_rate < 0) {
-		fi->interval = sensor->frame_interval;
+		ov8865_get_interval(sensor, &fi->interval);
 		goto out;
 	}
 
@@ -2372,11 +2915,15 @@ static int ov8865_s_frame_interval(struct v4l2_subdev *sd,
 		sensor->current_fr = frame_rate;
 		sensor->frame_interval = fi->interval;
 		sensor->current_mode = mode;
+		/* back to the nominal frame length of the new rate */
+		ov8865_update_blanking(sensor);
 
 		__v4l2_ctrl_s_ctrl_int64(sensor->ctrls.pixel_rate,
 					 ov8865_calc_pixel_rate(sensor));
 	}
 
+	ov8865_get_interval(sensor, &fi->interval);
+
 out:
 	mutex_unlock(&sensor->lock);
 	return ret;
@@ -2398,39 +2945,71 @@ static int ov8865_s_stream(struct v4l2_subdev *sd, int enable)
 {
 	struct ov8865_dev *sensor = to_ov8865_dev(sd);
 	struct i2c_client *client = sensor->i2c_client;
+	ktime_t stream_start = ktime_get();
+	ktime_t start;
 	int ret = 0;
 
 	mutex_lock(&sensor->lock);
 
-	/* power_on() here before streaming for regular PCs. */
+	if (sensor->streaming == !!enable)
+		goto out;
+
+	/* the last controls are applied before stopping */
+	if (!enable)
+		ov8865_group_launch(sensor);
+
 	if (enable) {
-		ret = ov8865_set_power_on(sensor);
-		if (ret) {
+		ret = pm_runtime_get_sync(&client->dev);
+		if (ret < 0) {
 			dev_err(&client->dev, "sensor power-up error\n");
-			ov8865_set_power_off(sensor);
+			pm_runtime_put_noidle(&client->dev);
 			goto out;
 		}
-	}
 
-	if (sensor->streaming == !enable) {
-		ret = ov8865_write_reg(sensor, OV8865_SW_STANDBY_REG, enable ?
-				     OV8865_SW_STANDBY_STANDBY_N : 0x00);
-		if (ret)
-			goto out;
+		/* A warm sensor still holds the mode and the controls */
+		if (sensor->last_mode != sensor->current_mode) {
+			ret = ov8865_restore_mode(sensor);
+			if (ret)
+				goto err_rpm_put;
+
+			start = ktime_get();
+			ret = __v4l2_ctrl_handler_setup(&sensor->ctrls.handler);
+			if (ret)
+				goto err_rpm_put;
+
+			sensor_stats_phase(&sensor->stats,
+					   SENSOR_STATS_CTRL_SETUP, start);
+		}
+	}
 
+	start = ktime_get();
+	ret = ov8865_write_reg(sensor, OV8865_SW_STANDBY_REG, enable ?
+			       OV8865_SW_STANDBY_STANDBY_N : 0x00);
+	if (!ret)
 		ret = ov8865_write_reg(sensor, OV8865_MIPI_CTRL_REG,
 				       enable ? 0x72 : 0x62);
-		if (ret)
-			goto out;
 
-		if (!ret)
-			sensor->streaming = enable;
+	if (enable && ret)
+		goto err_rpm_put;
+
+	if (enable) {
+		sensor_stats_phase(&sensor->stats, SENSOR_STATS_STREAM_ON,
+				   start);
+		sensor_stats_phase(&sensor->stats, SENSOR_STATS_STREAM_START,
+				   stream_start);
 	}
 
-	/* power_off() here after streaming for regular PCs. */
-	if (!enable)
-		ov8865_set_power_off(sensor);
+	sensor->streaming = enable;
 
+	/* Keep the sensor powered for a quick restart */
+	if (!enable) {
+		pm_runtime_mark_last_busy(&client->dev);
+		pm_runtime_put_autosuspend(&client->dev);
+	}
+	goto out;
+
+err_rpm_put:
+	pm_runtime_put(&client->dev);
 out:
 	mutex_unlock(&sensor->lock);
 	return ret;
@@ -2455,6 +3034,8 @@ static const struct v4l2_subdev_pad_ops ov8865_pad_ops = {
 	.set_fmt = ov8865_set_fmt,
 	.enum_frame_size = ov8865_enum_frame_size,
 	.enum_frame_interval = ov8865_enum_frame_interval,
+	.get_selection = ov8865_get_selection,
+	.set_selection = ov8865_set_selection,
 };
 
 static const struct v4l2_subdev_ops ov8865_subdev_ops = {
@@ -2475,6 +3056,7 @@ static int ov8865_get_regulators(struct ov8865_dev *sensor)
 				       sensor->supplies);
 }
 
+/* Must be called with the sensor powered up */
 static int ov8865_check_chip_id(struct ov8865_dev *sensor)
 {
 	struct i2c_client *client = sensor->i2c_client;
@@ -2482,29 +3064,25 @@ static int ov8865_check_chip_id(struct ov8865_dev *sensor)
 	u8 chip_id_0, chip_id_1, chip_id_2;
 	u32 chip_id = 0x000000;
 
-	ret = ov8865_set_power_on(sensor);
-	if (ret)
-		return ret;
-
 	ret = ov8865_read_reg(sensor, OV8865_CHIP_ID_REG, &chip_id_0);
 	if (ret) {
 		dev_err(&client->dev, "%s: failed to reach chip identifier\n",
 			__func__);
-		goto power_off;
+		return ret;
 	}
 
 	ret = ov8865_read_reg(sensor, OV8865_CHIP_ID_REG + 1, &chip_id_1);
 	if (ret) {
 		dev_err(&client->dev, "%s: failed to reach chip identifier\n",
 			__func__);
-		goto power_off;
+		return ret;
 	}
 
 	ret = ov8865_read_reg(sensor, OV8865_CHIP_ID_REG + 2, &chip_id_2);
 	if (ret) {
 		dev_err(&client->dev, "%s: failed to reach chip identifier\n",
 			__func__);
-		goto power_off;
+		return ret;
 	}
 
 	chip_id = ((u32)chip_id_0 << 16) | ((u32)chip_id_1 << 8) |
@@ -2512,93 +3090,248 @@ static int ov8865_check_chip_id(struct ov8865_dev *sensor)
 
 	if (chip_id != OV8865_CHIP_ID) {
 		dev_err(&client->dev, "%s: wrong chip identifier, expected 0x008865, got 0x%x\n", __func__, chip_id);
-		ret = -ENXIO;
+		return -ENXIO;
 	}
 
 	dev_info(&client->dev, "ov8865 detected at address 0x%02x\n", client->addr);
 
-power_off:
-	ov8865_set_power_off(sensor);
-	return ret;
+	return 0;
 }
 
-/* Get dependent INT3472 device */
-static struct device *get_dep_dev(struct device *dev)
+/* Returns the index of the valid group in an OTP section, or -1 if none. */
+static int ov8865_otp_group(u8 flag)
 {
-	struct acpi_device *sensor_adev;
-	struct acpi_handle *dev_handle;
-	struct acpi_handle_list dep_devices;
-	struct acpi_device *dep_adev;
-	struct acpi_device_physical_node *dep_phys;
-	int ret;
 	int i;
 
-	sensor_adev = acpi_dev_get_first_match_dev(OV8865_ACPI_HID, NULL, -1);
-	if (!sensor_adev) {
-		dev_err(dev, "Couldn't get sensor ACPI device\n");
-		return ERR_PTR(-ENODEV);
+	for (i = 0; i < OV8865_OTP_NUM_GROUPS; i++)
+		if (((flag >> (6 - 2 * i)) & 0x3) == 0x1)
+			return i;
+
+	return -1;
+}
+
+static void ov8865_otp_parse(struct ov8865_dev *sensor, const u8 *data)
+{
+	struct ov8865_otp *otp = &sensor->otp;
+	const u8 *p;
+	int group;
+
+#define OTP_BYTE(addr)	(data + (addr) - OV8865_OTP_DATA_START)
+
+	memset(otp, 0, sizeof(*otp));
+
+	group = ov8865_otp_group(*OTP_BYTE(OV8865_OTP_INFO_FLAG));
+	if (group >= 0) {
+		p = OTP_BYTE(OV8865_OTP_INFO_FLAG + 1) +
+		    group * OV8865_OTP_INFO_GROUP_SIZE;
+		otp->module_id = p[0];
+		otp->lens_id = p[1];
+		otp->year = p[2];
+		otp->month = p[3];
+		otp->day = p[4];
+		otp->valid |= OV8865_OTP_VALID_INFO;
 	}
-	dev_handle = sensor_adev->handle;
-	acpi_dev_put(sensor_adev);
 
-	if (!acpi_has_method(dev_handle, "_DEP")) {
-		dev_err(dev, "No dependent devices\n");
-		return ERR_PTR(-ENODEV);
+	/* 8 MSBs of each ratio, followed by a byte with the 2 LSBs of all */
+	group = ov8865_otp_group(*OTP_BYTE(OV8865_OTP_WB_FLAG));
+	if (group >= 0) {
+		p = OTP_BYTE(OV8865_OTP_WB_FLAG + 1) +
+		    group * OV8865_OTP_WB_GROUP_SIZE;
+		otp->rg_ratio = cpu_to_le16((p[0] << 2) | ((p[4] >> 6) & 0x3));
+		otp->bg_ratio = cpu_to_le16((p[1] << 2) | ((p[4] >> 4) & 0x3));
+		otp->light_rg = cpu_to_le16((p[2] << 2) | ((p[4] >> 2) & 0x3));
+		otp->light_bg = cpu_to_le16((p[3] << 2) | (p[4] & 0x3));
+		otp->valid |= OV8865_OTP_VALID_WB;
 	}
 
-	ret = acpi_evaluate_reference(dev_handle, "_DEP", NULL, &dep_devices);
-	if (ACPI_FAILURE(ret)) {
-		dev_err(dev, "Failed to evaluate _DEP.\n");
-		return ERR_PTR(-ENODEV);
+	group = ov8865_otp_group(*OTP_BYTE(OV8865_OTP_LSC_FLAG));
+	if (group >= 0) {
+		p = OTP_BYTE(OV8865_OTP_LSC_FLAG + 1) +
+		    group * OV8865_OTP_LSC_SIZE;
+		memcpy(otp->lsc, p, OV8865_OTP_LSC_SIZE);
+		otp->valid |= OV8865_OTP_VALID_LSC;
 	}
 
-	for (i = 0; i < dep_devices.count; i++) {
-		struct acpi_device_info *info;
+#undef OTP_BYTE
+}
 
-		ret = acpi_get_object_info(dep_devices.handles[i], &info);
-		if (ACPI_FAILURE(ret)) {
-			dev_err(dev, "Error reading _DEP device info\n");
-			return ERR_PTR(-ENODEV);
-		}
+/*
+ * Load the whole OTP area into the OTP buffer and fetch it with a single
+ * sequential read. The sensor must be streaming for the load to complete,
+ * and the OTP DPC must be off as it uses the same buffer.
+ *
+ * Must be called with the sensor powered up. It leaves the init registers
+ * loaded but last_mode untouched, so the next restore_mode() still
+ * programs everything.
+ */
+static int ov8865_otp_read(struct ov8865_dev *sensor)
+{
+	struct i2c_client *client = sensor->i2c_client;
+	u8 *data;
+	int ret;
 
-		if (info->valid & ACPI_VALID_HID &&
-		    !strcmp(info->hardware_id.string, "INT3472")) {
-			if (acpi_bus_get_device(dep_devices.handles[i], &dep_adev)) {
-				dev_err(dev, "Error getting adev of dep_dev\n");
-				return ERR_PTR(-ENODEV);
-			}
+	data = kzalloc(OV8865_OTP_DATA_SIZE, GFP_KERNEL);
+	if (!data)
+		return -ENOMEM;
 
-			/* found adev of dep_dev */
-			break;
-		}
-	}
+	ret = ov8865_load_regs(sensor, &ov8865_mode_init_data);
+	if (ret)
+		goto out_free;
+
+	ret = ov8865_mod_reg(sensor, OV8865_ISP_CTRL2_REG,
+			     OV8865_ISP_CTRL2_OTP_DPC_EN, 0);
+	if (ret)
+		goto out_free;
+
+	ret = ov8865_write_reg(sensor, OV8865_SW_STANDBY_REG,
+			       OV8865_SW_STANDBY_STANDBY_N);
+	if (ret)
+		goto out_free;
+
+	ret = ov8865_write_reg(sensor, OV8865_OTP_MODE_CTRL_REG,
+			       OV8865_OTP_MODE_MANUAL);
+	if (ret)
+		goto out_stream_off;
+
+	ret = ov8865_write_reg16(sensor, OV8865_OTP_START_ADDR_REG,
+				 OV8865_OTP_DATA_START);
+	if (ret)
+		goto out_stream_off;
+
+	ret = ov8865_write_reg16(sensor, OV8865_OTP_END_ADDR_REG,
+				 OV8865_OTP_DATA_END);
+	if (ret)
+		goto out_stream_off;
+
+	ret = ov8865_write_reg(sensor, OV8865_OTP_LOAD_REG,
+			       OV8865_OTP_LOAD_START);
+	if (ret)
+		goto out_stream_off;
+
+	usleep_range(10000, 12000);
+
+	ret = ov8865_read_burst(sensor, OV8865_OTP_DATA_START, data,
+				OV8865_OTP_DATA_SIZE);
+	if (ret)
+		goto out_stream_off;
+
+	ov8865_otp_parse(sensor, data);
+
+out_stream_off:
+	ov8865_write_reg(sensor, OV8865_SW_STANDBY_REG, 0);
+out_free:
+	kfree(data);
+	return ret;
+}
+
+/* Must be called with the sensor powered up */
+static int ov8865_identify(struct ov8865_dev *sensor)
+{
+	struct device *dev = &sensor->i2c_client->dev;
+	int ret;
+
+	if (sensor->identified)
+		return 0;
+
+	ret = ov8865_check_chip_id(sensor);
+	if (ret)
+		return ret;
 
-	if (!dep_adev) {
-		dev_err(dev, "adev of dep_dev not found\n");
-		return ERR_PTR(-ENODEV);
+	/* Missing calibration data is not fatal */
+	if (sensor->has_otp) {
+		ret = ov8865_otp_read(sensor);
+		if (ret)
+			dev_warn(dev, "failed to read OTP: %d\n", ret);
+		else
+			dev_info(dev, "OTP module 0x%02x lens 0x%02x, valid 0x%x\n",
+				 sensor->otp.module_id, sensor->otp.lens_id,
+				 sensor->otp.valid);
 	}
 
-	/*
-	 * HACK: We know that the PMIC is a "discrete" PMIC, an ACPI device
-	 * that just serves as a container to list system GPIOs.
-	 *
-	 * The ACPI device has no fwnode, nor does it have a platform device.
-	 * This prevents fetching GPIOs. It however seems to be backed by the
-	 * PCI root complex (pci0000:00/0000:00:00.0) as its physical device,
-	 * and that device has its fwnode set to \_SB.PCI0.DSC1. Whether this
-	 * is correct or not is unknown, let's just get the physical device and
-	 * move on for now.
-	 */
-	dep_phys = list_first_entry_or_null(&dep_adev->physical_node_list,
-					    struct acpi_device_physical_node, node);
-	if (!dep_phys) {
-		dev_info(dev, "Error getting physical node of dep_adev\n");
-		return ERR_PTR(-ENODEV);
+	sensor->identified = true;
+
+	return 0;
+}
+
+static ssize_t otp_read(struct file *filp, struct kobject *kobj,
+			struct bin_attribute *attr, char *buf,
+			loff_t off, size_t count)
+{
+	struct i2c_client *client = to_i2c_client(kobj_to_dev(kobj));
+	struct ov8865_dev *sensor = to_ov8865_dev(i2c_get_clientdata(client));
+	int ret;
+
+	/* The OTP is read on the first power up, do it now if needed */
+	if (!sensor->identified) {
+		mutex_lock(&sensor->lock);
+		ret = pm_runtime_get_sync(&client->dev);
+		if (ret >= 0) {
+			pm_runtime_mark_last_busy(&client->dev);
+			pm_runtime_put_autosuspend(&client->dev);
+		} else {
+			pm_runtime_put_noidle(&client->dev);
+		}
+		mutex_unlock(&sensor->lock);
+		if (ret < 0)
+			return ret;
 	}
 
-	dev_info(dev, "Dependent device found: %s\n", dev_name(dep_phys->dev));
+	return memory_read_from_buffer(buf, count, &off, &sensor->otp,
+				       sizeof(sensor->otp));
+}
+static BIN_ATTR_RO(otp, sizeof(struct ov8865_otp));
+
+static struct bin_attribute *ov8865_bin_attrs[] = {
+	&bin_attr_otp,
+	NULL
+};
+
+static const struct attribute_group ov8865_attr_group = {
+	.bin_attrs = ov8865_bin_attrs,
+};
+
+/* Added by the driver core once probe succeeded, removed before remove */
+static const struct attribute_group *ov8865_attr_groups[] = {
+	&ov8865_attr_group,
+	NULL
+};
+
+/*
+ * The register tables only drive the link at OV8865_LINK_FREQ_422MHZ, make
+ * sure the firmware allows it. Without link-frequencies, anything goes.
+ */
+static int ov8865_check_link_freq(struct device *dev)
+{
+	struct v4l2_fwnode_endpoint bus_cfg = {
+		.bus_type = V4L2_MBUS_CSI2_DPHY
+	};
+	struct fwnode_handle *ep;
+	unsigned int i;
+	int ret;
+
+	ep = fwnode_graph_get_next_endpoint(dev_fwnode(dev), NULL);
+	if (!ep)
+		return 0;
+
+	ret = v4l2_fwnode_endpoint_alloc_parse(ep, &bus_cfg);
+	fwnode_handle_put(ep);
+	if (ret)
+		return ret;
+
+	if (bus_cfg.nr_of_link_frequencies)
+		ret = -EINVAL;
+
+	for (i = 0; i < bus_cfg.nr_of_link_frequencies; i++)
+		if (bus_cfg.link_frequencies[i] == OV8865_LINK_FREQ_422MHZ)
+			ret = 0;
+
+	if (ret)
+		dev_err(dev, "%u Hz link frequency is not allowed\n",
+			OV8865_LINK_FREQ_422MHZ);
+
+	v4l2_fwnode_endpoint_free(&bus_cfg);
 
-	return dep_phys->dev;
+	return ret;
 }
 
 static int ov8865_probe(struct i2c_client *client)
@@ -2608,7 +3341,8 @@ static int ov8865_probe(struct i2c_client *client)
 	struct ov8865_dev *sensor;
 	const struct ov8865_mode_info *default_mode;
 	struct v4l2_mbus_framefmt *fmt;
-	struct device *dep_dev;
+	struct sensor_ssdb ssdb;
+	bool has_ssdb = false;
 	u32 rotation;
 	int ret = 0;
 
@@ -2620,7 +3354,7 @@ static int ov8865_probe(struct i2c_client *client)
 
 	sensor->i2c_client = client;
 
-	if (acpi_dev_present(OV8865_ACPI_HID, NULL, -1)) {
+	if (has_acpi_companion(&client->dev)) {
 		dev_info(dev, "system is acpi-based\n");
 		sensor->is_acpi_based = true;
 	} else
@@ -2646,7 +3380,9 @@ static int ov8865_probe(struct i2c_client *client)
 	sensor->frame_interval.denominator = ov8865_framerates[OV8865_30_FPS];
 	sensor->current_fr = OV8865_30_FPS;
 	sensor->current_mode = default_mode;
-	sensor->last_mode = default_mode;
+	/* nothing is programmed yet, the first stream on restores the mode */
+	sensor->last_mode = NULL;
+	sensor->crop = ov8865_default_crop;
 
 	if (!sensor->is_acpi_based) {
 		/* Optional indication of physical rotation of sensor. */
@@ -2664,8 +3400,23 @@ static int ov8865_probe(struct i2c_client *client)
 					rotation);
 			}
 		}
+	} else if (!sensor_ssdb_read(dev, &ssdb)) {
+		has_ssdb = true;
+
+		if (ssdb.lanes_used != OV8865_DATA_LANES) {
+			dev_err(dev, "%u data lanes are not supported\n",
+				ssdb.lanes_used);
+			return -EINVAL;
+		}
+
+		rotation = sensor_ssdb_rotation(&ssdb);
+		sensor->upside_down = rotation == 180;
+
+		dev_info(dev, "SSDB: rotation %u, VCM type %u, NVM type %u, CSI-2 port %u\n",
+			 rotation, ssdb.vcm_type, ssdb.rom_type,
+			 ssdb.link_used);
 	} else {
-		/* TODO: read from fwnode or SSDB */
+		/* No SSDB, keep the orientation of the Surface modules */
 		rotation = 180;
 		sensor->upside_down = true;
 	}
@@ -2717,19 +3468,17 @@ static int ov8865_probe(struct i2c_client *client)
 			return ret;
 	}
 
+	ret = ov8865_check_link_freq(dev);
+	if (ret)
+		return ret;
+
 	/* For ACPI-based systems */
 	if (sensor->is_acpi_based) {
-		sensor->dep_dev = get_dep_dev(&client->dev);
-		if (IS_ERR(sensor->dep_dev)) {
-			ret = PTR_ERR(sensor->dep_dev);
-			dev_err(&client->dev, "cannot get dep_dev: ret %d\n", ret);
-			return ret;
-		}
-		dep_dev = sensor->dep_dev;
-
-		ret = gpio_crs_get(sensor, dep_dev);
-		if (ret) {
-			dev_err(dep_dev, "Failed to get _CRS GPIOs\n");
+		sensor->dep = int3472_dep_get(&client->dev);
+		if (IS_ERR(sensor->dep)) {
+			ret = PTR_ERR(sensor->dep);
+			dev_err(&client->dev, "cannot get dependent device: ret %d\n",
+				ret);
 			return ret;
 		}
 	}
@@ -2741,32 +3490,53 @@ static int ov8865_probe(struct i2c_client *client)
 	sensor->sd.entity.function = MEDIA_ENT_F_CAM_SENSOR;
 	ret = media_entity_pads_init(&sensor->sd.entity, 1, &sensor->pad);
 	if (ret)
-		return ret;
+		goto err_dep_put;
 
 	mutex_init(&sensor->lock);
+	INIT_WORK(&sensor->group_work, ov8865_group_work);
 
-	ret = ov8865_check_chip_id(sensor);
+	ret = sensor_regcache_init(&client->dev, &sensor->regcache,
+				   OV8865_REGCACHE_MAX_REG,
+				   ov8865_volatile_regs,
+				   ARRAY_SIZE(ov8865_volatile_regs));
 	if (ret)
 		goto err_entity_cleanup;
 
+	/* Skip the OTP when SSDB says the module keeps its data elsewhere */
+	sensor->has_otp = !has_ssdb || ssdb.rom_type == SENSOR_SSDB_ROM_OTP;
+	if (!sensor->has_otp)
+		dev_info(dev, "no OTP on this module\n");
+
 	ret = ov8865_init_controls(sensor);
 	if (ret)
 		goto err_entity_cleanup;
 
+	sensor_stats_init(&sensor->stats, dev, &sensor->settle);
+
+	/*
+	 * The sensor is not touched at probe. It is identified on the first
+	 * power up.
+	 */
+	pm_runtime_set_autosuspend_delay(dev, OV8865_AUTOSUSPEND_DELAY_MS);
+	pm_runtime_use_autosuspend(dev);
+	pm_runtime_enable(dev);
+
 	ret = v4l2_async_register_subdev(&sensor->sd);
 	if (ret)
-		goto err_free_ctrls;
+		goto err_rpm_disable;
 
 	return 0;
 
-err_free_ctrls:
+err_rpm_disable:
+	pm_runtime_disable(dev);
+	pm_runtime_dont_use_autosuspend(dev);
+	sensor_stats_exit(&sensor->stats);
 	v4l2_ctrl_handler_free(&sensor->ctrls.handler);
 err_entity_cleanup:
 	mutex_destroy(&sensor->lock);
 	media_entity_cleanup(&sensor->sd.entity);
-	/* For ACPI-based systems */
-	if (sensor->is_acpi_based)
-		gpio_crs_put(sensor);
+err_dep_put:
+	int3472_dep_put(sensor->dep);
 	return ret;
 }
 
@@ -2778,11 +3548,20 @@ static int ov8865_remove(struct i2c_client *client)
 
 	dev_info(&client->dev, "%s() called", __func__);
 
+	v4l2_async_unregister_subdev(&sensor->sd);
+	cancel_work_sync(&sensor->group_work);
+
+	pm_runtime_disable(&client->dev);
+	if (!pm_runtime_status_suspended(&client->dev))
+		ov8865_set_power_off(sensor);
+	pm_runtime_set_suspended(&client->dev);
+	pm_runtime_dont_use_autosuspend(&client->dev);
+
 	/* For ACPI-based systems */
 	if (sensor->is_acpi_based)
-		gpio_crs_put(sensor);
+		int3472_dep_put(sensor->dep);
 
-	v4l2_async_unregister_subdev(&sensor->sd);
+	sensor_stats_exit(&sensor->stats);
 	mutex_destroy(&sensor->lock);
 	media_entity_cleanup(&sensor->sd.entity);
 	v4l2_ctrl_handler_free(&sensor->ctrls.handler);
@@ -2810,9 +3589,42 @@ static const struct acpi_device_id ov8865_acpi_ids[] = {
 MODULE_DEVICE_TABLE(acpi, ov8865_acpi_ids);
 #endif
 
+static int __maybe_unused ov8865_runtime_suspend(struct device *dev)
+{
+	struct v4l2_subdev *sd = i2c_get_clientdata(to_i2c_client(dev));
+
+	ov8865_set_power_off(to_ov8865_dev(sd));
+
+	return 0;
+}
+
+static int __maybe_unused ov8865_runtime_resume(struct device *dev)
+{
+	struct v4l2_subdev *sd = i2c_get_clientdata(to_i2c_client(dev));
+	struct ov8865_dev *sensor = to_ov8865_dev(sd);
+	int ret;
+
+	ret = ov8865_set_power_on(sensor);
+	if (ret)
+		return ret;
+
+	ret = ov8865_identify(sensor);
+	if (ret)
+		ov8865_set_power_off(sensor);
+
+	return ret;
+}
+
+static const struct dev_pm_ops ov8865_pm_ops = {
+	SET_RUNTIME_PM_OPS(ov8865_runtime_suspend, ov8865_runtime_resume, NULL)
+};
+
 static struct i2c_driver ov8865_i2c_driver = {
 	.driver	= {
 		 .name = "ov8865",
+		 .pm = &ov8865_pm_ops,
+		 .dev_groups = ov8865_attr_groups,
+		 .probe_type = PROBE_PREFER_ASYNCHRONOUS,
 		 .of_match_table = ov8865_dt_ids,
 		 .acpi_match_table = ACPI_PTR(ov8865_acpi_ids),
 	 },
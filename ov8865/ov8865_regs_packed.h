@@ -0,0 +1,403 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+/*
+ * Generated by misc/pack_sensor_regs/pack_sensor_regs.py from ov8865.c.
+ * Do not edit, regenerate after changing the register tables.
+ */
+
+#ifndef __OV8865_REGS_PACKED_H__
+#define __OV8865_REGS_PACKED_H__
+
+#include "sensor_burst.h"
+
+/* 260 entries, 64 messages */
+static const u8 ov8865_init_setting_QUXGA_packed[] = {
+	3, 0x01, 0x03,
+		0x01,
+	SENSOR_BURST_DELAY, 16,
+	3, 0x01, 0x00,
+		0x00,
+	3, 0x30, 0x15,
+		0x01,
+	3, 0x30, 0x22,
+		0x01,
+	3, 0x30, 0x31,
+		0x0a,
+	3, 0x33, 0x05,
+		0xf1,
+	11, 0x33, 0x07,
+		0x04, 0x00, 0x28, 0x00, 0x20, 0x00, 0x00, 0x00,
+		0x40,
+	6, 0x35, 0x00,
+		0x00, 0x4c, 0x00, 0x00,
+	4, 0x35, 0x08,
+		0x02, 0x00,
+	3, 0x36, 0x02,
+		0x30,
+	4, 0x36, 0x04,
+		0x04, 0x00,
+	6, 0x36, 0x07,
+		0x20, 0x11, 0x68, 0x40,
+	3, 0x36, 0x0c,
+		0xdd,
+	3, 0x36, 0x0e,
+		0x0c,
+	3, 0x36, 0x10,
+		0x07,
+	5, 0x36, 0x12,
+		0x86, 0x58, 0x28,
+	5, 0x36, 0x17,
+		0x40, 0x5a, 0x9b,
+	4, 0x36, 0x1c,
+		0x00, 0x60,
+	3, 0x36, 0x31,
+		0x60,
+	6, 0x36, 0x33,
+		0x10, 0x10, 0x10, 0x10,
+	3, 0x36, 0x38,
+		0xff,
+	3, 0x36, 0x41,
+		0x55,
+	4, 0x36, 0x46,
+		0x86, 0x27,
+	3, 0x36, 0x4a,
+		0x1b,
+	15, 0x37, 0x00,
+		0x24, 0x0c, 0x28, 0x19, 0x14, 0x00, 0x38, 0x04,
+		0x24, 0x40, 0x00, 0xb8, 0x04,
+	3, 0x37, 0x12,
+		0x42,
+	3, 0x37, 0x14,
+		0x12,
+	4, 0x37, 0x18,
+		0x12, 0x31,
+	6, 0x37, 0x1e,
+		0x19, 0x40, 0x05, 0x05,
+	5, 0x37, 0x24,
+		0x02, 0x02, 0x06,
+	15, 0x37, 0x28,
+		0x05, 0x02, 0x03, 0x53, 0xa3, 0x53, 0x06, 0x10,
+		0x01, 0x06, 0x14, 0x10, 0x40,
+	3, 0x37, 0x36,
+		0x20,
+	5, 0x37, 0x3a,
+		0x02, 0x0c, 0x0a,
+	3, 0x37, 0x3e,
+		0x03,
+	3, 0x37, 0x55,
+		0x40,
+	14, 0x37, 0x58,
+		0x00, 0x4c, 0x06, 0x13, 0x40, 0x02, 0x00, 0x14,
+		0x00, 0x00, 0x00, 0x00,
+	10, 0x37, 0x66,
+		0xff, 0x1c, 0x04, 0x20, 0x08, 0x42, 0xc0, 0xc0,
+	3, 0x37, 0x6f,
+		0x01,
+	7, 0x37, 0x72,
+		0x23, 0x02, 0x16, 0x12, 0x08,
+	28, 0x37, 0xa0,
+		0x44, 0x3d, 0x3d, 0x01, 0x00, 0x08, 0x00, 0x44,
+		0x58, 0x58, 0x44, 0x2e, 0x2e, 0x33, 0x0d, 0x0d,
+		0x00, 0x00, 0x00, 0x42, 0x42, 0x33, 0x00, 0x00,
+		0x00, 0xff,
+	3, 0x3d, 0x85,
+		0x06,
+	4, 0x3d, 0x8c,
+		0x75, 0xef,
+	3, 0x3f, 0x08,
+		0x0b,
+	5, 0x43, 0x00,
+		0xff, 0x00, 0x0f,
+	3, 0x45, 0x00,
+		0x40,
+	3, 0x45, 0x03,
+		0x10,
+	3, 0x46, 0x01,
+		0x74,
+	3, 0x48, 0x1f,
+		0x32,
+	3, 0x48, 0x37,
+		0x16,
+	4, 0x48, 0x50,
+		0x10, 0x32,
+	3, 0x4b, 0x00,
+		0x2a,
+	3, 0x4b, 0x0d,
+		0x00,
+	8, 0x4d, 0x00,
+		0x04, 0x18, 0xc3, 0xff, 0xff, 0xff,
+	5, 0x50, 0x00,
+		0x96, 0x01, 0x08,
+	3, 0x59, 0x01,
+		0x00,
+	4, 0x5e, 0x00,
+		0x00, 0x41,
+	3, 0x01, 0x00,
+		0x01,
+	7, 0x57, 0x80,
+		0xfc, 0xdf, 0x3f, 0x08, 0x0c,
+	13, 0x57, 0x86,
+		0x20, 0x40, 0x08, 0x08, 0x02, 0x01, 0x01, 0x0c,
+		0x02, 0x01, 0x01,
+	34, 0x58, 0x00,
+		0x1d, 0x0e, 0x0c, 0x0c, 0x0f, 0x22, 0x0a, 0x06,
+		0x05, 0x05, 0x07, 0x0a, 0x06, 0x02, 0x00, 0x00,
+		0x03, 0x07, 0x06, 0x02, 0x00, 0x00, 0x03, 0x07,
+		0x09, 0x06, 0x04, 0x04, 0x06, 0x0a, 0x19, 0x0d,
+	32, 0x58, 0x20,
+		0x0b, 0x0b, 0x0e, 0x22, 0x23, 0x28, 0x29, 0x27,
+		0x13, 0x26, 0x33, 0x32, 0x33, 0x16, 0x14, 0x30,
+		0x31, 0x30, 0x15, 0x26, 0x23, 0x21, 0x23, 0x05,
+		0x36, 0x27, 0x28, 0x26, 0x24, 0xdf,
+	6, 0x5b, 0x00,
+		0x02, 0xd0, 0x03, 0xff,
+	3, 0x5b, 0x05,
+		0x6c,
+	3, 0x01, 0x00,
+		0x00,
+};
+
+/* 73 entries, 27 messages */
+static const u8 ov8865_setting_QUXGA_packed[] = {
+	3, 0x01, 0x00,
+		0x00,
+	SENSOR_BURST_DELAY, 5,
+	4, 0x35, 0x01,
+		0x98, 0x60,
+	7, 0x37, 0x00,
+		0x48, 0x18, 0x50, 0x32, 0x28,
+	9, 0x37, 0x06,
+		0x70, 0x08, 0x48, 0x80, 0x01, 0x70, 0x07,
+	3, 0x37, 0x12,
+		0x44,
+	3, 0x37, 0x18,
+		0x14,
+	6, 0x37, 0x1e,
+		0x31, 0x7f, 0x0a, 0x0a,
+	5, 0x37, 0x24,
+		0x04, 0x04, 0x0c,
+	13, 0x37, 0x28,
+		0x0a, 0x03, 0x06, 0xa6, 0xa6, 0xa6, 0x0c, 0x20,
+		0x02, 0x0c, 0x28,
+	3, 0x37, 0x36,
+		0x30,
+	5, 0x37, 0x3a,
+		0x04, 0x18, 0x14,
+	3, 0x37, 0x3e,
+		0x06,
+	4, 0x37, 0x5a,
+		0x0c, 0x26,
+	3, 0x37, 0x5d,
+		0x04,
+	3, 0x37, 0x5f,
+		0x28,
+	3, 0x37, 0x67,
+		0x1e,
+	7, 0x37, 0x72,
+		0x46, 0x04, 0x2c, 0x13, 0x10,
+	6, 0x37, 0xa0,
+		0x88, 0x7a, 0x7a, 0x02,
+	3, 0x37, 0xa5,
+		0x09,
+	11, 0x37, 0xa7,
+		0x88, 0xb0, 0xb0, 0x88, 0x5c, 0x5c, 0x55, 0x19,
+		0x19,
+	5, 0x37, 0xb3,
+		0x84, 0x84, 0x66,
+	3, 0x3f, 0x08,
+		0x16,
+	3, 0x45, 0x00,
+		0x68,
+	3, 0x46, 0x01,
+		0x10,
+	3, 0x50, 0x02,
+		0x08,
+	3, 0x59, 0x01,
+		0x00,
+	3, 0x01, 0x00,
+		0x00,
+};
+
+/* 73 entries, 27 messages */
+static const u8 ov8865_setting_6M_packed[] = {
+	3, 0x01, 0x00,
+		0x00,
+	SENSOR_BURST_DELAY, 5,
+	4, 0x35, 0x01,
+		0x72, 0x20,
+	7, 0x37, 0x00,
+		0x48, 0x18, 0x50, 0x32, 0x28,
+	9, 0x37, 0x06,
+		0x70, 0x08, 0x48, 0x80, 0x01, 0x70, 0x07,
+	3, 0x37, 0x12,
+		0x44,
+	3, 0x37, 0x18,
+		0x14,
+	6, 0x37, 0x1e,
+		0x31, 0x7f, 0x0a, 0x0a,
+	5, 0x37, 0x24,
+		0x04, 0x04, 0x0c,
+	13, 0x37, 0x28,
+		0x0a, 0x03, 0x06, 0xa6, 0xa6, 0xa6, 0x0c, 0x20,
+		0x02, 0x0c, 0x28,
+	3, 0x37, 0x36,
+		0x30,
+	5, 0x37, 0x3a,
+		0x04, 0x18, 0x14,
+	3, 0x37, 0x3e,
+		0x06,
+	4, 0x37, 0x5a,
+		0x0c, 0x26,
+	3, 0x37, 0x5d,
+		0x04,
+	3, 0x37, 0x5f,
+		0x28,
+	3, 0x37, 0x67,
+		0x1e,
+	7, 0x37, 0x72,
+		0x46, 0x04, 0x2c, 0x13, 0x10,
+	6, 0x37, 0xa0,
+		0x88, 0x7a, 0x7a, 0x02,
+	3, 0x37, 0xa5,
+		0x09,
+	11, 0x37, 0xa7,
+		0x88, 0xb0, 0xb0, 0x88, 0x5c, 0x5c, 0x55, 0x19,
+		0x19,
+	5, 0x37, 0xb3,
+		0x84, 0x84, 0x66,
+	3, 0x3f, 0x08,
+		0x16,
+	3, 0x45, 0x00,
+		0x68,
+	3, 0x46, 0x01,
+		0x10,
+	3, 0x50, 0x02,
+		0x08,
+	3, 0x59, 0x01,
+		0x00,
+	3, 0x01, 0x00,
+		0x00,
+};
+
+/* 73 entries, 27 messages */
+static const u8 ov8865_setting_UXGA_packed[] = {
+	3, 0x01, 0x00,
+		0x00,
+	SENSOR_BURST_DELAY, 5,
+	4, 0x35, 0x01,
+		0x4c, 0x00,
+	7, 0x37, 0x00,
+		0x24, 0x0c, 0x28, 0x19, 0x14,
+	9, 0x37, 0x06,
+		0x38, 0x04, 0x24, 0x40, 0x00, 0xb8, 0x04,
+	3, 0x37, 0x12,
+		0x42,
+	3, 0x37, 0x18,
+		0x12,
+	6, 0x37, 0x1e,
+		0x19, 0x40, 0x05, 0x05,
+	5, 0x37, 0x24,
+		0x02, 0x02, 0x06,
+	13, 0x37, 0x28,
+		0x05, 0x02, 0x03, 0x53, 0xa3, 0x53, 0x06, 0x10,
+		0x01, 0x06, 0x14,
+	3, 0x37, 0x36,
+		0x20,
+	5, 0x37, 0x3a,
+		0x02, 0x0c, 0x0a,
+	3, 0x37, 0x3e,
+		0x03,
+	4, 0x37, 0x5a,
+		0x06, 0x13,
+	3, 0x37, 0x5d,
+		0x02,
+	3, 0x37, 0x5f,
+		0x14,
+	3, 0x37, 0x67,
+		0x1c,
+	7, 0x37, 0x72,
+		0x23, 0x02, 0x16, 0x12, 0x08,
+	6, 0x37, 0xa0,
+		0x44, 0x3d, 0x3d, 0x01,
+	3, 0x37, 0xa5,
+		0x08,
+	11, 0x37, 0xa7,
+		0x44, 0x58, 0x58, 0x44, 0x2e, 0x2e, 0x33, 0x0d,
+		0x0d,
+	5, 0x37, 0xb3,
+		0x42, 0x42, 0x33,
+	3, 0x3f, 0x08,
+		0x0b,
+	3, 0x45, 0x00,
+		0x40,
+	3, 0x46, 0x01,
+		0x74,
+	3, 0x50, 0x02,
+		0x08,
+	3, 0x59, 0x01,
+		0x00,
+	3, 0x01, 0x00,
+		0x00,
+};
+
+/* 73 entries, 27 messages */
+static const u8 ov8865_setting_SVGA_packed[] = {
+	3, 0x01, 0x00,
+		0x00,
+	SENSOR_BURST_DELAY, 5,
+	4, 0x35, 0x01,
+		0x26, 0x00,
+	7, 0x37, 0x00,
+		0x24, 0x0c, 0x28, 0x19, 0x14,
+	9, 0x37, 0x06,
+		0x38, 0x04, 0x24, 0x40, 0x00, 0xb8, 0x04,
+	3, 0x37, 0x12,
+		0x42,
+	3, 0x37, 0x18,
+		0x12,
+	6, 0x37, 0x1e,
+		0x19, 0x40, 0x05, 0x05,
+	5, 0x37, 0x24,
+		0x02, 0x02, 0x06,
+	13, 0x37, 0x28,
+		0x05, 0x02, 0x03, 0x53, 0xa3, 0x53, 0x06, 0x10,
+		0x01, 0x06, 0x14,
+	3, 0x37, 0x36,
+		0x20,
+	5, 0x37, 0x3a,
+		0x02, 0x0c, 0x0a,
+	3, 0x37, 0x3e,
+		0x03,
+	4, 0x37, 0x5a,
+		0x06, 0x13,
+	3, 0x37, 0x5d,
+		0x02,
+	3, 0x37, 0x5f,
+		0x14,
+	3, 0x37, 0x67,
+		0x18,
+	7, 0x37, 0x72,
+		0x23, 0x02, 0x16, 0x12, 0x08,
+	6, 0x37, 0xa0,
+		0x44, 0x3d, 0x3d, 0x01,
+	3, 0x37, 0xa5,
+		0x08,
+	11, 0x37, 0xa7,
+		0x44, 0x58, 0x58, 0x44, 0x2e, 0x2e, 0x33, 0x0d,
+		0x0d,
+	5, 0x37, 0xb3,
+		0x42, 0x42, 0x33,
+	3, 0x3f, 0x08,
+		0x0b,
+	3, 0x45, 0x00,
+		0x40,
+	3, 0x46, 0x01,
+		0x50,
+	3, 0x50, 0x02,
+		0x0c,
+	3, 0x59, 0x01,
+		0x04,
+	3, 0x01, 0x00,
+		0x00,
+};
+
+#endif /* __OV8865_REGS_PACKED_H__ */
@@ -14,6 +14,11 @@
 #include <media/v4l2-device.h>
 #include <media/v4l2-fwnode.h>
 
+#include "int3472_dep.h"
+#include "sensor_regcache.h"
+#include "sensor_ssdb.h"
+#include "sensor_stats.h"
+
 #define OV8865_ACPI_HID "INT347A"
 
 #define OV8865_REG_VALUE_08BIT		1
@@ -34,6 +39,12 @@
 #define OV8865_MODE_STANDBY		0x00
 #define OV8865_MODE_STREAMING		0x01
 
+#define OV8865_REG_SOFTWARE_RST		0x0103
+#define OV8865_SOFTWARE_RST		0x01
+
+/* Highest register address kept in the register cache */
+#define OV8865_REGCACHE_MAX_REG		0x5fff
+
 /* module revisions */
 #define OV8865_2A_MODULE		0x01
 #define OV8865_1B_MODULE		0x02
@@ -689,20 +700,25 @@ struct ov8865 {
 	/* Streaming on/off */
 	bool streaming;
 
-	/* dependent device (PMIC) */
-	struct device *dep_dev;
+	/* Shadow of the sensor registers, protected by mutex */
+	struct sensor_regcache regcache;
 
-	/* GPIOs defined in dep_dev _CRS. The last "led_gpio" may not exist
-	 * depending on devices.
-	 */
-	struct gpio_desc *xshutdn;
-	struct gpio_desc *pwdnb;
-	struct gpio_desc *led_gpio;
+	/* I2C and stream start statistics, in debugfs */
+	struct sensor_stats stats;
+
+	/* dependent device (PMIC) holding the power GPIOs */
+	struct int3472_dep *dep;
 
 	bool is_acpi_based;
 	bool is_rpm_supported;
 };
 
+static const struct sensor_reg_range ov8865_volatile_regs[] = {
+	SENSOR_REG_RANGE(OV8865_REG_SOFTWARE_RST, OV8865_REG_SOFTWARE_RST),
+	SENSOR_REG_RANGE(OV8865_REG_CHIP_ID, OV8865_REG_CHIP_ID + 2),
+	SENSOR_REG_RANGE(OV8865_OTP_LOAD_CTRL, OV8865_OTP_MODE_CTRL),
+};
+
 static u64 to_pixel_rate(u32 f_index)
 {
 	u64 pixel_rate = link_freq_menu_items[f_index] * 2 * OV8865_DATA_LANES;
@@ -727,11 +743,15 @@ static int ov8865_read_reg(struct ov8865 *ov8865, u16 reg, u16 len, u32 *val)
 	struct i2c_msg msgs[2];
 	u8 addr_buf[2];
 	u8 data_buf[4] = {0};
+	ktime_t start;
 	int ret;
 
 	if (len > 4)
 		return -EINVAL;
 
+	if (sensor_regcache_read_be(&ov8865->regcache, reg, len, val))
+		return 0;
+
 	put_unaligned_be16(reg, addr_buf);
 	msgs[0].addr = client->addr;
 	msgs[0].flags = 0;
@@ -742,11 +762,16 @@ static int ov8865_read_reg(struct ov8865 *ov8865, u16 reg, u16 len, u32 *val)
 	msgs[1].len = len;
 	msgs[1].buf = &data_buf[4 - len];
 
+	start = ktime_get();
 	ret = i2c_transfer(client->adapter, msgs, ARRAY_SIZE(msgs));
-	if (ret != ARRAY_SIZE(msgs))
-		return -EIO;
+	ret = ret == ARRAY_SIZE(msgs) ? 0 : -EIO;
+	sensor_stats_xfer(&ov8865->stats, SENSOR_STATS_READ, reg, len, start,
+			  ret);
+	if (ret)
+		return ret;
 
 	*val = get_unaligned_be32(data_buf);
+	sensor_regcache_write_be(&ov8865->regcache, reg, len, *val);
 
 	return 0;
 }
@@ -754,15 +779,27 @@ static int ov8865_read_reg(struct ov8865 *ov8865, u16 reg, u16 len, u32 *val)
 static int ov8865_write_reg(struct ov8865 *ov8865, u16 reg, u16 len, u32 val)
 {
 	struct i2c_client *client = v4l2_get_subdevdata(&ov8865->sd);
+	ktime_t start;
 	u8 buf[6];
+	int ret;
 
 	if (len > 4)
 		return -EINVAL;
 
 	put_unaligned_be16(reg, buf);
 	put_unaligned_be32(val << 8 * (4 - len), buf + 2);
-	if (i2c_master_send(client, buf, len + 2) != len + 2)
-		return -EIO;
+	start = ktime_get();
+	ret = i2c_master_send(client, buf, len + 2) == len + 2 ? 0 : -EIO;
+	sensor_stats_xfer(&ov8865->stats, SENSOR_STATS_WRITE, reg, len, start,
+			  ret);
+	if (ret)
+		return ret;
+
+	/* A software reset brings every register back to its default */
+	if (reg == OV8865_REG_SOFTWARE_RST && (val & OV8865_SOFTWARE_RST))
+		sensor_regcache_invalidate(&ov8865->regcache);
+	else
+		sensor_regcache_write_be(&ov8865->regcache, reg, len, val);
 
 	return 0;
 }
@@ -949,61 +986,17 @@ static void ov8865_update_pad_format(const struct ov8865_mode *mode,
 	fmt->field = V4L2_FIELD_NONE;
 }
 
-/* Get GPIOs defined in dep_dev _CRS */
-static int gpio_crs_get(struct ov8865 *sensor, struct device *dep_dev)
-{
-	sensor->xshutdn = devm_gpiod_get_index(dep_dev, NULL, 0, GPIOD_ASIS);
-	if (IS_ERR(sensor->xshutdn)) {
-		dev_err(dep_dev, "Couldn't get GPIO XSHUTDN\n");
-		return -EINVAL;
-	}
-
-	sensor->pwdnb = devm_gpiod_get_index(dep_dev, NULL, 1, GPIOD_ASIS);
-	if (IS_ERR(sensor->pwdnb)) {
-		dev_err(dep_dev, "Couldn't get GPIO PWDNB\n");
-		return -EINVAL;
-	}
-
-	sensor->led_gpio = devm_gpiod_get_index(dep_dev, NULL, 2, GPIOD_ASIS);
-	if (IS_ERR(sensor->led_gpio))
-		dev_info(dep_dev,
-			 "Couldn't get GPIO LED. Maybe not exist, continue anyway.\n");
-
-	return 0;
-}
-
-/* Put GPIOs defined in dep_dev _CRS */
-static void gpio_crs_put(struct ov8865 *sensor)
-{
-	gpiod_put(sensor->xshutdn);
-	gpiod_put(sensor->pwdnb);
-	if (!IS_ERR(sensor->led_gpio))
-		gpiod_put(sensor->led_gpio);
-}
-
-/* Control GPIOs defined in dep_dev _CRS */
-static int gpio_crs_ctrl(struct v4l2_subdev *sd, bool flag)
-{
-	struct ov8865 *sensor = to_ov8865(sd);
-
-	gpiod_set_value_cansleep(sensor->xshutdn, flag);
-	gpiod_set_value_cansleep(sensor->pwdnb, flag);
-	if (!IS_ERR(sensor->led_gpio))
-		gpiod_set_value_cansleep(sensor->led_gpio, flag);
-
-	return 0;
-}
-
 static int __ov8865_power_on(struct ov8865 *ov8865)
 {
 	struct i2c_client *client = v4l2_get_subdevdata(&ov8865->sd);
+	ktime_t start = ktime_get();
 	int ret;
 
 	if (ov8865->is_acpi_based) {
-		ret = gpio_crs_ctrl(&ov8865->sd, true);
-		if (ret)
-			goto fail_power;
+		int3472_dep_set_power(ov8865->dep, true);
 		usleep_range(1500, 1800);
+		sensor_stats_power(&ov8865->stats, true);
+		sensor_stats_phase(&ov8865->stats, SENSOR_STATS_POWER_ON, start);
 		return 0;
 	}
 
@@ -1027,23 +1020,25 @@ static int __ov8865_power_on(struct ov8865 *ov8865)
 
 	gpiod_set_value_cansleep(ov8865->reset_gpio, 0);
 	usleep_range(1500, 1800);
+	sensor_stats_power(&ov8865->stats, true);
+	sensor_stats_phase(&ov8865->stats, SENSOR_STATS_POWER_ON, start);
 
 	return 0;
 
 disable_clk:
 	gpiod_set_value_cansleep(ov8865->reset_gpio, 1);
 	clk_disable_unprepare(ov8865->xvclk);
-fail_power:
-	if (ov8865->is_acpi_based)
-		gpio_crs_ctrl(&ov8865->sd, false);
 
 	return ret;
 }
 
 static void __ov8865_power_off(struct ov8865 *ov8865)
 {
+	sensor_stats_power(&ov8865->stats, false);
+	sensor_regcache_invalidate(&ov8865->regcache);
+
 	if (ov8865->is_acpi_based) {
-		gpio_crs_ctrl(&ov8865->sd, false);
+		int3472_dep_set_power(ov8865->dep, false);
 		return;
 	}
 
@@ -1057,6 +1052,7 @@ static int ov8865_start_streaming(struct ov8865 *ov8865)
 {
 	struct i2c_client *client = v4l2_get_subdevdata(&ov8865->sd);
 	const struct ov8865_reg_list *reg_list;
+	ktime_t start = ktime_get();
 	int link_freq_index, ret;
 
 	reg_list = &reg_list_global_regs;
@@ -1065,7 +1061,9 @@ static int ov8865_start_streaming(struct ov8865 *ov8865)
 		dev_err(&client->dev, "failed to set global_regs");
 		return ret;
 	}
+	sensor_stats_phase(&ov8865->stats, SENSOR_STATS_GLOBAL_REGS, start);
 
+	start = ktime_get();
 	link_freq_index = ov8865->cur_mode->link_freq_index;
 	reg_list = &link_freq_configs[link_freq_index].reg_list;
 	ret = ov8865_write_reg_list(ov8865, reg_list);
@@ -1080,17 +1078,22 @@ static int ov8865_start_streaming(struct ov8865 *ov8865)
 		dev_err(&client->dev, "failed to set mode");
 		return ret;
 	}
+	sensor_stats_phase(&ov8865->stats, SENSOR_STATS_MODE_REGS, start);
 
+	start = ktime_get();
 	ret = __v4l2_ctrl_handler_setup(ov8865->sd.ctrl_handler);
 	if (ret)
 		return ret;
+	sensor_stats_phase(&ov8865->stats, SENSOR_STATS_CTRL_SETUP, start);
 
+	start = ktime_get();
 	ret = ov8865_write_reg(ov8865, OV8865_REG_MODE_SELECT,
 			       OV8865_REG_VALUE_08BIT, OV8865_MODE_STREAMING);
 	if (ret) {
 		dev_err(&client->dev, "failed to set stream");
 		return ret;
 	}
+	sensor_stats_phase(&ov8865->stats, SENSOR_STATS_STREAM_ON, start);
 
 	return 0;
 }
@@ -1107,6 +1110,7 @@ static void ov8865_stop_streaming(struct ov8865 *ov8865)
 static int __ov8865_set_stream_no_rpm(struct v4l2_subdev *sd, int enable)
 {
 	struct ov8865 *ov8865 = to_ov8865(sd);
+	ktime_t start = ktime_get();
 	int ret;
 
 	mutex_lock(&ov8865->mutex);
@@ -1123,6 +1127,9 @@ static int __ov8865_set_stream_no_rpm(struct v4l2_subdev *sd, int enable)
 			enable = 0;
 			ov8865_stop_streaming(ov8865);
 			__ov8865_power_off(ov8865);
+		} else {
+			sensor_stats_phase(&ov8865->stats,
+					   SENSOR_STATS_STREAM_START, start);
 		}
 	} else {
 		ov8865_stop_streaming(ov8865);
@@ -1139,6 +1146,7 @@ static int __ov8865_set_stream_rpm(struct v4l2_subdev *sd, int enable)
 {
 	struct ov8865 *ov8865 = to_ov8865(sd);
 	struct i2c_client *client = v4l2_get_subdevdata(sd);
+	ktime_t start = ktime_get();
 	int ret;
 
 	mutex_lock(&ov8865->mutex);
@@ -1155,6 +1163,9 @@ static int __ov8865_set_stream_rpm(struct v4l2_subdev *sd, int enable)
 			enable = 0;
 			ov8865_stop_streaming(ov8865);
 			pm_runtime_put(&client->dev);
+		} else {
+			sensor_stats_phase(&ov8865->stats,
+					   SENSOR_STATS_STREAM_START, start);
 		}
 	} else {
 		ov8865_stop_streaming(ov8865);
@@ -1501,7 +1512,7 @@ static int ov8865_remove(struct i2c_client *client)
 	struct ov8865 *ov8865 = to_ov8865(sd);
 
 	if (ov8865->is_acpi_based)
-		gpio_crs_put(ov8865);
+		int3472_dep_put(ov8865->dep);
 
 	v4l2_async_unregister_subdev(sd);
 	media_entity_cleanup(&sd->entity);
@@ -1510,130 +1521,22 @@ static int ov8865_remove(struct i2c_client *client)
 	mutex_destroy(&ov8865->mutex);
 
 	__ov8865_power_off(ov8865);
+	sensor_stats_exit(&ov8865->stats);
 
 	return 0;
 }
 
-/* Get acpi_device of dependent INT3472 device */
-static struct acpi_device *get_dep_adev(struct device *dev)
-{
-	struct acpi_handle *dev_handle;
-	struct acpi_device *sensor_adev;
-	struct acpi_handle_list dep_devices;
-	struct acpi_device *dep_adev;
-	acpi_status status;
-	const char *dep_hid = "INT3472";
-	int i;
-
-	sensor_adev = acpi_dev_get_first_match_dev(OV8865_ACPI_HID, NULL, -1);
-	if (!sensor_adev) {
-		dev_err(dev, "Couldn't get sensor ACPI device\n");
-		return ERR_PTR(-ENODEV);
-	}
-	dev_handle = sensor_adev->handle;
-	acpi_dev_put(sensor_adev);
-
-	if (!acpi_has_method(dev_handle, "_DEP")) {
-		dev_err(dev, "No _DEP entry found\n");
-		return ERR_PTR(-ENODEV);
-	}
-
-	status = acpi_evaluate_reference(dev_handle, "_DEP", NULL, &dep_devices);
-	if (ACPI_FAILURE(status)) {
-		dev_err(dev, "Failed to evaluate _DEP.\n");
-		return ERR_PTR(-ENODEV);
-	}
-
-	for (i = 0; i < dep_devices.count; i++) {
-		struct acpi_device_info *info;
-		int match;
-
-		status = acpi_get_object_info(dep_devices.handles[i], &info);
-		if (ACPI_FAILURE(status)) {
-			dev_dbg(dev,
-				"Error reading _DEP device info, continue next\n");
-			continue;
-		}
-
-		match = info->valid & ACPI_VALID_HID &&
-			!strcmp(info->hardware_id.string, dep_hid);
-
-		kfree(info);
-
-		if (!match)
-			continue;
-
-		if (acpi_bus_get_device(dep_devices.handles[i], &dep_adev)) {
-			dev_err(dev, "Error getting dependent ACPI device\n");
-			return ERR_PTR(-ENODEV);
-		}
-
-		/* found acpi_device of dependent device */
-		break;
-	}
-
-	if (!dep_adev) {
-		dev_err(dev, "Dependent ACPI device not found\n");
-		return ERR_PTR(-ENODEV);
-	}
-
-	dev_info(dev, "Dependent ACPI device found: %s\n",
-		 dev_name(&dep_adev->dev));
-
-	return dep_adev;
-}
-
-/* Get dependent INT3472 device */
-static struct device *get_dep_dev(struct device *dev)
-{
-	struct acpi_device *dep_adev;
-	struct acpi_device_physical_node *dep_phys;
-
-	dep_adev = get_dep_adev(dev);
-	if (!dep_adev) {
-		dev_err(dev, "get_dep_adev() failed\n");
-		return ERR_PTR(-ENODEV);
-	}
-
-	/*
-	 * HACK: We know that the PMIC is a "discrete" PMIC, an ACPI device
-	 * that just serves as a container to list system GPIOs.
-	 *
-	 * The ACPI device has no fwnode, nor does it have a platform device.
-	 * This prevents fetching GPIOs. It however seems to be backed by the
-	 * PCI root complex (pci0000:00/0000:00:00.0) as its physical device,
-	 * and that device has its fwnode set to \_SB.PCI0.DSC1. Whether this
-	 * is correct or not is unknown, let's just get the physical device and
-	 * move on for now.
-	 *
-	 * (@kitakar5525)This is observed on Microsoft Surface Go series
-	 * and Acer Switch Alpha 12.
-	 */
-	dep_phys = list_first_entry_or_null(&dep_adev->physical_node_list,
-					    struct acpi_device_physical_node,
-					    node);
-	if (!dep_phys) {
-		dev_info(dev,
-			 "Error getting physical node of dependent device\n");
-		return ERR_PTR(-ENODEV);
-	}
-
-	dev_info(dev, "Dependent device found: %s\n", dev_name(dep_phys->dev));
-
-	return dep_phys->dev;
-}
-
 static int ov8865_probe(struct i2c_client *client)
 {
 	struct ov8865 *ov8865;
-	struct device *dep_dev;
+	struct sensor_ssdb ssdb;
 	int ret;
 
 	ov8865 = devm_kzalloc(&client->dev, sizeof(*ov8865), GFP_KERNEL);
 	if (!ov8865)
 		return -ENOMEM;
 
-	if (acpi_dev_present(OV8865_ACPI_HID, NULL, -1)) {
+	if (has_acpi_companion(&client->dev)) {
 		dev_info(&client->dev, "system is acpi-based\n");
 		ov8865->is_acpi_based = true;
 	} else {
@@ -1651,24 +1554,35 @@ static int ov8865_probe(struct i2c_client *client)
 
 	v4l2_i2c_subdev_init(&ov8865->sd, client, &ov8865_subdev_ops);
 
-	ov8865->dep_dev = get_dep_dev(&client->dev);
-	if (IS_ERR(ov8865->dep_dev)) {
-		ret = PTR_ERR(ov8865->dep_dev);
-		dev_err(&client->dev, "cannot get dep_dev: ret %d\n", ret);
+	ret = sensor_regcache_init(&client->dev, &ov8865->regcache,
+				   OV8865_REGCACHE_MAX_REG,
+				   ov8865_volatile_regs,
+				   ARRAY_SIZE(ov8865_volatile_regs));
+	if (ret)
 		return ret;
+
+	/* get_hwcfg() is not used on ACPI, check the lanes from SSDB */
+	if (!sensor_ssdb_read(&client->dev, &ssdb) &&
+	    ssdb.lanes_used != OV8865_DATA_LANES) {
+		dev_err(&client->dev, "number of CSI2 data lanes %d is not supported",
+			ssdb.lanes_used);
+		return -EINVAL;
 	}
-	dep_dev = ov8865->dep_dev;
 
-	ret = gpio_crs_get(ov8865, dep_dev);
-	if (ret) {
-		dev_err(dep_dev, "Failed to get _CRS GPIOs\n");
+	ov8865->dep = int3472_dep_get(&client->dev);
+	if (IS_ERR(ov8865->dep)) {
+		ret = PTR_ERR(ov8865->dep);
+		dev_err(&client->dev, "cannot get dependent device: ret %d\n",
+			ret);
 		return ret;
 	}
 
+	sensor_stats_init(&ov8865->stats, &client->dev, NULL);
+
 	ret = __ov8865_power_on(ov8865);
 	if (ret) {
 		dev_err(&client->dev, "failed to power on\n");
-		goto error_gpio_crs_put;
+		goto error_dep_put;
 	}
 
 	ret = ov8865_identify_module(ov8865);
@@ -1735,9 +1649,10 @@ probe_error_v4l2_ctrl_handler_free:
 probe_power_off:
 	__ov8865_power_off(ov8865);
 
-error_gpio_crs_put:
+error_dep_put:
+	sensor_stats_exit(&ov8865->stats);
 	if (ov8865->is_acpi_based)
-		gpio_crs_put(ov8865);
+		int3472_dep_put(ov8865->dep);
 
 	return ret;
 }
@@ -1765,6 +1680,7 @@ static struct i2c_driver ov8865_i2c_driver = {
 	.driver = {
 		.name = "ov8865",
 		.pm = &ov8865_pm_ops,
+		.probe_type = PROBE_PREFER_ASYNCHRONOUS,
 		.acpi_match_table = ACPI_PTR(ov8865_acpi_ids),
 		.of_match_table = ov8865_of_match,
 	},
@@ -36,9 +36,14 @@
 #define AD5823_RING_CTRL_ENABLE		0x04
 #define AD5823_RING_CTRL_DISABLE	0x00
 
+/*
+ * Resonance period of the lens in ticks of the 10 MHz AD5823 oscillator.
+ * VCM_MOVE_TIME holds it divided by AD5823_RESONANCE_COEF.
+ */
 #define AD5823_RESONANCE_PERIOD		100000
 #define AD5823_RESONANCE_COEF		512
 #define AD5823_HIGH_FREQ_RANGE		0x80
+#define AD5823_RESONANCE_PERIOD_US	(AD5823_RESONANCE_PERIOD / 10)
 
 #define VCM_CODE_MSB_MASK		0xfc
 #define AD5823_INIT_FOCUS_POS           350
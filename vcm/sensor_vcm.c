@@ -0,0 +1,551 @@
+// SPDX-License-Identifier: GPL-2.0
+/*
+ * Lens sub-devices for the DW9714 and AD5823 VCMs of the IPU3 camera
+ * modules. Instantiated by the sensor drivers, see common/sensor_vcm.h.
+ *
+ * Focus moves are done by a worker under the lock of the lens alone, so
+ * they never wait for the sensor controls or the other way around. Long
+ * moves are split into steps of at most slew_step codes, each given
+ * slew_interval_us to settle, as large jumps make the lens ring. Both come
+ * from the chip.
+ */
+
+#include <linux/delay.h>
+#include <linux/i2c.h>
+#include <linux/kernel.h>
+#include <linux/module.h>
+#include <linux/mutex.h>
+#include <linux/pm_runtime.h>
+#include <linux/workqueue.h>
+#include <media/v4l2-async.h>
+#include <media/v4l2-ctrls.h>
+#include <media/v4l2-subdev.h>
+
+#include "sensor_vcm.h"
+#include "ad5823.h"
+
+#define VCM_MAX_FOCUS_POS		1023
+#define VCM_AUTOSUSPEND_DELAY_MS	1000
+
+#define DW9714_DEFAULT_S		0x0
+#define dw9714_val(data, s)		(u16)((data) << 4 | (s))
+
+/*
+ * In direct mode (S = 0) the DW9714 jumps to the new code with no ringing
+ * control of its own, so the lens is walked in small steps.
+ */
+#define DW9714_SLEW_STEP		32
+#define DW9714_SLEW_INTERVAL_US		1000
+
+struct sensor_vcm;
+
+struct sensor_vcm_chip {
+	/* default focus position, reached from 0 after power up */
+	s32 init_pos;
+	/* max lens codes per focus step, 0 for no limit */
+	u16 slew_step;
+	/* time a step takes to settle */
+	u32 slew_interval_us;
+	/* called after power up, the VCM registers are at their defaults */
+	int (*init)(struct sensor_vcm *vcm);
+	int (*write)(struct sensor_vcm *vcm, u16 pos);
+};
+
+struct sensor_vcm {
+	struct v4l2_subdev sd;
+	struct v4l2_ctrl_handler ctrl_handler;
+	const struct sensor_vcm_chip *chip;
+	struct work_struct move_work;
+
+	/* protects the controls and everything below */
+	struct mutex lock;
+	/* requested position */
+	s32 target;
+	/* last position written, -1 while powered off */
+	s32 pos;
+	/* set when a move is queued, cleared when it's done */
+	bool moving;
+	/* result of the last VCM write */
+	int error;
+
+	/* AD5823 VCM_CODE_MSB mode bits, read once after the VCM reset */
+	u8 ad5823_msb_mode;
+	/* AD5823 VCM_MOVE_TIME last written, -1 if unknown */
+	s16 ad5823_move_time;
+};
+
+static inline struct sensor_vcm *to_sensor_vcm(struct v4l2_subdev *sd)
+{
+	return container_of(sd, struct sensor_vcm, sd);
+}
+
+static int dw9714_write_pos(struct sensor_vcm *vcm, u16 pos)
+{
+	struct i2c_client *client = v4l2_get_subdevdata(&vcm->sd);
+	__be16 val = cpu_to_be16(dw9714_val(pos, DW9714_DEFAULT_S));
+	int ret;
+
+	ret = i2c_master_send(client, (const char *)&val, sizeof(val));
+
+	return ret == sizeof(val) ? 0 : -EIO;
+}
+
+/* Write consecutive registers, the AD5823 auto-increments the address */
+static int ad5823_write_seq(struct sensor_vcm *vcm, u8 reg, const u8 *vals,
+			    unsigned int len)
+{
+	struct i2c_client *client = v4l2_get_subdevdata(&vcm->sd);
+	u8 buf[4];
+	int ret;
+
+	if (WARN_ON(len > sizeof(buf) - 1))
+		return -EINVAL;
+
+	buf[0] = reg;
+	memcpy(&buf[1], vals, len);
+
+	ret = i2c_master_send(client, buf, len + 1);
+
+	return ret == len + 1 ? 0 : -EIO;
+}
+
+static int ad5823_write(struct sensor_vcm *vcm, u8 reg, u8 val)
+{
+	return ad5823_write_seq(vcm, reg, &val, 1);
+}
+
+static int ad5823_read(struct sensor_vcm *vcm, u8 reg, u8 *val)
+{
+	struct i2c_client *client = v4l2_get_subdevdata(&vcm->sd);
+	struct i2c_msg msg[] = {
+		{
+			.addr = client->addr,
+			.len = 1,
+			.buf = &reg,
+		}, {
+			.addr = client->addr,
+			.flags = I2C_M_RD,
+			.len = 1,
+			.buf = val,
+		},
+	};
+
+	if (i2c_transfer(client->adapter, msg, ARRAY_SIZE(msg)) !=
+	    ARRAY_SIZE(msg))
+		return -EIO;
+	return 0;
+}
+
+static int ad5823_init(struct sensor_vcm *vcm)
+{
+	int ret;
+
+	ret = ad5823_write(vcm, AD5823_REG_RESET, 0x01);
+	if (ret)
+		return ret;
+
+	/* enable ringing control, then the response mode */
+	ret = ad5823_write(vcm, AD5823_REG_VCM_CODE_MSB,
+			   AD5823_RING_CTRL_ENABLE);
+	if (ret)
+		return ret;
+
+	ret = ad5823_write(vcm, AD5823_REG_MODE, AD5823_ARC_RES1);
+	if (ret)
+		return ret;
+
+	/* focus moves keep these bits without reading them back */
+	if (ad5823_read(vcm, AD5823_REG_VCM_CODE_MSB, &vcm->ad5823_msb_mode))
+		vcm->ad5823_msb_mode = AD5823_RING_CTRL_ENABLE;
+	vcm->ad5823_msb_mode &= VCM_CODE_MSB_MASK;
+	/* reset by the above, written with the first move */
+	vcm->ad5823_move_time = -1;
+
+	return 0;
+}
+
+/*
+ * One I2C message per focus step: VCM_CODE_MSB with the cached mode bits
+ * and VCM_CODE_LSB, preceded by VCM_MOVE_TIME only when that changes. The
+ * three registers are consecutive.
+ */
+static int ad5823_write_pos(struct sensor_vcm *vcm, u16 pos)
+{
+	u8 move_time = AD5823_RESONANCE_PERIOD / AD5823_RESONANCE_COEF
+		       - AD5823_HIGH_FREQ_RANGE;
+	u8 vals[3];
+	int ret;
+
+	pos = min_t(u16, pos, AD5823_MAX_FOCUS_POS);
+
+	vals[0] = move_time;
+	/* set reg VCM_CODE_MSB Bit[1:0] */
+	vals[1] = vcm->ad5823_msb_mode | ((pos >> 8) & ~VCM_CODE_MSB_MASK);
+	/* set reg VCM_CODE_LSB Bit[7:0] */
+	vals[2] = pos & 0xff;
+
+	if (vcm->ad5823_move_time == move_time)
+		return ad5823_write_seq(vcm, AD5823_REG_VCM_CODE_MSB,
+					&vals[1], 2);
+
+	ret = ad5823_write_seq(vcm, AD5823_REG_VCM_MOVE_TIME, vals, 3);
+	if (!ret)
+		vcm->ad5823_move_time = move_time;
+
+	return ret;
+}
+
+static const struct sensor_vcm_chip dw9714_chip = {
+	.init_pos = 0,
+	.slew_step = DW9714_SLEW_STEP,
+	.slew_interval_us = DW9714_SLEW_INTERVAL_US,
+	.write = dw9714_write_pos,
+};
+
+/*
+ * The AD5823 ringing control spreads every move over one resonance period
+ * of the lens, whatever its size. So a move is a single step, which takes
+ * that period to settle.
+ */
+static const struct sensor_vcm_chip ad5823_chip = {
+	.init_pos = AD5823_INIT_FOCUS_POS,
+	.slew_step = 0,
+	.slew_interval_us = AD5823_RESONANCE_PERIOD_US,
+	.init = ad5823_init,
+	.write = ad5823_write_pos,
+};
+
+/* Next position on the way to the target, with vcm->lock held */
+static s32 sensor_vcm_next(struct sensor_vcm *vcm)
+{
+	s32 delta = vcm->target - vcm->pos;
+	s32 step = vcm->chip->slew_step;
+
+	if (step)
+		delta = clamp_t(s32, delta, -step, step);
+
+	return vcm->pos + delta;
+}
+
+static void sensor_vcm_move_work(struct work_struct *work)
+{
+	struct sensor_vcm *vcm = container_of(work, struct sensor_vcm,
+					      move_work);
+	struct i2c_client *client = v4l2_get_subdevdata(&vcm->sd);
+	u32 interval = vcm->chip->slew_interval_us;
+	s32 next;
+	int ret;
+
+	/*
+	 * Moved to the target on the next open. A lens waiting to autosuspend
+	 * is still powered and won't be initialized again, move it now.
+	 */
+	if (pm_runtime_get_if_active(&client->dev, true) <= 0) {
+		mutex_lock(&vcm->lock);
+		vcm->moving = false;
+		mutex_unlock(&vcm->lock);
+		return;
+	}
+
+	mutex_lock(&vcm->lock);
+
+	/* the target may change between the steps, follow it */
+	while (vcm->pos != vcm->target) {
+		next = sensor_vcm_next(vcm);
+		ret = vcm->chip->write(vcm, next);
+		vcm->error = ret;
+		if (ret) {
+			dev_err(&client->dev, "focus move to %d failed: %d\n",
+				next, ret);
+			break;
+		}
+		vcm->pos = next;
+
+		/* busy until the lens settled, also after the last step */
+		mutex_unlock(&vcm->lock);
+		usleep_range(interval, interval + interval / 4);
+		mutex_lock(&vcm->lock);
+	}
+
+	vcm->moving = false;
+	mutex_unlock(&vcm->lock);
+
+	pm_runtime_mark_last_busy(&client->dev);
+	pm_runtime_put_autosuspend(&client->dev);
+}
+
+/* With vcm->lock held */
+static void sensor_vcm_queue_move(struct sensor_vcm *vcm, s32 target)
+{
+	vcm->target = clamp(target, 0, VCM_MAX_FOCUS_POS);
+	if (vcm->target == vcm->pos)
+		return;
+
+	vcm->moving = true;
+	schedule_work(&vcm->move_work);
+}
+
+static int sensor_vcm_s_ctrl(struct v4l2_ctrl *ctrl)
+{
+	struct sensor_vcm *vcm = container_of(ctrl->handler, struct sensor_vcm,
+					      ctrl_handler);
+
+	switch (ctrl->id) {
+	case V4L2_CID_FOCUS_ABSOLUTE:
+		sensor_vcm_queue_move(vcm, ctrl->val);
+		return 0;
+	case V4L2_CID_FOCUS_RELATIVE:
+		/* relative to the last request, which may not be reached yet */
+		sensor_vcm_queue_move(vcm, vcm->target + ctrl->val);
+		return 0;
+	default:
+		return -EINVAL;
+	}
+}
+
+static int sensor_vcm_g_volatile_ctrl(struct v4l2_ctrl *ctrl)
+{
+	struct sensor_vcm *vcm = container_of(ctrl->handler, struct sensor_vcm,
+					      ctrl_handler);
+
+	switch (ctrl->id) {
+	case V4L2_CID_FOCUS_ABSOLUTE:
+		/* the lens rests at the target while powered off */
+		ctrl->val = vcm->pos < 0 ? vcm->target : vcm->pos;
+		return 0;
+	case V4L2_CID_AUTO_FOCUS_STATUS:
+		if (vcm->error)
+			ctrl->val = V4L2_AUTO_FOCUS_STATUS_FAILED;
+		else if (vcm->moving)
+			ctrl->val = V4L2_AUTO_FOCUS_STATUS_BUSY;
+		/* nothing was written while powered off */
+		else if (vcm->pos >= 0 && vcm->pos == vcm->target)
+			ctrl->val = V4L2_AUTO_FOCUS_STATUS_REACHED;
+		else
+			ctrl->val = V4L2_AUTO_FOCUS_STATUS_IDLE;
+		return 0;
+	default:
+		return -EINVAL;
+	}
+}
+
+static const struct v4l2_ctrl_ops sensor_vcm_ctrl_ops = {
+	.s_ctrl = sensor_vcm_s_ctrl,
+	.g_volatile_ctrl = sensor_vcm_g_volatile_ctrl,
+};
+
+static int sensor_vcm_init_controls(struct sensor_vcm *vcm)
+{
+	struct v4l2_ctrl_handler *hdl = &vcm->ctrl_handler;
+	struct v4l2_ctrl *ctrl;
+
+	v4l2_ctrl_handler_init(hdl, 3);
+	hdl->lock = &vcm->lock;
+
+	/* reads back the position of the lens */
+	ctrl = v4l2_ctrl_new_std(hdl, &sensor_vcm_ctrl_ops,
+				 V4L2_CID_FOCUS_ABSOLUTE, 0, VCM_MAX_FOCUS_POS,
+				 1, vcm->chip->init_pos);
+	if (ctrl)
+		ctrl->flags |= V4L2_CTRL_FLAG_VOLATILE |
+			       V4L2_CTRL_FLAG_EXECUTE_ON_WRITE;
+
+	v4l2_ctrl_new_std(hdl, &sensor_vcm_ctrl_ops, V4L2_CID_FOCUS_RELATIVE,
+			  -VCM_MAX_FOCUS_POS, VCM_MAX_FOCUS_POS, 1, 0);
+
+	/* whether the last move is still running */
+	ctrl = v4l2_ctrl_new_std(hdl, &sensor_vcm_ctrl_ops,
+				 V4L2_CID_AUTO_FOCUS_STATUS, 0,
+				 V4L2_AUTO_FOCUS_STATUS_BUSY |
+				 V4L2_AUTO_FOCUS_STATUS_REACHED |
+				 V4L2_AUTO_FOCUS_STATUS_FAILED,
+				 0, V4L2_AUTO_FOCUS_STATUS_IDLE);
+	if (ctrl)
+		ctrl->flags |= V4L2_CTRL_FLAG_VOLATILE |
+			       V4L2_CTRL_FLAG_READ_ONLY;
+
+	if (hdl->error)
+		return hdl->error;
+
+	vcm->sd.ctrl_handler = hdl;
+
+	return 0;
+}
+
+/* The lens is powered, with the sensor, while its device node is open */
+static int sensor_vcm_open(struct v4l2_subdev *sd, struct v4l2_subdev_fh *fh)
+{
+	struct sensor_vcm *vcm = to_sensor_vcm(sd);
+	struct i2c_client *client = v4l2_get_subdevdata(sd);
+	int ret;
+
+	ret = pm_runtime_get_sync(&client->dev);
+	if (ret < 0) {
+		pm_runtime_put_noidle(&client->dev);
+		return ret;
+	}
+
+	/* go to the target requested while powered off */
+	mutex_lock(&vcm->lock);
+	sensor_vcm_queue_move(vcm, vcm->target);
+	mutex_unlock(&vcm->lock);
+
+	return 0;
+}
+
+static int sensor_vcm_close(struct v4l2_subdev *sd, struct v4l2_subdev_fh *fh)
+{
+	struct i2c_client *client = v4l2_get_subdevdata(sd);
+
+	pm_runtime_mark_last_busy(&client->dev);
+	pm_runtime_put_autosuspend(&client->dev);
+
+	return 0;
+}
+
+static const struct v4l2_subdev_internal_ops sensor_vcm_internal_ops = {
+	.open = sensor_vcm_open,
+	.close = sensor_vcm_close,
+};
+
+static const struct v4l2_subdev_ops sensor_vcm_ops = { };
+
+static int __maybe_unused sensor_vcm_runtime_suspend(struct device *dev)
+{
+	struct sensor_vcm *vcm = to_sensor_vcm(i2c_get_clientdata(
+						to_i2c_client(dev)));
+
+	/* powered off along with the sensor once the link lets it go */
+	mutex_lock(&vcm->lock);
+	vcm->pos = -1;
+	mutex_unlock(&vcm->lock);
+
+	return 0;
+}
+
+/* The device link resumed the sensor, which powers the VCM, before */
+static int __maybe_unused sensor_vcm_runtime_resume(struct device *dev)
+{
+	struct sensor_vcm *vcm = to_sensor_vcm(i2c_get_clientdata(
+						to_i2c_client(dev)));
+	int ret = 0;
+
+	mutex_lock(&vcm->lock);
+
+	if (vcm->chip->init)
+		ret = vcm->chip->init(vcm);
+	vcm->error = ret;
+	if (ret)
+		dev_err(dev, "VCM init failed: %d\n", ret);
+	else
+		vcm->pos = 0;	/* reset value of the VCM code */
+
+	mutex_unlock(&vcm->lock);
+
+	return ret;
+}
+
+static int sensor_vcm_probe(struct i2c_client *client)
+{
+	const struct i2c_device_id *id;
+	struct sensor_vcm *vcm;
+	int ret;
+
+	id = i2c_match_id(client->driver->id_table, client);
+	if (!id)
+		return -ENODEV;
+
+	vcm = devm_kzalloc(&client->dev, sizeof(*vcm), GFP_KERNEL);
+	if (!vcm)
+		return -ENOMEM;
+
+	vcm->chip = (const struct sensor_vcm_chip *)id->driver_data;
+	vcm->target = vcm->chip->init_pos;
+	vcm->pos = -1;
+	mutex_init(&vcm->lock);
+	INIT_WORK(&vcm->move_work, sensor_vcm_move_work);
+
+	v4l2_i2c_subdev_init(&vcm->sd, client, &sensor_vcm_ops);
+	vcm->sd.flags |= V4L2_SUBDEV_FL_HAS_DEVNODE;
+	vcm->sd.internal_ops = &sensor_vcm_internal_ops;
+	vcm->sd.entity.function = MEDIA_ENT_F_LENS;
+
+	ret = sensor_vcm_init_controls(vcm);
+	if (ret)
+		goto err_free_ctrls;
+
+	ret = media_entity_pads_init(&vcm->sd.entity, 0, NULL);
+	if (ret)
+		goto err_free_ctrls;
+
+	pm_runtime_set_autosuspend_delay(&client->dev,
+					 VCM_AUTOSUSPEND_DELAY_MS);
+	pm_runtime_use_autosuspend(&client->dev);
+	pm_runtime_enable(&client->dev);
+
+	ret = v4l2_async_register_subdev(&vcm->sd);
+	if (ret) {
+		dev_err(&client->dev, "failed to register V4L2 subdev: %d\n",
+			ret);
+		goto err_pm_disable;
+	}
+
+	return 0;
+
+err_pm_disable:
+	pm_runtime_disable(&client->dev);
+	pm_runtime_dont_use_autosuspend(&client->dev);
+	media_entity_cleanup(&vcm->sd.entity);
+err_free_ctrls:
+	v4l2_ctrl_handler_free(&vcm->ctrl_handler);
+	mutex_destroy(&vcm->lock);
+	return ret;
+}
+
+static int sensor_vcm_remove(struct i2c_client *client)
+{
+	struct sensor_vcm *vcm = to_sensor_vcm(i2c_get_clientdata(client));
+
+	v4l2_async_unregister_subdev(&vcm->sd);
+
+	/* No more moves once the controls are gone */
+	v4l2_ctrl_handler_free(&vcm->ctrl_handler);
+	cancel_work_sync(&vcm->move_work);
+
+	pm_runtime_disable(&client->dev);
+	pm_runtime_set_suspended(&client->dev);
+	pm_runtime_dont_use_autosuspend(&client->dev);
+
+	media_entity_cleanup(&vcm->sd.entity);
+	mutex_destroy(&vcm->lock);
+
+	return 0;
+}
+
+static const struct i2c_device_id sensor_vcm_id[] = {
+	{ SENSOR_VCM_DW9714, (kernel_ulong_t)&dw9714_chip },
+	{ SENSOR_VCM_AD5823, (kernel_ulong_t)&ad5823_chip },
+	{ }
+};
+MODULE_DEVICE_TABLE(i2c, sensor_vcm_id);
+
+static const struct dev_pm_ops sensor_vcm_pm_ops = {
+	SET_RUNTIME_PM_OPS(sensor_vcm_runtime_suspend,
+			   sensor_vcm_runtime_resume, NULL)
+};
+
+static struct i2c_driver sensor_vcm_driver = {
+	.driver = {
+		.name = "sensor_vcm",
+		.pm = &sensor_vcm_pm_ops,
+		/* sensor_vcm_new() checks the probe result right away */
+		.probe_type = PROBE_FORCE_SYNCHRONOUS,
+	},
+	.probe_new = sensor_vcm_probe,
+	.remove = sensor_vcm_remove,
+	.id_table = sensor_vcm_id,
+};
+module_i2c_driver(sensor_vcm_driver);
+
+MODULE_DESCRIPTION("DW9714 and AD5823 lens drivers for the IPU3 camera sensors");
+MODULE_LICENSE("GPL");